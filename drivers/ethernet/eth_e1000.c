@@ -84,29 +84,129 @@ static enum ethernet_hw_caps e1000_caps(const struct device *dev)
 	return
 #if IS_ENABLED(CONFIG_NET_VLAN)
 		ETHERNET_HW_VLAN |
+#endif
+#if IS_ENABLED(CONFIG_ETH_E1000_TSO)
+		ETHERNET_HW_TCP_SEG_OFFLOAD |
 #endif
 		ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T |
 		ETHERNET_LINK_1000BASE_T;
 }
 
+static volatile union e1000_tx_desc *e1000_tx_next(struct e1000_dev *dev)
+{
+	volatile union e1000_tx_desc *desc = &dev->tx[dev->tx_tail];
+
+	dev->tx_tail = (dev->tx_tail + 1) % E1000_TX_DESC_COUNT;
+
+	return desc;
+}
+
+/* Hand the new descriptors to the device and wait for the last one */
+static int e1000_tx_kick(struct e1000_dev *dev, volatile uint8_t *sta)
+{
+	iow32(dev, TDT, dev->tx_tail);
+
+	while (!(*sta)) {
+		k_yield();
+	}
+
+	LOG_DBG("tx.sta: 0x%02hx", *sta);
+
+	return (*sta & TDESC_STA_DD) ? 0 : -EIO;
+}
+
 static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
 {
+	volatile struct e1000_tx *tx = &e1000_tx_next(dev)->legacy;
+
 	hexdump(buf, len, "%zu byte(s)", len);
 
-	dev->tx.addr = POINTER_TO_INT(buf);
-	dev->tx.len = len;
-	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	tx->addr = POINTER_TO_INT(buf);
+	tx->len = len;
+	tx->cso = 0;
+	tx->css = 0;
+	tx->special = 0;
+	tx->sta = 0;
+	tx->cmd = TDESC_EOP | TDESC_RS;
 
-	iow32(dev, TDT, 1);
+	return e1000_tx_kick(dev, &tx->sta);
+}
 
-	while (!(dev->tx.sta)) {
-		k_yield();
+#if defined(CONFIG_ETH_E1000_TSO)
+/* Send the large TCP frame of @a pkt, read in dev->txb: the device
+ * splits it into segments of the MSS and computes their checksums.
+ */
+static int e1000_tx_tso(struct e1000_dev *dev, struct net_pkt *pkt,
+			size_t len)
+{
+	volatile struct e1000_tx_ctx *ctx = &e1000_tx_next(dev)->ctx;
+	volatile struct e1000_tx_data *data = &e1000_tx_next(dev)->data;
+	struct net_eth_hdr *hdr = (struct net_eth_hdr *)dev->txb;
+	uint8_t l3 = sizeof(struct net_eth_hdr);
+	uint8_t l3_len, l4, *addr, *th;
+	uint16_t mss = net_pkt_gso_size(pkt);
+	bool ipv6 = net_pkt_family(pkt) == AF_INET6;
+	uint32_t sum = IPPROTO_TCP;
+	size_t addr_len;
+
+	if (IS_ENABLED(CONFIG_NET_VLAN) &&
+	    ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
+		l3 = sizeof(struct net_eth_vlan_hdr);
+	}
+
+	if (ipv6) {
+		l3_len = sizeof(struct net_ipv6_hdr) +
+			 net_pkt_ipv6_ext_len(pkt);
+		addr = ((struct net_ipv6_hdr *)&dev->txb[l3])->src.s6_addr;
+		addr_len = 2 * sizeof(struct in6_addr);
+	} else {
+		l3_len = (dev->txb[l3] & 0x0f) * 4U;
+		addr = ((struct net_ipv4_hdr *)&dev->txb[l3])->src.s4_addr;
+		addr_len = 2 * sizeof(struct in_addr);
 	}
 
-	LOG_DBG("tx.sta: 0x%02hx", dev->tx.sta);
+	l4 = l3 + l3_len;
+	th = &dev->txb[l4];
 
-	return (dev->tx.sta & TDESC_STA_DD) ? 0 : -EIO;
+	/* The device adds the length of each segment to the sum of the
+	 * pseudo header found in the TCP checksum field.
+	 */
+	for (size_t i = 0; i < addr_len; i += 2) {
+		sum += (addr[i] << 8) | addr[i + 1];
+	}
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	th[16] = sum >> 8;
+	th[17] = sum & 0xff;
+
+	ctx->ipcss = l3;
+	ctx->ipcso = ipv6 ? 0 : l3 + offsetof(struct net_ipv4_hdr, chksum);
+	ctx->ipcse = ipv6 ? 0 : l4 - 1;
+	ctx->tucss = l4;
+	ctx->tucso = l4 + offsetof(struct net_tcp_hdr, chksum);
+	ctx->tucse = 0;
+	ctx->hdrlen = l4 + (th[12] >> 4) * 4U;
+	ctx->mss = mss;
+	ctx->sta = 0;
+	ctx->cmd_len = (len - ctx->hdrlen) |
+		((TDESC_TSE | TDESC_DEXT | TDESC_TUCMD_TCP |
+		  (ipv6 ? 0 : TDESC_TUCMD_IP)) << TDESC_CMD_SHIFT);
+
+	data->addr = POINTER_TO_INT(dev->txb);
+	data->popts = TDESC_POPTS_TXSM | (ipv6 ? 0 : TDESC_POPTS_IXSM);
+	data->special = 0;
+	data->sta = 0;
+	data->cmd_len = len | TDESC_DTYP_D |
+		((TDESC_EOP | TDESC_IFCS | TDESC_TSE | TDESC_RS | TDESC_DEXT) <<
+		 TDESC_CMD_SHIFT);
+
+	hexdump(dev->txb, ctx->hdrlen, "%zu byte(s), mss %u", len, mss);
+
+	return e1000_tx_kick(dev, &data->sta);
 }
+#endif /* CONFIG_ETH_E1000_TSO */
 
 static int e1000_send(const struct device *device, struct net_pkt *pkt)
 {
@@ -117,6 +217,12 @@ static int e1000_send(const struct device *device, struct net_pkt *pkt)
 		return -EIO;
 	}
 
+#if defined(CONFIG_ETH_E1000_TSO)
+	if (net_pkt_gso_size(pkt)) {
+		return e1000_tx_tso(dev, pkt, len);
+	}
+#endif
+
 	return e1000_tx(dev, dev->txb, len);
 }
 
@@ -231,9 +337,9 @@ int e1000_probe(const struct device *device)
 
 	/* Setup TX descriptor */
 
-	iow32(dev, TDBAL, (uint32_t) &dev->tx);
+	iow32(dev, TDBAL, (uint32_t) &dev->tx[0]);
 	iow32(dev, TDBAH, 0);
-	iow32(dev, TDLEN, 1*16);
+	iow32(dev, TDLEN, sizeof(dev->tx));
 
 	iow32(dev, TDH, 0);
 	iow32(dev, TDT, 0);
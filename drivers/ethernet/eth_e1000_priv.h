@@ -25,7 +25,19 @@ extern "C" {
 #define RCTL_MPE	(1 << 4) /* Multicast Promiscuous Enabled */
 
 #define TDESC_EOP	     (1) /* End Of Packet */
+#define TDESC_IFCS	(1 << 1) /* Insert FCS */
+#define TDESC_TSE	(1 << 2) /* TCP Segmentation Enable */
 #define TDESC_RS	(1 << 3) /* Report Status */
+#define TDESC_DEXT	(1 << 5) /* Descriptor Extension */
+
+#define TDESC_DTYP_D	(1 << 20) /* Data descriptor, in cmd_len */
+#define TDESC_CMD_SHIFT	24        /* TUCMD and DCMD in cmd_len */
+
+#define TDESC_TUCMD_TCP	     (1) /* TCP packet */
+#define TDESC_TUCMD_IP	(1 << 1) /* IPv4 packet */
+
+#define TDESC_POPTS_IXSM     (1) /* Insert IP Checksum */
+#define TDESC_POPTS_TXSM (1 << 1) /* Insert TCP Checksum */
 
 #define RDESC_STA_DD	     (1) /* Descriptor Done */
 #define TDESC_STA_DD	     (1) /* Descriptor Done */
@@ -64,6 +76,44 @@ struct e1000_tx {
 	uint16_t special;
 };
 
+/* TCP/IP Context Descriptor */
+struct e1000_tx_ctx {
+	uint8_t  ipcss;
+	uint8_t  ipcso;
+	uint16_t ipcse;
+	uint8_t  tucss;
+	uint8_t  tucso;
+	uint16_t tucse;
+	uint32_t cmd_len;
+	uint8_t  sta;
+	uint8_t  hdrlen;
+	uint16_t mss;
+};
+
+/* TCP/IP Data Descriptor */
+struct e1000_tx_data {
+	uint64_t addr;
+	uint32_t cmd_len;
+	uint8_t  sta;
+	uint8_t  popts;
+	uint16_t special;
+};
+
+union e1000_tx_desc {
+	struct e1000_tx legacy;
+	struct e1000_tx_ctx ctx;
+	struct e1000_tx_data data;
+};
+
+/* A TCP segmentation offload uses a context and a data descriptor */
+#define E1000_TX_DESC_COUNT 8
+
+#if defined(CONFIG_ETH_E1000_TSO)
+#define E1000_TX_BUF_LEN (NET_ETH_MTU + CONFIG_NET_TCP_GSO_MAX_SIZE)
+#else
+#define E1000_TX_BUF_LEN NET_ETH_MTU
+#endif
+
 /* Legacy RX Descriptor */
 struct e1000_rx {
 	uint64_t addr;
@@ -75,8 +125,9 @@ struct e1000_rx {
 };
 
 struct e1000_dev {
-	volatile struct e1000_tx tx __aligned(16);
+	volatile union e1000_tx_desc tx[E1000_TX_DESC_COUNT] __aligned(16);
 	volatile struct e1000_rx rx __aligned(16);
+	uint32_t tx_tail;
 	mm_reg_t address;
 	/* If VLAN is enabled, there can be multiple VLAN interfaces related to
 	 * this physical device. In that case, this iface pointer value is not
@@ -84,7 +135,7 @@ struct e1000_dev {
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
-	uint8_t txb[NET_ETH_MTU];
+	uint8_t txb[E1000_TX_BUF_LEN];
 	uint8_t rxb[NET_ETH_MTU];
 };
 
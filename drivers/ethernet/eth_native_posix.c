@@ -39,15 +39,27 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
+/* The TAP interface is polled again after RX_POLL_MIN_MS while frames
+ * keep coming, and after up to RX_POLL_MAX_MS once it is idle.
+ */
+#define RX_POLL_MIN_MS 1
+#define RX_POLL_MAX_MS 50
+
 #if defined(CONFIG_NET_VLAN)
 #define ETH_HDR_LEN sizeof(struct net_eth_vlan_hdr)
 #else
 #define ETH_HDR_LEN sizeof(struct net_eth_hdr)
 #endif
 
+#if defined(CONFIG_ETH_NATIVE_POSIX_TSO)
+#define ETH_TX_BUF_LEN (NET_ETH_MTU + ETH_HDR_LEN + CONFIG_NET_TCP_GSO_MAX_SIZE)
+#else
+#define ETH_TX_BUF_LEN (NET_ETH_MTU + ETH_HDR_LEN)
+#endif
+
 struct eth_context {
 	uint8_t recv[NET_ETH_MTU + ETH_HDR_LEN];
-	uint8_t send[NET_ETH_MTU + ETH_HDR_LEN];
+	uint8_t send[ETH_TX_BUF_LEN];
 	uint8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
 	struct net_if *iface;
@@ -55,6 +67,8 @@ struct eth_context {
 	k_tid_t rx_thread;
 	struct z_thread_stack_element *rx_stack;
 	size_t rx_stack_size;
+	sys_slist_t rx_batch;
+	struct net_if *rx_batch_iface;
 	int dev_fd;
 	bool init_done;
 	bool status;
@@ -178,6 +192,75 @@ static void update_gptp(struct net_if *iface, struct net_pkt *pkt,
 #define update_gptp(iface, pkt, send)
 #endif /* CONFIG_NET_GPTP */
 
+#if defined(CONFIG_ETH_NATIVE_POSIX_TSO)
+/* Add the 16-bit words of data to sum and fold the result */
+static uint16_t tso_sum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i += 2) {
+		sum += (data[i] << 8) | data[i + 1];
+	}
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return sum;
+}
+
+/* Send the large TCP frame in ctx->send to the host which splits it */
+static int eth_send_tso(struct eth_context *ctx, struct net_pkt *pkt,
+			int count)
+{
+	struct eth_tso_info tso = {
+		.mss = net_pkt_gso_size(pkt),
+		.ipv6 = net_pkt_family(pkt) == AF_INET6,
+	};
+	struct net_eth_hdr *hdr = (struct net_eth_hdr *)ctx->send;
+	uint16_t l3_offset = sizeof(struct net_eth_hdr);
+	uint8_t *l3, *th;
+	uint16_t sum;
+
+	if (IS_ENABLED(CONFIG_NET_VLAN) &&
+	    ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
+		l3_offset = sizeof(struct net_eth_vlan_hdr);
+	}
+
+	l3 = &ctx->send[l3_offset];
+
+	if (tso.ipv6) {
+		struct net_ipv6_hdr *ip_hdr = (struct net_ipv6_hdr *)l3;
+
+		tso.l4_offset = l3_offset + sizeof(struct net_ipv6_hdr) +
+				net_pkt_ipv6_ext_len(pkt);
+		sum = tso_sum(0, ip_hdr->src.s6_addr,
+			      2 * sizeof(struct in6_addr));
+	} else {
+		struct net_ipv4_hdr *ip_hdr = (struct net_ipv4_hdr *)l3;
+		size_t ip_hdr_len = (ip_hdr->vhl & 0x0f) * 4U;
+
+		/* The host checks the IP header before it splits the frame */
+		ip_hdr->chksum = 0U;
+		ip_hdr->chksum = htons(~tso_sum(0, l3, ip_hdr_len));
+
+		tso.l4_offset = l3_offset + ip_hdr_len;
+		sum = tso_sum(0, ip_hdr->src.s4_addr,
+			      2 * sizeof(struct in_addr));
+	}
+
+	th = &ctx->send[tso.l4_offset];
+	tso.hdr_len = tso.l4_offset + (th[12] >> 4) * 4U;
+
+	/* Pseudo header with the length of the whole TCP packet, as the
+	 * host adjusts it for each segment.
+	 */
+	sum = tso_sum(sum + IPPROTO_TCP + count - tso.l4_offset, NULL, 0);
+
+	th[16] = sum >> 8;
+	th[17] = sum & 0xff;
+
+	return eth_write_data_tso(ctx->dev_fd, ctx->send, count, &tso);
+}
+#endif /* CONFIG_ETH_NATIVE_POSIX_TSO */
+
 static int eth_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct eth_context *ctx = dev->data;
@@ -193,7 +276,15 @@ static int eth_send(const struct device *dev, struct net_pkt *pkt)
 
 	LOG_DBG("Send pkt %p len %d", pkt, count);
 
-	ret = eth_write_data(ctx->dev_fd, ctx->send, count);
+#if defined(CONFIG_ETH_NATIVE_POSIX_TSO)
+	if (net_pkt_gso_size(pkt)) {
+		ret = eth_send_tso(ctx, pkt, count);
+	} else
+#endif
+	{
+		ret = eth_write_data(ctx->dev_fd, ctx->send, count);
+	}
+
 	if (ret < 0) {
 		LOG_DBG("Cannot send pkt %p (%d)", pkt, ret);
 	}
@@ -234,6 +325,42 @@ static inline struct net_if *get_iface(struct eth_context *ctx,
 #endif
 }
 
+/* Pass the frames received so far to the stack at once */
+static void rx_flush(struct eth_context *ctx)
+{
+	sys_snode_t *node;
+
+	if (sys_slist_is_empty(&ctx->rx_batch)) {
+		return;
+	}
+
+	if (net_recv_data_list(ctx->rx_batch_iface, &ctx->rx_batch) < 0) {
+		while ((node = sys_slist_get(&ctx->rx_batch))) {
+			net_pkt_unref(CONTAINER_OF(node, struct net_pkt,
+						   rx_node));
+		}
+	}
+}
+
+static struct net_pkt *rx_alloc(struct eth_context *ctx, int count)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, count,
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	if (pkt) {
+		return pkt;
+	}
+
+	/* The frames of the batch may hold the buffers, let the stack
+	 * release them while waiting.
+	 */
+	rx_flush(ctx);
+
+	return net_pkt_rx_alloc_with_buffer(ctx->iface, count,
+					    AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+}
+
 #if defined(CONFIG_NET_VLAN)
 static struct net_pkt *prepare_vlan_pkt(struct eth_context *ctx,
 					int count, uint16_t *vlan_tag, int *status)
@@ -246,8 +373,7 @@ static struct net_pkt *prepare_vlan_pkt(struct eth_context *ctx,
 		count -= NET_ETH_VLAN_HDR_SIZE;
 	}
 
-	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, count,
-					   AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+	pkt = rx_alloc(ctx, count);
 	if (!pkt) {
 		*status = -ENOMEM;
 		return NULL;
@@ -299,8 +425,7 @@ static struct net_pkt *prepare_non_vlan_pkt(struct eth_context *ctx,
 {
 	struct net_pkt *pkt;
 
-	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, count,
-					   AF_UNSPEC, 0, NET_BUF_TIMEOUT);
+	pkt = rx_alloc(ctx, count);
 	if (!pkt) {
 		*status = -ENOMEM;
 		return NULL;
@@ -363,21 +488,44 @@ static int read_data(struct eth_context *ctx, int fd)
 
 	update_gptp(iface, pkt, false);
 
-	if (net_recv_data(iface, pkt) < 0) {
-		net_pkt_unref(pkt);
+	if (iface != ctx->rx_batch_iface) {
+		rx_flush(ctx);
+		ctx->rx_batch_iface = iface;
 	}
 
+	sys_slist_append(&ctx->rx_batch, &pkt->rx_node);
+
 	return 0;
 }
 
+/* Read up to budget frames and pass them to the stack in one batch */
+static int eth_rx_poll(struct eth_context *ctx, int budget)
+{
+	int count = 0;
+
+	while (count < budget && !eth_wait_data(ctx->dev_fd)) {
+		read_data(ctx, ctx->dev_fd);
+		count++;
+	}
+
+	rx_flush(ctx);
+
+	return count;
+}
+
 static void eth_rx(struct eth_context *ctx)
 {
+	int poll_ms = RX_POLL_MAX_MS;
+
 	LOG_DBG("Starting ZETH RX thread");
 
 	while (1) {
+		bool busy = false;
+
 		if (net_if_is_up(ctx->iface)) {
-			while (!eth_wait_data(ctx->dev_fd)) {
-				read_data(ctx, ctx->dev_fd);
+			while (eth_rx_poll(ctx,
+					   CONFIG_ETH_NATIVE_POSIX_RX_BUDGET)) {
+				busy = true;
 				k_yield();
 			}
 		}
@@ -385,7 +533,9 @@ static void eth_rx(struct eth_context *ctx)
 		if (IS_ENABLED(CONFIG_NET_GPTP)) {
 			k_sleep(K_MSEC(1));
 		} else {
-			k_sleep(K_MSEC(50));
+			poll_ms = busy ? RX_POLL_MIN_MS :
+				  MIN(2 * poll_ms, RX_POLL_MAX_MS);
+			k_sleep(K_MSEC(poll_ms));
 		}
 	}
 }
@@ -511,6 +661,9 @@ enum ethernet_hw_caps eth_posix_native_get_capabilities(const struct device *dev
 #endif
 #if defined(CONFIG_NET_LLDP)
 		| ETHERNET_LLDP
+#endif
+#if defined(CONFIG_ETH_NATIVE_POSIX_TSO)
+		| ETHERNET_HW_TCP_SEG_OFFLOAD
 #endif
 		;
 }
@@ -23,12 +23,14 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <time.h>
 #include <arch/posix/posix_trace.h>
 
 #ifdef __linux
 #include <linux/if_tun.h>
+#include <linux/virtio_net.h>
 #endif
 
 /* Zephyr include files. Be very careful here and only include minimum
@@ -67,6 +69,11 @@ int eth_iface_create(const char *if_name, bool tun_only)
 #ifdef __linux
 	ifr.ifr_flags = (tun_only ? IFF_TUN : IFF_TAP) | IFF_NO_PI;
 
+	/* Every frame is then preceded by a struct virtio_net_hdr */
+	if (IS_ENABLED(CONFIG_ETH_NATIVE_POSIX_TSO)) {
+		ifr.ifr_flags |= IFF_VNET_HDR;
+	}
+
 	strncpy(ifr.ifr_name, if_name, IFNAMSIZ - 1);
 
 	ret = ioctl(fd, TUNSETIFF, (void *)&ifr);
@@ -165,6 +172,72 @@ int eth_wait_data(int fd)
 	return -EAGAIN;
 }
 
+#if defined(CONFIG_ETH_NATIVE_POSIX_TSO)
+static ssize_t vnet_write(int fd, struct virtio_net_hdr *hdr, void *buf,
+			  size_t buf_len)
+{
+	struct iovec iov[] = {
+		{ .iov_base = hdr, .iov_len = sizeof(*hdr) },
+		{ .iov_base = buf, .iov_len = buf_len },
+	};
+	ssize_t ret;
+
+	ret = writev(fd, iov, ARRAY_SIZE(iov));
+	if (ret < (ssize_t)sizeof(*hdr)) {
+		return ret < 0 ? ret : 0;
+	}
+
+	return ret - sizeof(*hdr);
+}
+
+ssize_t eth_read_data(int fd, void *buf, size_t buf_len)
+{
+	struct virtio_net_hdr hdr;
+	struct iovec iov[] = {
+		{ .iov_base = &hdr, .iov_len = sizeof(hdr) },
+		{ .iov_base = buf, .iov_len = buf_len },
+	};
+	ssize_t ret;
+
+	/* We do not announce any offload with TUNSETOFFLOAD, so the host
+	 * only sends complete frames and the header can be ignored.
+	 */
+	ret = readv(fd, iov, ARRAY_SIZE(iov));
+	if (ret < (ssize_t)sizeof(hdr)) {
+		return ret < 0 ? ret : 0;
+	}
+
+	return ret - sizeof(hdr);
+}
+
+ssize_t eth_write_data(int fd, void *buf, size_t buf_len)
+{
+	struct virtio_net_hdr hdr = {
+		.gso_type = VIRTIO_NET_HDR_GSO_NONE,
+	};
+
+	return vnet_write(fd, &hdr, buf, buf_len);
+}
+
+/* The TCP checksum field of the frame must hold the folded sum of the
+ * pseudo header, the host completes it for each segment.
+ */
+ssize_t eth_write_data_tso(int fd, void *buf, size_t buf_len,
+			   const struct eth_tso_info *tso)
+{
+	struct virtio_net_hdr hdr = {
+		.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM,
+		.gso_type = tso->ipv6 ? VIRTIO_NET_HDR_GSO_TCPV6 :
+					VIRTIO_NET_HDR_GSO_TCPV4,
+		.hdr_len = tso->hdr_len,
+		.gso_size = tso->mss,
+		.csum_start = tso->l4_offset,
+		.csum_offset = 16, /* Checksum field of the TCP header */
+	};
+
+	return vnet_write(fd, &hdr, buf, buf_len);
+}
+#else
 ssize_t eth_read_data(int fd, void *buf, size_t buf_len)
 {
 	return read(fd, buf, buf_len);
@@ -174,6 +247,7 @@ ssize_t eth_write_data(int fd, void *buf, size_t buf_len)
 {
 	return write(fd, buf, buf_len);
 }
+#endif /* CONFIG_ETH_NATIVE_POSIX_TSO */
 
 #if defined(CONFIG_NET_GPTP)
 int eth_clock_gettime(struct net_ptp_time *time)
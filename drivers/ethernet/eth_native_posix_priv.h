@@ -25,6 +25,14 @@
 #define ETH_NATIVE_POSIX_STARTUP_SCRIPT_USER ""
 #endif
 
+/* Large TCP frame to be split by the host */
+struct eth_tso_info {
+	uint16_t hdr_len;	/* Length of the link, IP and TCP headers */
+	uint16_t l4_offset;	/* Offset of the TCP header */
+	uint16_t mss;		/* TCP payload in each segment */
+	bool ipv6;
+};
+
 int eth_iface_create(const char *if_name, bool tun_only);
 int eth_iface_remove(int fd);
 int eth_setup_host(const char *if_name);
@@ -32,6 +40,10 @@ int eth_start_script(const char *if_name);
 int eth_wait_data(int fd);
 ssize_t eth_read_data(int fd, void *buf, size_t buf_len);
 ssize_t eth_write_data(int fd, void *buf, size_t buf_len);
+#if defined(CONFIG_ETH_NATIVE_POSIX_TSO)
+ssize_t eth_write_data_tso(int fd, void *buf, size_t buf_len,
+			   const struct eth_tso_info *tso);
+#endif
 int eth_if_up(const char *if_name);
 int eth_if_down(const char *if_name);
 
@@ -754,6 +754,60 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+/**
+ * @brief Give a thread a CPU budget for each period
+ *
+ * This makes @a thread a constant bandwidth server: it may run for
+ * @a budget_us microseconds in every @a period_us microseconds, and its
+ * deadline is managed by the scheduler from then on.  When the thread
+ * wakes up, it gets a full budget and a deadline one period away,
+ * unless what is left of its current budget and deadline would not let
+ * it use more than its share of the CPU.  A thread which uses up its
+ * budget is not scheduled until the end of the period, its deadline,
+ * and then continues with a full budget and a deadline one period
+ * later.  Such overruns are counted, see k_thread_cbs_stats_get().
+ *
+ * As with k_thread_deadline_set(), deadlines only order threads with
+ * the same static priority, so threads sharing the CPU this way
+ * should all be given the same priority.  The budget is enforced at
+ * the granularity of the system clock tick.
+ *
+ * The sum of the shares of the CPU, budget over period, of all such
+ * threads may not exceed @option{CONFIG_SCHED_CBS_MAX_UTILIZATION}
+ * percent.  Passing a @a budget_us of zero removes the budget of the
+ * thread and releases its share.
+ *
+ * This is not a system call: the total share is a system-wide resource,
+ * so only supervisor threads may hand it out.
+ *
+ * @note You should enable @option{CONFIG_SCHED_CBS} in your project
+ * configuration.
+ *
+ * @param thread Thread to set the budget of.
+ * @param budget_us Budget in microseconds, or 0.
+ * @param period_us Period in microseconds.
+ *
+ * @retval 0 Budget set.
+ * @retval -EINVAL The budget is larger than the period, or the period is
+ *                 zero.
+ * @retval -EBUSY The share of the CPU would exceed the allowed total.
+ */
+int k_thread_cbs_set(k_tid_t thread, uint32_t budget_us, uint32_t period_us);
+
+/**
+ * @brief Get the budget enforcement statistics of a thread
+ *
+ * @param thread Thread to get the statistics of.
+ * @param stats Where to store the statistics.
+ *
+ * @retval 0 Statistics stored.
+ * @retval -EINVAL The thread has no budget.
+ */
+__syscall int k_thread_cbs_stats_get(k_tid_t thread,
+				     struct k_thread_cbs_stats *stats);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1636,10 +1690,19 @@ static inline uint32_t k_cycle_get_32(void)
  * @cond INTERNAL_HIDDEN
  */
 
+/* k_queue flags: appends must wake waiting threads or signal pollers */
+#define Z_QUEUE_WAITERS BIT(0)
+#define Z_QUEUE_POLLED BIT(1)
+
 struct k_queue {
 	sys_sflist_t data_q;
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	/* Appended items not yet moved to data_q, newest first */
+	atomic_ptr_t pending;
+	atomic_t flags;
+#endif
 
 	_POLL_EVENT;
 	_OBJECT_TRACING_NEXT_PTR(k_queue)
@@ -1657,6 +1720,22 @@ struct k_queue {
 
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+extern void z_queue_drain(struct k_queue *queue);
+#endif
+
+/* Move lock-free appended items to data_q before looking at it */
+static inline void z_queue_sync(struct k_queue *queue)
+{
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	if (atomic_ptr_get(&queue->pending) != NULL) {
+		z_queue_drain(queue);
+	}
+#else
+	ARG_UNUSED(queue);
+#endif
+}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -1786,7 +1865,8 @@ extern void k_queue_insert(struct k_queue *queue, void *prev, void *data);
  * This routine adds a list of data items to @a queue in one operation.
  * The data items must be in a singly-linked list, with the first word
  * in each data item pointing to the next data item; the list must be
- * NULL-terminated.
+ * NULL-terminated. Waiting threads, if any, are given the first data items
+ * in a single pass through the scheduler.
  *
  * @note Can be called by ISRs.
  *
@@ -1851,6 +1931,7 @@ __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
  */
 static inline bool k_queue_remove(struct k_queue *queue, void *data)
 {
+	z_queue_sync(queue);
 	return sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 }
 
@@ -1872,6 +1953,7 @@ static inline bool k_queue_unique_append(struct k_queue *queue, void *data)
 {
 	sys_sfnode_t *test;
 
+	z_queue_sync(queue);
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			return false;
@@ -1899,6 +1981,12 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	/* Called by k_poll(), must not take the queue lock */
+	if (atomic_ptr_get(&queue->pending) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -1915,6 +2003,7 @@ __syscall void *k_queue_peek_head(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	z_queue_sync(queue);
 	return z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 }
 
@@ -1931,6 +2020,7 @@ __syscall void *k_queue_peek_tail(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	z_queue_sync(queue);
 	return z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 }
 
@@ -2512,6 +2602,9 @@ struct k_delayed_work {
 	struct k_work work;
 	struct _timeout timeout;
 	struct k_work_q *work_q;
+#ifdef CONFIG_WORKQUEUE_COALESCE
+	uint32_t slack;
+#endif
 };
 
 struct k_work_poll {
@@ -2718,6 +2811,14 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+#ifdef CONFIG_WORKQUEUE_COALESCE
+#define Z_DELAYED_WORK_SLACK_INITIALIZER \
+	.slack = (CONFIG_WORKQUEUE_DEFAULT_SLACK_MS * \
+		  (uint64_t)CONFIG_SYS_CLOCK_TICKS_PER_SEC + 999) / 1000,
+#else
+#define Z_DELAYED_WORK_SLACK_INITIALIZER
+#endif
+
 #define Z_DELAYED_WORK_INITIALIZER(work_handler) \
 	{ \
 		.work = Z_WORK_INITIALIZER(work_handler), \
@@ -2727,6 +2828,7 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 			.dticks = 0, \
 		}, \
 		.work_q = NULL, \
+		Z_DELAYED_WORK_SLACK_INITIALIZER \
 	}
 
 /**
@@ -2760,6 +2862,32 @@ static inline void k_delayed_work_init(struct k_delayed_work *work,
 	*work = (struct k_delayed_work)Z_DELAYED_WORK_INITIALIZER(handler);
 }
 
+#ifdef CONFIG_WORKQUEUE_COALESCE
+/**
+ * @brief Set the expiry slack of a delayed work item.
+ *
+ * Allows the item to be processed up to @p slack later than the delay
+ * it is submitted with, so that its timeout can be coalesced with
+ * others.  The expiry is moved to the tick within the allowed range
+ * that is a multiple of the largest power of two, which lines up
+ * items with similar deadlines and slack without any bookkeeping.
+ * Takes effect on the next submission.  k_delayed_work_init() resets
+ * the slack to CONFIG_WORKQUEUE_DEFAULT_SLACK_MS.
+ *
+ * @param work Address of delayed work item.
+ * @param slack Tolerated extra delay, or K_NO_WAIT for none.
+ *
+ * @return N/A
+ */
+static inline void k_delayed_work_slack_set(struct k_delayed_work *work,
+					    k_timeout_t slack)
+{
+	__ASSERT(!K_TIMEOUT_EQ(slack, K_FOREVER) &&
+		 Z_TICK_ABS(slack.ticks) < 0, "slack must be relative");
+	work->slack = (uint32_t)slack.ticks;
+}
+#endif
+
 /**
  * @brief Submit a delayed work item.
  *
@@ -3259,6 +3387,138 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @}
  */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* k_rwlock state: reader count in the low bits, plus these flags */
+#define Z_RWLOCK_WRITER		BIT(31)
+/* Threads are waiting: lock and unlock must go through the slow path */
+#define Z_RWLOCK_WAITERS	BIT(30)
+/* k_poll() may be waiting on the lock: likewise */
+#define Z_RWLOCK_POLLED		BIT(29)
+#define Z_RWLOCK_READERS	(BIT(29) - 1)
+
+struct k_rwlock {
+	atomic_t state;
+	_wait_q_t rd_wait_q;
+	_wait_q_t wr_wait_q;
+	struct k_thread *writer;
+	int writer_orig_prio;
+	_POLL_EVENT;
+};
+
+#define Z_RWLOCK_INITIALIZER(obj) \
+	{ \
+	.state = ATOMIC_INIT(0), \
+	.rd_wait_q = Z_WAIT_Q_INIT(&obj.rd_wait_q), \
+	.wr_wait_q = Z_WAIT_Q_INIT(&obj.wr_wait_q), \
+	.writer = NULL, \
+	.writer_orig_prio = K_LOWEST_THREAD_PRIO, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * This routine initializes a reader-writer lock object, prior to its
+ * first use.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock object created
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * This routine locks @a rwlock for reading. Any number of threads may
+ * hold the lock for reading at the same time, but not while a thread
+ * holds it for writing. Writers are preferred: if a thread is waiting
+ * to lock @a rwlock for writing, the calling thread waits as well.
+ *
+ * A read lock is not recursive: a thread that already holds the lock
+ * for reading must not lock it again, as that can deadlock against a
+ * waiting writer.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock,
+				 k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock held for reading.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * This routine locks @a rwlock for exclusive use by the calling thread.
+ * While it is held for writing, the lock is subject to priority
+ * inheritance like a mutex: its owner's priority is raised to that of
+ * the highest priority thread waiting for the lock. Threads holding
+ * the lock for reading do not inherit priorities.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EDEADLK The calling thread already holds the lock for writing.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock,
+				  k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock held for writing.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EPERM The calling thread does not hold the lock for writing.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE(k_rwlock, name) = \
+		Z_RWLOCK_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -3408,6 +3668,8 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 struct k_msgq {
 	/** Message queue wait queue */
 	_wait_q_t wait_q;
+	/** Threads waiting for a claim to be finished */
+	_wait_q_t claim_wait_q;
 	/** Lock */
 	struct k_spinlock lock;
 	/** Message size */
@@ -3425,11 +3687,15 @@ struct k_msgq {
 	/** Number of used messages */
 	uint32_t used_msgs;
 
+	_POLL_EVENT;
+
 	_OBJECT_TRACING_NEXT_PTR(k_msgq)
 	_OBJECT_TRACING_LINKED_FLAG
 
 	/** Message queue */
 	uint8_t flags;
+	/** Outstanding zero-copy claims */
+	uint8_t claims;
 };
 /**
  * @cond INTERNAL_HIDDEN
@@ -3439,6 +3705,7 @@ struct k_msgq {
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.claim_wait_q = Z_WAIT_Q_INIT(&obj.claim_wait_q), \
 	.msg_size = q_msg_size, \
 	.max_msgs = q_max_msgs, \
 	.buffer_start = q_buffer, \
@@ -3446,6 +3713,7 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -3456,6 +3724,9 @@ struct k_msgq {
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
 
+#define K_MSGQ_CLAIM_PUT	BIT(0)
+#define K_MSGQ_CLAIM_GET	BIT(1)
+
 /**
  * @brief Message Queue Attributes
  */
@@ -3622,6 +3893,102 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  */
 __syscall void k_msgq_purge(struct k_msgq *msgq);
 
+/**
+ * @brief Claim a free slot of a message queue for writing in place.
+ *
+ * This routine reserves the next free slot in the ring buffer of message
+ * queue @a msgq and returns its address in @a slot. The caller fills in the
+ * message directly and then calls k_msgq_put_commit() to make it visible to
+ * receivers, avoiding the copy done by k_msgq_put().
+ *
+ * Only one put claim may be outstanding at a time; while it is held,
+ * k_msgq_put() and further put claims on @a msgq wait for it to be
+ * committed. Called with K_NO_WAIT, k_msgq_put() returns -ENOMSG and
+ * k_msgq_put_claim() returns -EBUSY instead.
+ *
+ * A user thread may only claim slots if it has write access to the message
+ * queue's ring buffer.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Address of a pointer set to the claimed slot.
+ * @param timeout Waiting period for a free slot,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Slot claimed.
+ * @retval -EBUSY A put claim is outstanding and @a timeout is K_NO_WAIT.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_claim(struct k_msgq *msgq, void **slot,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Commit a message written into a claimed slot.
+ *
+ * This routine hands the slot obtained with k_msgq_put_claim() to the
+ * receivers of message queue @a msgq, exactly as if the message had been
+ * sent with k_msgq_put().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL No put claim is outstanding.
+ */
+__syscall int k_msgq_put_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Claim the oldest message of a message queue for reading in place.
+ *
+ * This routine returns in @a msg the address of the oldest message in the
+ * ring buffer of message queue @a msgq without copying it out. The message
+ * stays in the queue, and its slot is not reused, until k_msgq_get_release()
+ * is called.
+ *
+ * Only one get claim may be outstanding at a time; while it is held,
+ * k_msgq_get() and further get claims on @a msgq wait for it to be
+ * released. Called with K_NO_WAIT, k_msgq_get() returns -ENOMSG and
+ * k_msgq_get_claim() returns -EBUSY instead. k_msgq_purge() drops an
+ * outstanding get claim.
+ *
+ * A user thread may only claim messages if it has read access to the
+ * message queue's ring buffer.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param msg Address of a pointer set to the claimed message.
+ * @param timeout Waiting period for a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -EBUSY A get claim is outstanding and @a timeout is K_NO_WAIT.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_claim(struct k_msgq *msgq, void **msg,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Release a message obtained with k_msgq_get_claim().
+ *
+ * This routine removes the claimed message from message queue @a msgq and
+ * makes its slot available to senders.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message released.
+ * @retval -EINVAL No get claim is outstanding.
+ */
+__syscall int k_msgq_get_release(struct k_msgq *msgq);
+
 /**
  * @brief Get the amount of free space in a message queue.
  *
@@ -3850,6 +4217,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -3874,6 +4243,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4013,6 +4384,93 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Claim free space in a pipe's buffer for writing in place.
+ *
+ * This routine reserves the largest contiguous run of free space at the
+ * write position of @a pipe's buffer and returns its address and length. The
+ * caller writes data there directly and then calls k_pipe_put_commit(),
+ * avoiding the copy done by k_pipe_put().
+ *
+ * Only one put claim may be outstanding at a time; while it is held,
+ * k_pipe_put() and further put claims on @a pipe return -EBUSY.
+ *
+ * A user thread may only claim space if it has write access to the pipe's
+ * buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of a pointer set to the claimed space.
+ * @param size Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for free space,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space claimed.
+ * @retval -EINVAL The pipe has no buffer.
+ * @retval -EBUSY A put claim is already outstanding.
+ * @retval -EIO Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_pipe_put_claim(struct k_pipe *pipe, void **data,
+			       size_t *size, k_timeout_t timeout);
+
+/**
+ * @brief Commit data written into claimed pipe space.
+ *
+ * This routine appends the first @a bytes bytes of the space obtained with
+ * k_pipe_put_claim() to the data in @a pipe and serves any waiting readers.
+ * The rest of the claimed space is returned to the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes written, at most the claimed size.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL No put claim is outstanding or @a bytes is too large.
+ */
+__syscall int k_pipe_put_commit(struct k_pipe *pipe, size_t bytes);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading in place.
+ *
+ * This routine returns the address and length of the largest contiguous run
+ * of data at the read position of @a pipe's buffer without copying it out.
+ * The data stays in the pipe until k_pipe_get_release() is called.
+ *
+ * Only one get claim may be outstanding at a time; while it is held,
+ * k_pipe_get() and further get claims on @a pipe return -EBUSY.
+ *
+ * A user thread may only claim data if it has read access to the pipe's
+ * buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of a pointer set to the claimed data.
+ * @param size Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for data,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data claimed.
+ * @retval -EINVAL The pipe has no buffer.
+ * @retval -EBUSY A get claim is already outstanding.
+ * @retval -EIO Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_pipe_get_claim(struct k_pipe *pipe, void **data,
+			       size_t *size, k_timeout_t timeout);
+
+/**
+ * @brief Release data obtained with k_pipe_get_claim().
+ *
+ * This routine removes the first @a bytes bytes of the claimed data from
+ * @a pipe and lets any waiting writers use the freed space. The rest of the
+ * claimed data stays in the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes consumed, at most the claimed size.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL No get claim is outstanding or @a bytes is too large.
+ */
+__syscall int k_pipe_get_release(struct k_pipe *pipe, size_t bytes);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -4039,16 +4497,30 @@ __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Per-CPU cache of free blocks */
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	void *blocks[CONFIG_MEM_SLAB_CACHE_DEPTH];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	uint32_t num_blocks;
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+	/* Blocks not on the free list, including cached ones */
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CACHE
+	struct z_mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+	atomic_t waiters;
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -4162,11 +4634,32 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/**
+ * @brief Flush the per-CPU caches of a memory slab.
+ *
+ * This routine returns every free block held in the per-CPU caches of
+ * @a slab (see @option{CONFIG_MEM_SLAB_CACHE}) to its free list. The
+ * slab does this by itself before an allocation fails or blocks, so
+ * this is only needed to make all free blocks available to a CPU at
+ * once, e.g. ahead of a burst of allocations.
+ *
+ * @param slab Address of the memory slab.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_cache_flush(struct k_mem_slab *slab);
+
+/* Number of blocks allocated to callers, not counting cached blocks */
+extern uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+#endif
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
  * This routine gets the number of memory blocks that are currently
- * allocated in @a slab.
+ * allocated in @a slab. Free blocks held in the per-CPU caches of the
+ * slab are not counted as allocated.
  *
  * @param slab Address of the memory slab.
  *
@@ -4174,14 +4667,20 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
  * @brief Get the number of maximum used blocks so far in a memory slab.
  *
  * This routine gets the maximum number of memory blocks that were
- * allocated in @a slab.
+ * allocated in @a slab. With @option{CONFIG_MEM_SLAB_CACHE}, blocks
+ * held in the per-CPU caches at the time are included, so this is an
+ * upper bound.
  *
  * @param slab Address of the memory slab.
  *
@@ -4209,7 +4708,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -4219,12 +4718,52 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
  * @{
  */
 
+#ifdef CONFIG_HEAP_CACHE
+/**
+ * @brief k_heap front-end cache statistics
+ *
+ * Counters are accumulated over all CPUs since the heap was
+ * initialized, except @a cached_blocks which is the current number
+ * of free blocks held in the cache.
+ */
+struct k_heap_cache_stats {
+	/** Allocations served from the cache */
+	uint32_t hits;
+	/** Cacheable allocations that had to go to the heap */
+	uint32_t misses;
+	/** Frees kept in the cache */
+	uint32_t cached_frees;
+	/** Blocks returned from the cache to the heap */
+	uint32_t spilled;
+	/** Number of times the whole cache was flushed */
+	uint32_t flushes;
+	/** Free blocks currently held in the cache */
+	uint32_t cached_blocks;
+};
+
+struct z_heap_magazine {
+	uint32_t count;
+	void *blocks[CONFIG_HEAP_CACHE_DEPTH];
+};
+
+/* Per-CPU cache, one magazine per size class */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	struct z_heap_magazine mags[CONFIG_HEAP_CACHE_CLASSES];
+	struct k_heap_cache_stats stats;
+};
+#endif
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_CACHE
+	struct z_heap_cache cache[CONFIG_MP_NUM_CPUS];
+	atomic_t waiters;
+#endif
 };
 
 /**
@@ -4296,6 +4835,57 @@ static inline void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#ifdef CONFIG_HEAP_CACHE
+/**
+ * @brief Flush the front-end cache of a k_heap
+ *
+ * Returns every free block held in the per-CPU caches of the heap
+ * (see @option{CONFIG_HEAP_CACHE}) to the underlying sys_heap, where
+ * it can be merged with its neighbors and used for allocations of
+ * any size.  The heap does this by itself before failing or blocking
+ * an allocation, so this is only needed to defragment the heap
+ * ahead of a large allocation or before inspecting it.
+ *
+ * @param h Heap whose cache to flush
+ */
+void k_heap_cache_flush(struct k_heap *h);
+
+/**
+ * @brief Get k_heap front-end cache statistics
+ *
+ * @param h Heap to query
+ * @param stats Filled with the statistics summed over all CPUs
+ */
+void k_heap_cache_stats_get(struct k_heap *h,
+			    struct k_heap_cache_stats *stats);
+#endif
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+/**
+ * @brief Get runtime statistics of a k_heap
+ *
+ * Synchronized version of sys_heap_runtime_stats_get().  Blocks held
+ * in the front-end cache (@option{CONFIG_HEAP_CACHE}) are counted as
+ * allocated.
+ *
+ * @param h Heap to query
+ * @param stats Filled with the statistics
+ * @return 0 on success, -EINVAL on invalid arguments
+ */
+int k_heap_runtime_stats_get(struct k_heap *h,
+			     struct sys_heap_runtime_stats *stats);
+
+/**
+ * @brief Reset the peak usage and latency histograms of a k_heap
+ *
+ * Synchronized version of sys_heap_runtime_stats_reset_max().
+ *
+ * @param h Heap to reset
+ * @return 0 on success, -EINVAL on invalid arguments
+ */
+int k_heap_runtime_stats_reset_max(struct k_heap *h);
+#endif
+
 /**
  * @brief Define a static k_heap
  *
@@ -4412,6 +5002,12 @@ enum _poll_types_bits {
 	/* queue/FIFO/LIFO data availability */
 	_POLL_TYPE_DATA_AVAILABLE,
 
+	/* message queue data availability */
+	_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+
+	/* reader-writer lock availability */
+	_POLL_TYPE_RWLOCK_AVAILABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -4434,6 +5030,12 @@ enum _poll_states_bits {
 	/* queue/FIFO/LIFO wait was cancelled */
 	_POLL_STATE_CANCELLED,
 
+	/* data is available to read on a message queue */
+	_POLL_STATE_MSGQ_DATA_AVAILABLE,
+
+	/* reader-writer lock is not held */
+	_POLL_STATE_RWLOCK_AVAILABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -4464,6 +5066,8 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_SEM_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_SEM_AVAILABLE)
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
+#define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_TYPE_RWLOCK_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_RWLOCK_AVAILABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -4480,6 +5084,8 @@ enum k_poll_modes {
 #define K_POLL_STATE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
+#define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_STATE_RWLOCK_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_RWLOCK_AVAILABLE)
 
 /* public - poll signal object */
 struct k_poll_signal {
@@ -4535,6 +5141,8 @@ struct k_poll_event {
 		struct k_sem *sem;
 		struct k_fifo *fifo;
 		struct k_queue *queue;
+		struct k_msgq *msgq;
+		struct k_rwlock *rwlock;
 	};
 };
 
@@ -4688,10 +5296,104 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Poll Set
+ *
+ * A persistent set of poll events, see k_poll_set_wait().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * Registers the event with its object once: unlike with k_poll(), the
+ * event stays registered across any number of k_poll_set_wait() calls
+ * until it is removed with k_poll_set_remove().  The event memory must
+ * remain valid and must not be passed to k_poll() while in the set.
+ *
+ * @param set The poll set.
+ * @param event An event initialized with k_poll_event_init().
+ *
+ * @retval 0 The event was added.
+ * @retval -EBUSY The event is already registered somewhere.
+ */
+extern int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event An event previously added to @a set.
+ *
+ * @retval 0 The event was removed.
+ * @retval -EINVAL The event is not in @a set.
+ */
+extern int k_poll_set_remove(struct k_poll_set *set,
+			     struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Returns pointers to up to @a max_ready events of the set whose
+ * condition is met, with their state field set as by k_poll().  The
+ * cost depends on the number of events that were signaled since the
+ * last call, not on the size of the set: objects append their events
+ * to the set's ready list when they signal, and only those are
+ * checked.
+ *
+ * Events are level triggered: an event that is returned is checked
+ * again on the next call and returned again as long as its condition
+ * (e.g. a semaphore count or a queue being non-empty, or a poll
+ * signal not having been reset) still holds.  Otherwise it is rearmed
+ * on its object.  Ready events are returned round-robin when there
+ * are more than @a max_ready.
+ *
+ * An event whose wait was cancelled, e.g. with k_fifo_cancel_wait(),
+ * is returned once with K_POLL_STATE_CANCELLED and then no longer
+ * watched.  It stays in the set until removed with k_poll_set_remove();
+ * remove and add it again to watch its object anew.
+ *
+ * As with k_poll(), threads pending directly on an object have
+ * precedence over the poll set, and an object only notifies one of
+ * the sets or k_poll() callers waiting on it at a time.
+ *
+ * @param set The poll set.
+ * @param ready Array receiving pointers to the ready events.
+ * @param max_ready Size of @a ready, must be positive.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events (at least one), or
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready, int max_ready,
+			   k_timeout_t timeout);
+
 /**
  * @internal
  */
 extern void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state);
+extern void z_handle_obj_poll_events_all(sys_dlist_t *events, uint32_t state,
+					 atomic_t *flags, atomic_val_t polled);
 
 /** @} */
 
@@ -4741,6 +5443,19 @@ static inline void k_cpu_atomic_idle(unsigned int key)
 	arch_cpu_atomic_idle(key);
 }
 
+#ifdef CONFIG_IDLE_WAKEUP_STATS
+/**
+ * @brief Get the number of wakeups from idle.
+ *
+ * Returns how often the idle threads of all CPUs have returned from
+ * their idle state (via k_cpu_idle() or a power management state)
+ * since boot.  Sampling it twice gives the wakeup rate of the system.
+ *
+ * @return Number of wakeups from idle.
+ */
+uint32_t k_cpu_idle_wakeups_get(void);
+#endif
+
 /**
  * @}
  */
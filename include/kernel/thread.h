@@ -35,6 +35,35 @@ struct __thread_entry {
 };
 #endif
 
+/**
+ * @ingroup thread_apis
+ * Budget enforcement statistics of a thread, see k_thread_cbs_set()
+ */
+struct k_thread_cbs_stats {
+	/** Number of times the thread used up its budget */
+	uint32_t overruns;
+	/** Number of times the thread was throttled until replenishment */
+	uint32_t throttles;
+	/** Longest time the thread ran past its budget, in cycles */
+	uint32_t max_overrun_cycles;
+};
+
+#ifdef CONFIG_SCHED_CBS
+/* Constant bandwidth server state of a thread */
+struct _thread_cbs {
+	/* budget and period in cycles, budget is 0 for other threads */
+	uint32_t budget;
+	uint32_t period;
+	/* share of a CPU in units of 1/65536, for admission control */
+	uint32_t bandwidth;
+	/* budget left in the current period, in cycles */
+	int32_t remaining;
+	/* replenishes the budget of a throttled thread */
+	struct _timeout timeout;
+	struct k_thread_cbs_stats stats;
+};
+#endif
+
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
 struct _thread_base {
 
@@ -86,6 +115,10 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+	struct _thread_cbs cbs;
+#endif
+
 	uint32_t order_key;
 
 #ifdef CONFIG_SMP
@@ -159,6 +192,18 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+struct _thread_obj_cache {
+	/** kernel objects the thread was last granted access to */
+	const void *obj[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** their metadata */
+	struct z_object *ko[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** permission generation the entries are valid for */
+	uint32_t gen;
+	/** next entry to replace */
+	uint8_t next;
+};
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
@@ -280,6 +325,10 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 	/** current syscall frame pointer */
 	void *syscall_frame;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	/** recently validated kernel objects */
+	struct _thread_obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 
@@ -307,6 +356,11 @@ struct k_thread {
 	struct _thread_runtime_stats rt_stats;
 #endif
 
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	/** Number of page faults taken by this thread */
+	unsigned long pagefaults;
+#endif
+
 	/** arch-specifics: must always be at the end */
 	struct _thread_arch arch;
 };
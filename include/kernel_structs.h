@@ -61,6 +61,9 @@
 /* Thread is being aborted */
 #define _THREAD_ABORTING (BIT(5))
 
+/* Thread used up its CBS budget and waits for it to be replenished */
+#define _THREAD_THROTTLED (BIT(6))
+
 /* Thread is present in the ready queue */
 #define _THREAD_QUEUED (BIT(7))
 
@@ -122,8 +125,22 @@ struct _cpu {
 	int slice_ticks;
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+	/* Thread with a CBS budget running here, when it started running
+	 * and the number of ticks until its budget runs out
+	 */
+	struct k_thread *cbs_thread;
+	uint32_t cbs_start;
+	int cbs_ticks;
+#endif
+
 	uint8_t id;
 
+#ifdef CONFIG_IDLE_WAKEUP_STATS
+	/* number of returns from the idle state */
+	uint32_t idle_wakeups;
+#endif
+
 #ifdef CONFIG_SMP
 	/* True when _current is allowed to context switch */
 	uint8_t swap_ok;
@@ -222,7 +239,10 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  Ticks
+	 * after the previous timeout in the list or, with
+	 * CONFIG_TIMEOUT_QUEUE_WHEEL, absolute expiry tick.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
@@ -150,6 +150,9 @@ enum ethernet_hw_caps {
 	/** DSA switch */
 	ETHERNET_DSA_SLAVE_PORT	= BIT(15),
 	ETHERNET_DSA_MASTER_PORT	= BIT(16),
+
+	/** TCP segmentation offloading supported for IPv4 and IPv6 */
+	ETHERNET_HW_TCP_SEG_OFFLOAD	= BIT(17),
 };
 
 /** @cond INTERNAL_HIDDEN */
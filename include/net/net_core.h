@@ -112,6 +112,22 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver to push a batch of received
+ * network packets up in the network stack.
+ *
+ * @details The packets are linked in the list by their rx_node. They are
+ * queued to the RX threads at once, which then process them without a
+ * wakeup per packet.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param list List of network packets.
+ *
+ * @return 0 if ok, <0 if error. If <0 is returned, the packets that were
+ * not queued are left in the list and the caller needs to unref them.
+ */
+int net_recv_data_list(struct net_if *iface, sys_slist_t *list);
+
 /**
  * @brief Send data to network.
  *
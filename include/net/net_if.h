@@ -1928,6 +1928,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if a large TCP segment needs to be split by the IP stack
+ * before it is sent, or if the device can split it in hardware (TCP
+ * segmentation offloading).
+ *
+ * @param iface Network interface
+ *
+ * @return True if the IP stack needs to split the segment, false otherwise.
+ */
+bool net_if_need_tcp_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -44,16 +44,25 @@ void z_priq_rb_add(struct _priq_rb *pq, struct k_thread *thread);
 void z_priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread);
 struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
 
-/* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
+/* Traditional/textbook "multi-queue" structure.  Separate lists for
+ * each of the fixed priorities, indexed by a two-level bitmap: bit i
+ * of bitmask[w] is set if queues[w * 32 + i] is non-empty, and bit w
+ * of the summary word is set if bitmask[w] is non-zero.  Finding the
+ * best thread is then two count-trailing-zeros operations regardless
+ * of the number of priorities or runnable threads.  This corresponds
  * to the original Zephyr scheduler.  RAM requirements are
  * comparatively high, but performance is very fast.  Won't work with
  * features like deadline scheduling which need large priority spaces
  * to represent their requirements.
  */
+#define K_NUM_THREAD_PRIO (CONFIG_NUM_PREEMPT_PRIORITIES + \
+			   CONFIG_NUM_COOP_PRIORITIES + 1)
+#define PRIQ_BITMAP_SIZE (ceiling_fraction(K_NUM_THREAD_PRIO, 32))
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
-	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
+	sys_dlist_t queues[K_NUM_THREAD_PRIO];
+	unsigned int bitmask[PRIQ_BITMAP_SIZE];
+	unsigned int summary; /* bit 1<<w set if bitmask[w] is non-zero */
 };
 
 void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
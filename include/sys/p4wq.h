@@ -17,13 +17,28 @@ struct k_p4wq_work;
  */
 typedef void (*k_p4wq_handler_t)(struct k_p4wq_work *work);
 
+#ifdef CONFIG_P4WQ_EXECUTOR
+/**
+ * @brief P4 Queue dependency edge
+ *
+ * Caller-owned storage for one edge of a work item dependency graph,
+ * see k_p4wq_work_depend().  Must remain valid until the
+ * prerequisite item completes.
+ */
+struct k_p4wq_dep {
+	sys_snode_t node;
+	struct k_p4wq_work *work;
+};
+#endif
+
 /**
  * @brief P4 Queue Work Item
  *
  * User-populated struct representing a single work item.  The
  * priority and deadline fields are interpreted as thread scheduling
  * priorities, exactly as per k_thread_priority_set() and
- * k_thread_deadline_set().
+ * k_thread_deadline_set().  The reserved fields must be initialized
+ * with k_p4wq_work_init() unless the item is statically zeroed.
  */
 struct k_p4wq_work {
 	/* Filled out by submitting code */
@@ -35,8 +50,18 @@ struct k_p4wq_work {
 	union {
 		struct rbnode rbnode;
 		sys_dlist_t dlnode;
+#ifdef CONFIG_P4WQ_EXECUTOR
+		sys_snode_t readynode;
+#endif
 	};
 	struct k_thread *thread;
+#ifdef CONFIG_P4WQ_EXECUTOR
+	struct k_p4wq *queue;
+	sys_slist_t successors;
+	_wait_q_t waitq;
+	uint16_t npending;
+	uint8_t state;
+#endif
 };
 
 /**
@@ -63,6 +88,19 @@ struct k_p4wq {
 
 	/* Work items in progress */
 	sys_dlist_t active;
+
+#ifdef CONFIG_P4WQ_EXECUTOR
+	/* Dynamic worker pool, see k_p4wq_pool_init() */
+	struct k_thread *threads;
+	struct z_thread_stack_element *stacks;
+	size_t stack_size;
+	uint32_t live;
+	uint32_t started;
+	uint8_t min_threads;
+	uint8_t max_threads;
+	uint8_t nthreads;
+	uint8_t cpu_mask;
+#endif
 };
 
 struct k_p4wq_initparam {
@@ -71,6 +109,10 @@ struct k_p4wq_initparam {
 	struct k_p4wq *queue;
 	struct k_thread *threads;
 	struct z_thread_stack_element *stacks;
+#ifdef CONFIG_P4WQ_EXECUTOR
+	uint32_t min;
+	uint32_t cpu_mask;
+#endif
 };
 
 /**
@@ -84,6 +126,10 @@ struct k_p4wq_initparam {
  * @param n_threads Number of threads in the work queue pool
  * @param stack_sz Requested stack size of each thread, in bytes
  */
+#ifdef CONFIG_P4WQ_EXECUTOR
+#define K_P4WQ_DEFINE(name, n_threads, stack_sz)			\
+	K_P4WQ_POOL_DEFINE(name, n_threads, n_threads, stack_sz, 0)
+#else
 #define K_P4WQ_DEFINE(name, n_threads, stack_sz)			\
 	static K_THREAD_STACK_ARRAY_DEFINE(_p4stacks_##name,		\
 					   n_threads, stack_sz);	\
@@ -97,6 +143,43 @@ struct k_p4wq_initparam {
 		.stacks = &(_p4stacks_##name[0][0]),			\
 		.queue = &name,						\
 	}
+#endif
+
+#ifdef CONFIG_P4WQ_EXECUTOR
+/**
+ * @brief Statically initialize a P4 Work Queue with a dynamic pool
+ *
+ * Like K_P4WQ_DEFINE(), but only @p min_threads threads are started
+ * at boot.  Further threads, up to @p max_threads, are started on
+ * demand when a submitted item should run but no idle thread is
+ * available, and threads above the minimum exit again after
+ * CONFIG_P4WQ_IDLE_TIMEOUT_MS milliseconds without work.  Stack
+ * memory for all @p max_threads threads is reserved statically.
+ *
+ * @param name Symbol name of the struct k_p4wq that will be defined
+ * @param min_threads Number of threads always present in the pool
+ * @param max_threads Maximum number of threads in the pool (<= 32)
+ * @param stack_sz Requested stack size of each thread, in bytes
+ * @param cpus CPU mask the pool threads may run on, zero for all
+ *             (requires CONFIG_SCHED_CPU_MASK if nonzero)
+ */
+#define K_P4WQ_POOL_DEFINE(name, min_threads, max_threads, stack_sz, cpus) \
+	BUILD_ASSERT((min_threads) <= (max_threads) && (max_threads) <= 32); \
+	static K_THREAD_STACK_ARRAY_DEFINE(_p4stacks_##name,		\
+					   max_threads, stack_sz);	\
+	static struct k_thread _p4threads_##name[max_threads];		\
+	static struct k_p4wq name;					\
+	static const Z_STRUCT_SECTION_ITERABLE(k_p4wq_initparam,	\
+					       _init_##name) = {	\
+		.num = max_threads,					\
+		.min = min_threads,					\
+		.cpu_mask = cpus,					\
+		.stack_size = stack_sz,					\
+		.threads = _p4threads_##name,				\
+		.stacks = &(_p4stacks_##name[0][0]),			\
+		.queue = &name,						\
+	}
+#endif
 
 /**
  * @brief Initialize P4 Queue
@@ -109,6 +192,20 @@ struct k_p4wq_initparam {
  */
 void k_p4wq_init(struct k_p4wq *queue);
 
+/**
+ * @brief Initialize a P4 work item
+ *
+ * Initializes the fields of the item reserved for the implementation,
+ * leaving the priority, deadline and handler alone.  Must be called
+ * before the first submission (or, with CONFIG_P4WQ_EXECUTOR, before
+ * dependencies are added) of an item that is not statically zeroed,
+ * such as one allocated from a heap or on the stack, and must not be
+ * called while the item is submitted or waited for.
+ *
+ * @param work Work item to initialize
+ */
+void k_p4wq_work_init(struct k_p4wq_work *work);
+
 /**
  * @brief Dynamically add a thread object to a P4 Queue pool
  *
@@ -125,6 +222,82 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
 		       k_thread_stack_t *stack,
 		       size_t stack_size);
 
+#ifdef CONFIG_P4WQ_EXECUTOR
+/**
+ * @brief Attach a dynamic worker pool to a P4 Queue
+ *
+ * Hands an array of @p max_threads unused thread objects and their
+ * stacks (as defined by K_THREAD_STACK_ARRAY_DEFINE()) to the queue
+ * and starts @p min_threads of them.  The remaining threads are
+ * started and retired on demand, see K_P4WQ_POOL_DEFINE().  May be
+ * called only once per queue.
+ *
+ * @param queue P4 Queue to which to attach the pool
+ * @param threads Array of @p max_threads thread objects
+ * @param stacks First element of the thread stack array
+ * @param stack_size Requested stack size of each thread
+ * @param min_threads Number of threads always present in the pool
+ * @param max_threads Number of threads in the arrays (<= 32)
+ * @param cpu_mask CPUs the pool threads may run on, zero for all
+ */
+void k_p4wq_pool_init(struct k_p4wq *queue, struct k_thread *threads,
+		      struct z_thread_stack_element *stacks,
+		      size_t stack_size, uint32_t min_threads,
+		      uint32_t max_threads, uint32_t cpu_mask);
+
+/**
+ * @brief Number of running pool threads of a P4 Queue
+ *
+ * @param queue P4 Queue
+ * @return Number of pool threads currently started
+ */
+int k_p4wq_pool_size(struct k_p4wq *queue);
+
+/**
+ * @brief Make a P4 work item depend on another one
+ *
+ * Adds a dependency edge so that @p work, once submitted, is only
+ * queued for execution after the next completion of @p prereq.  An
+ * item may have any number of prerequisites and dependents, forming
+ * a DAG.  When the last prerequisite of a submitted item completes,
+ * the item is queued to the queue it was submitted to from the
+ * thread that ran the prerequisite.
+ *
+ * Edges are consumed when the prerequisite completes, so a graph
+ * that is run again must be linked again.  Cancelling a
+ * prerequisite does not release its dependents.
+ *
+ * @param work Dependent work item, must not be submitted yet
+ * @param prereq Prerequisite work item
+ * @param dep Edge storage, valid until @p prereq completes
+ * @retval 0 Dependency added
+ * @retval -EBUSY @p work is already submitted
+ */
+int k_p4wq_work_depend(struct k_p4wq_work *work,
+		       struct k_p4wq_work *prereq,
+		       struct k_p4wq_dep *dep);
+
+/**
+ * @brief Wait for a P4 work item to complete
+ *
+ * Blocks until the handler of the submitted item has returned (and
+ * the item was not resubmitted from it).  Once completed, the item
+ * stays completed until it is submitted again, so this acts as a
+ * future for the item's result.  Any number of threads may wait for
+ * the same item.  Waiting for an item that was never submitted, or
+ * that is cancelled, fails rather than blocking.
+ *
+ * @param work Work item to wait for
+ * @param timeout Waiting period, or one of the special values
+ *                K_NO_WAIT and K_FOREVER
+ * @retval 0 Item completed
+ * @retval -EINVAL Item not submitted, or cancelled while waiting
+ * @retval -EBUSY Item not complete and @p timeout was K_NO_WAIT
+ * @retval -EAGAIN Waiting period timed out
+ */
+int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout);
+#endif
+
 /**
  * @brief Submit work item to a P4 queue
  *
@@ -138,6 +311,11 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
  * queue.  The memory should remain unchanged until k_p4wq_cancel() is
  * called or until the entry to the handler function.
  *
+ * With CONFIG_P4WQ_EXECUTOR, an item with unfinished prerequisites
+ * (see k_p4wq_work_depend()) is held back until they complete and
+ * its deadline counts from that point.  If no thread of a dynamic
+ * pool is idle, a new one may be started (except from ISRs).
+ *
  * @note This call is a scheduling point, so if the submitted item (or
  * any other ready thread) has a higher priority than the current
  * thread and the current thread has a preemptible priority then the
@@ -152,8 +330,9 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item);
  * @brief Cancel submitted P4 work item
  *
  * Cancels a previously-submitted work item and removes it from the
- * queue.  Returns true if the item was found in the queue and
- * removed.  If the function returns false, either the item was never
+ * queue (or, with CONFIG_P4WQ_EXECUTOR, from the set of items held
+ * back for their prerequisites).  Returns true if the item was found
+ * in the queue and removed.  If the function returns false, either the item was never
  * submitted, has already been executed, or is still running.
  *
  * @return true if the item was successfully removed, otherwise false
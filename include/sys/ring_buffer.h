@@ -57,6 +57,30 @@ struct ring_buf {
 	struct k_spinlock lock;
 };
 
+/**
+ * @brief A contiguous segment of ring buffer memory
+ *
+ * See ring_buf_put_claim_sg() and ring_buf_get_claim_sg().
+ */
+struct ring_buf_seg {
+	uint8_t *data;	/**< Start of the segment */
+	uint32_t size;	/**< Size of the segment, in bytes */
+};
+
+/**
+ * @brief A data item, for batched item mode access
+ *
+ * See ring_buf_item_put_batch() and ring_buf_item_get_batch().
+ */
+struct ring_buf_item {
+	uint32_t *data;	 /**< Item data */
+	uint16_t type;	 /**< Item type identifier (application specific) */
+	uint8_t value;	 /**< Item integer value (application specific) */
+	uint8_t size32;	 /**< Item data size, or storage size for reads
+			  * (number of 32-bit words)
+			  */
+};
+
 /**
  * @defgroup ring_buffer_apis Ring Buffer APIs
  * @ingroup kernel_apis
@@ -266,6 +290,54 @@ int ring_buf_item_put(struct ring_buf *buf, uint16_t type, uint8_t value,
 int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 		      uint32_t *data, uint8_t *size32);
 
+/**
+ * @brief Write several data items to a ring buffer.
+ *
+ * Behaves like calling ring_buf_item_put() for each item in turn,
+ * except that the items become visible to the reader all at once and
+ * the free space is only checked once.  Items that do not fit are
+ * counted as dropped.
+ *
+ * @warning
+ * Use cases involving multiple writers to the ring buffer must prevent
+ * concurrent write operations, either by preventing all writers from
+ * being preempted or by using a mutex to govern writes to the ring buffer.
+ *
+ * @param buf Address of ring buffer.
+ * @param items Items to write.
+ * @param count Number of items.
+ *
+ * @return Number of items written, the first ones of @a items.
+ */
+int ring_buf_item_put_batch(struct ring_buf *buf,
+			    const struct ring_buf_item *items, size_t count);
+
+/**
+ * @brief Read several data items from a ring buffer.
+ *
+ * Behaves like calling ring_buf_item_get() for each item in turn,
+ * except that the space of all items read is freed at once. Reading
+ * stops when the ring buffer is empty or the next item does not fit
+ * in the storage of the corresponding entry of @a items.
+ *
+ * @warning
+ * Use cases involving multiple reads of the ring buffer must prevent
+ * concurrent read operations, either by preventing all readers from
+ * being preempted or by using a mutex to govern reads to the ring buffer.
+ *
+ * @param buf Address of ring buffer.
+ * @param items Items to fill. The @a data and @a size32 fields must be
+ *		set to the storage area of each item and its size, and are
+ *		updated to the size of the item read.
+ * @param count Number of items.
+ *
+ * @return Number of items read (0 if the ring buffer is empty), or
+ *	   -EMSGSIZE if the first item does not fit, with @a size32 of
+ *	   the first entry set to the number of 32-bit words needed.
+ */
+int ring_buf_item_get_batch(struct ring_buf *buf,
+			    struct ring_buf_item *items, size_t count);
+
 /**
  * @brief Allocate buffer for writing data to a ring buffer.
  *
@@ -294,6 +366,31 @@ uint32_t ring_buf_put_claim(struct ring_buf *buf,
 			    uint8_t **data,
 			    uint32_t size);
 
+/**
+ * @brief Allocate both segments of free space for writing to a ring buffer.
+ *
+ * Like ring_buf_put_claim(), but when the free space wraps around the
+ * end of the buffer its remainder is returned as a second segment,
+ * e.g. to set up a single scatter-gather DMA transfer. The data
+ * written to both segments is confirmed with a single call to
+ * ring_buf_put_finish() (see @ref ring_buf_put_finish).
+ *
+ * @warning
+ * Use cases involving multiple writers to the ring buffer must prevent
+ * concurrent write operations, either by preventing all writers from
+ * being preempted or by using a mutex to govern writes to the ring buffer.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] seg  Set to the claimed segments, in order. The second
+ *		    one is empty (with NULL data) if not needed.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Total size of the segments, which can be smaller than
+ *	   requested if there is not enough free space.
+ */
+uint32_t ring_buf_put_claim_sg(struct ring_buf *buf,
+			       struct ring_buf_seg seg[2], uint32_t size);
+
 /**
  * @brief Indicate number of bytes written to allocated buffers.
  *
@@ -364,6 +461,32 @@ uint32_t ring_buf_get_claim(struct ring_buf *buf,
 			    uint8_t **data,
 			    uint32_t size);
 
+/**
+ * @brief Get both segments of valid data in a ring buffer.
+ *
+ * Like ring_buf_get_claim(), but when the valid data wraps around the
+ * end of the buffer its remainder is returned as a second segment, so
+ * that all of it can be processed (e.g. transmitted by a single
+ * scatter-gather DMA transfer) without copying. The data is freed
+ * with a single call to ring_buf_get_finish() (see
+ * @ref ring_buf_get_finish).
+ *
+ * @warning
+ * Use cases involving multiple reads of the ring buffer must prevent
+ * concurrent read operations, either by preventing all readers from
+ * being preempted or by using a mutex to govern reads to the ring buffer.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] seg  Set to the segments of valid data, in order. The
+ *		    second one is empty (with NULL data) if not needed.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Total size of the segments, which can be smaller than
+ *	   requested if there is not enough valid data.
+ */
+uint32_t ring_buf_get_claim_sg(struct ring_buf *buf,
+			       struct ring_buf_seg seg[2], uint32_t size);
+
 /**
  * @brief Indicate number of bytes read from claimed buffer.
  *
@@ -406,6 +529,187 @@ int ring_buf_get_finish(struct ring_buf *buf, uint32_t size);
  */
 uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size);
 
+/**
+ * @brief A lock-free multi-producer, multi-consumer ring buffer
+ *
+ * Unlike @ref ring_buf, which must be serialized by the caller when
+ * several contexts write (or read) it, this ring can be used
+ * concurrently by any number of threads and ISRs on any CPU without
+ * a lock.  It stores records of up to @a slot_size bytes in a
+ * power-of-two number of fixed-size slots.  Each slot carries a
+ * sequence number: producers and consumers reserve slots with a
+ * single atomic_cas() on the write or read index, and publish or
+ * release them by updating that sequence number, so a context that
+ * is preempted between a claim and its finish never blocks other
+ * producers.  Records are read in the order they were claimed; a
+ * record claimed but not yet finished makes later records invisible
+ * to readers until it is finished.
+ */
+struct ring_buf_mp {
+	atomic_t wr;		/**< Next slot to claim for writing */
+	atomic_t rd;		/**< Next slot to claim for reading */
+	uint32_t mask;		/**< Number of slots minus one */
+	uint32_t slot_size;	/**< Maximum record size, in bytes */
+	uint32_t slot_words;	/**< Slot stride, in 32-bit words */
+	uint32_t *buf;		/**< Slot storage */
+};
+
+/**
+ * @brief Number of 32-bit words used by each slot of a ring_buf_mp
+ *
+ * @param slot_size Maximum record size, in bytes.
+ */
+#define RING_BUF_MP_SLOT_WORDS(slot_size) \
+	(2 + ceiling_fraction(slot_size, sizeof(uint32_t)))
+
+/**
+ * @brief Statically define and initialize a lock-free multi-producer
+ * ring buffer.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_mp <name>; @endcode
+ *
+ * @param name Name of the ring buffer.
+ * @param size8 Maximum size of a record (in bytes).
+ * @param pow Ring buffer size exponent: the ring holds 2^pow records.
+ */
+#define RING_BUF_MP_DECLARE(name, size8, pow) \
+	BUILD_ASSERT((1 << pow) < RING_BUFFER_MAX_SIZE,\
+		RING_BUFFER_SIZE_ASSERT_MSG); \
+	static uint32_t _ring_buf_mp_data_##name[BIT(pow) * \
+		RING_BUF_MP_SLOT_WORDS(size8)]; \
+	struct ring_buf_mp name = { \
+		.mask = BIT(pow) - 1, \
+		.slot_size = (size8), \
+		.slot_words = RING_BUF_MP_SLOT_WORDS(size8), \
+		.buf = _ring_buf_mp_data_##name \
+	}
+
+/**
+ * @brief Initialize a lock-free multi-producer ring buffer.
+ *
+ * This routine initializes a ring buffer prior to its first use. It is
+ * only used for ring buffers not defined using RING_BUF_MP_DECLARE.
+ *
+ * @param buf Address of ring buffer.
+ * @param slot_size Maximum size of a record (in bytes).
+ * @param slot_count Number of records, must be a power of 2.
+ * @param data Ring buffer data area, of
+ *	       slot_count * RING_BUF_MP_SLOT_WORDS(slot_size) 32-bit words.
+ */
+static inline void ring_buf_mp_init(struct ring_buf_mp *buf,
+				    uint32_t slot_size, uint32_t slot_count,
+				    uint32_t *data)
+{
+	__ASSERT(is_power_of_two(slot_count), "slot count not a power of 2");
+	__ASSERT(slot_count < RING_BUFFER_MAX_SIZE,
+		 RING_BUFFER_SIZE_ASSERT_MSG);
+
+	buf->mask = slot_count - 1U;
+	buf->slot_size = slot_size;
+	buf->slot_words = RING_BUF_MP_SLOT_WORDS(slot_size);
+	buf->buf = data;
+	memset(data, 0, slot_count * buf->slot_words * sizeof(uint32_t));
+	atomic_set(&buf->wr, 0);
+	atomic_set(&buf->rd, 0);
+}
+
+/**
+ * @brief Determine if a lock-free multi-producer ring buffer is empty.
+ *
+ * With concurrent users the result is only a snapshot. A claimed but
+ * unfinished record counts as present.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return true if no record is claimed or stored, false otherwise.
+ */
+static inline bool ring_buf_mp_is_empty(struct ring_buf_mp *buf)
+{
+	return atomic_get(&buf->wr) == atomic_get(&buf->rd);
+}
+
+/**
+ * @brief Claim a slot for writing a record to a multi-producer ring buffer.
+ *
+ * The record is written in place and published with
+ * @ref ring_buf_mp_put_finish. Can be called concurrently from any
+ * thread or ISR.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Set to the start of the claimed slot.
+ *
+ * @return Size of the claimed slot (in bytes), or 0 if the ring is full.
+ */
+uint32_t ring_buf_mp_put_claim(struct ring_buf_mp *buf, uint8_t **data);
+
+/**
+ * @brief Publish a record written to a claimed slot.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the slot returned by @ref ring_buf_mp_put_claim.
+ * @param size Size of the record (in bytes). Zero discards the claim,
+ *	       readers skip the slot.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the slot size. The claim is
+ *	   discarded as if @a size was zero.
+ */
+int ring_buf_mp_put_finish(struct ring_buf_mp *buf, uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Write (copy) a record to a multi-producer ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes), at most the slot size.
+ *
+ * @retval 0 Record was written.
+ * @retval -EMSGSIZE Ring buffer is full.
+ * @retval -EINVAL Provided @a size exceeds the slot size.
+ */
+int ring_buf_mp_put(struct ring_buf_mp *buf, const uint8_t *data,
+		    uint32_t size);
+
+/**
+ * @brief Claim the oldest record of a multi-producer ring buffer.
+ *
+ * The record is read in place and released with
+ * @ref ring_buf_mp_get_finish. Can be called concurrently from any
+ * thread or ISR.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Set to the start of the record.
+ *
+ * @return Size of the record (in bytes), or 0 if there is none or the
+ *	   oldest one is not finished yet.
+ */
+uint32_t ring_buf_mp_get_claim(struct ring_buf_mp *buf, uint8_t **data);
+
+/**
+ * @brief Release a record claimed for reading.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the record returned by @ref ring_buf_mp_get_claim.
+ */
+void ring_buf_mp_get_finish(struct ring_buf_mp *buf, uint8_t *data);
+
+/**
+ * @brief Read (copy) the oldest record of a multi-producer ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer.
+ * @param size Size of the output buffer (in bytes); a longer record is
+ *	       truncated.
+ *
+ * @return Size of the record read (in bytes), or 0 if there is none.
+ */
+uint32_t ring_buf_mp_get(struct ring_buf_mp *buf, uint8_t *data,
+			 uint32_t size);
+
 /**
  * @}
  */
@@ -54,6 +54,50 @@ struct sys_heap {
 	size_t init_bytes;
 };
 
+/** Number of bins of the allocation latency histograms */
+#define SYS_HEAP_LATENCY_BINS 16
+
+/** Maximum number of free list buckets of a heap */
+#define SYS_HEAP_MAX_BUCKETS 32
+
+/**
+ * @brief Runtime statistics of a sys_heap
+ *
+ * See sys_heap_runtime_stats_get().  Byte counts are in units of the
+ * heap chunks and include their headers.
+ */
+struct sys_heap_runtime_stats {
+	/** Memory in free blocks */
+	size_t free_bytes;
+	/** Memory in allocated blocks */
+	size_t allocated_bytes;
+	/** Peak of @a allocated_bytes */
+	size_t max_allocated_bytes;
+	/** Largest allocation that can currently succeed */
+	size_t largest_free_bytes;
+	/** Number of free blocks */
+	uint32_t free_blocks;
+	/** Fragmentation index, in percent: 0 when all free memory is
+	 * in a single block, approaching 100 when it is split into
+	 * many small blocks
+	 */
+	uint32_t fragmentation;
+	/** Number of valid entries in @a bucket_blocks */
+	uint32_t nb_buckets;
+	/** Number of free blocks in each free list bucket.  Bucket N
+	 * holds blocks of about 2^N to 2^(N+1) chunks of 8 bytes.
+	 */
+	uint32_t bucket_blocks[SYS_HEAP_MAX_BUCKETS];
+	/** Allocation latency histogram (with
+	 * CONFIG_SYS_HEAP_LATENCY_STATS): bin 0 counts calls taking
+	 * no measurable time, bin N those of 2^(N-1) to 2^N - 1
+	 * cycles, the last bin all slower ones
+	 */
+	uint32_t alloc_cycles[SYS_HEAP_LATENCY_BINS];
+	/** Free latency histogram, as @a alloc_cycles */
+	uint32_t free_cycles[SYS_HEAP_LATENCY_BINS];
+};
+
 struct z_heap_stress_result {
 	uint32_t total_allocs;
 	uint32_t successful_allocs;
@@ -120,6 +164,25 @@ void *sys_heap_aligned_alloc(struct sys_heap *h, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *h, void *mem);
 
+/** @brief Return allocated memory size
+ *
+ * Returns the size, in bytes, of a block returned from a successful
+ * sys_heap_alloc() or sys_heap_aligned_alloc() call.  The value
+ * returned is the size of the heap-managed memory, which may be
+ * larger than the number of bytes requested due to allocation
+ * granularity.  The heap code is guaranteed to make no access to this
+ * region of memory until a subsequent sys_heap_free() on the same
+ * pointer.
+ *
+ * @note Only the header of the block itself is read, which is not
+ * modified by other heap operations while the block is allocated.
+ *
+ * @param heap Heap containing the block
+ * @param mem Pointer to memory allocated from this heap
+ * @return Size in bytes of the memory region
+ */
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem);
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
@@ -149,6 +212,34 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 #define sys_heap_realloc(heap, ptr, bytes) \
 	sys_heap_aligned_realloc(heap, ptr, 0, bytes)
 
+/** @brief Get runtime statistics of a sys_heap
+ *
+ * Current and peak usage are maintained as the heap is used, at the
+ * cost of a few instructions per call.  The free block histogram,
+ * largest free block and fragmentation index are computed by this
+ * call by walking the free lists, in time linear in the number of
+ * free blocks.  Requires @option{CONFIG_SYS_HEAP_RUNTIME_STATS}.
+ *
+ * @note Like all sys_heap calls this must be serialized with other
+ * uses of the heap by the caller.
+ *
+ * @param heap Heap to query
+ * @param stats Filled with the statistics
+ * @return 0 on success, -EINVAL on invalid arguments
+ */
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_heap_runtime_stats *stats);
+
+/** @brief Reset the peak usage and latency histograms of a sys_heap
+ *
+ * The peak allocated size is set to the current one and the latency
+ * histograms are cleared.
+ *
+ * @param heap Heap to reset
+ * @return 0 on success, -EINVAL on invalid arguments
+ */
+int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
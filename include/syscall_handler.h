@@ -445,11 +445,33 @@ static inline int z_obj_validation_check(struct z_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/**
+ * Validate a kernel object for the current thread, using its object cache
+ *
+ * Same as z_obj_validation_check() on the result of z_object_find(), but
+ * objects the current thread was recently granted access to are neither
+ * looked up nor have their permissions checked again.
+ *
+ * @param obj Kernel object to validate
+ * @param otype Expected type of the kernel object, or K_OBJ_ANY
+ * @param init Expected initialization state of the kernel object
+ * @return See z_object_validate()
+ */
+int z_object_validate_cached(const void *obj, enum k_objects otype,
+			     enum _obj_init_check init);
+
+#define Z_SYSCALL_IS_OBJ(ptr, type, init) \
+	Z_SYSCALL_VERIFY_MSG(z_object_validate_cached(			\
+				     (const void *)ptr,			\
+				     type, init) == 0, "access denied")
+#else
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(			\
 				     z_object_find((const void *)ptr),	\
 				     (const void *)ptr,			\
 				     type, init) == 0, "access denied")
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
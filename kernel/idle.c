@@ -196,7 +196,24 @@ void idle(void *p1, void *unused2, void *unused3)
 		k_cpu_idle();
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
 
+#ifdef CONFIG_IDLE_WAKEUP_STATS
+		cpu->idle_wakeups++;
+#endif
+
 		IDLE_YIELD_IF_COOP();
 #endif /* SMP_FALLBACK */
 	}
 }
+
+#ifdef CONFIG_IDLE_WAKEUP_STATS
+uint32_t k_cpu_idle_wakeups_get(void)
+{
+	uint32_t n = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		n += _kernel.cpus[i].idle_wakeups;
+	}
+
+	return n;
+}
+#endif
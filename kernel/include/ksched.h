@@ -60,6 +60,7 @@ struct k_thread *z_find_first_thread_to_unpend(_wait_q_t *wait_q,
 void idle(void *a, void *b, void *c);
 void z_time_slice(int ticks);
 void z_reset_time_slice(void);
+void z_sched_cbs_tick(void);
 void z_sched_abort(struct k_thread *thread);
 void z_sched_ipi(void);
 void z_sched_start(struct k_thread *thread);
@@ -122,7 +123,8 @@ static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 	uint8_t state = thread->base.thread_state;
 
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
-			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
+			 _THREAD_DUMMY | _THREAD_SUSPENDED |
+			 _THREAD_THROTTLED)) != 0U;
 
 }
 
@@ -388,6 +388,21 @@ void z_backing_store_init(void);
  */
 unsigned long z_num_pagefaults_get(void);
 
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+struct k_thread;
+
+/**
+ * Number of page faults taken by a thread
+ *
+ * Counts the same page faults as z_num_pagefaults_get(), except those taken
+ * in interrupt context.
+ *
+ * @param thread Thread to query
+ * @return Number of successful page faults taken by the thread
+ */
+unsigned long z_num_pagefaults_thread_get(struct k_thread *thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+
 /**
  * Free a page frame physical address by evicting its contents
  *
@@ -8,11 +8,213 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <init.h>
+#include <string.h>
+
+#ifdef CONFIG_HEAP_CACHE
+
+/* The front-end cache holds free blocks of the heap, still marked as
+ * allocated in the sys_heap, in per-CPU magazines of size classes
+ * CACHE_UNIT bytes apart.  The magazines of a CPU are protected by their own
+ * spinlock, which is never held while taking the heap lock: spills
+ * to the heap are done after releasing it.  The heap lock may be
+ * held while taking a magazine lock (to flush the cache).
+ *
+ * A thread that fails an allocation flushes the cache before
+ * retrying or pending, and counts itself in h->waiters for the
+ * duration.  Frees bypass the cache while that count is nonzero, so
+ * that they go through the heap and wake the waiters.
+ */
+
+/* Classes are the sys_heap chunk unit apart, so rounding a request up
+ * to its class costs less than one chunk unit.
+ */
+#define CACHE_UNIT 8U
+#define CACHE_MAX_BYTES (CACHE_UNIT * CONFIG_HEAP_CACHE_CLASSES)
+#define CACHE_MAX_ALIGN 16U
+#define CACHE_SPILL (CONFIG_HEAP_CACHE_DEPTH / 2)
+
+static inline size_t class_bytes(int cls)
+{
+	return CACHE_UNIT * (cls + 1);
+}
+
+/* Size class serving an allocation, or -1 if not cacheable.  Blocks
+ * are only handed out of the cache if they happen to be aligned as
+ * requested; the "rewind" encoding of z_heap_aligned_alloc() is never
+ * cached.
+ */
+static int alloc_class(size_t align, size_t bytes)
+{
+	if ((align & (align - 1)) != 0U || align > CACHE_MAX_ALIGN ||
+	    bytes == 0U || bytes > CACHE_MAX_BYTES) {
+		return -1;
+	}
+
+	return (bytes - 1) / CACHE_UNIT;
+}
+
+/* Size class a freed block can be cached in, or -1: the largest class
+ * that fits in it, provided that is the class it was allocated for.
+ */
+static int free_class(struct k_heap *h, void *mem)
+{
+	size_t usable = sys_heap_usable_size(&h->heap, mem);
+	size_t cls = usable / CACHE_UNIT;
+
+	if (cls == 0U || cls > CONFIG_HEAP_CACHE_CLASSES) {
+		return -1;
+	}
+
+	return cls - 1;
+}
+
+/* The caller may migrate right after reading its CPU id: that only
+ * costs locality, the magazines are protected by their own lock.
+ */
+static inline struct z_heap_cache *curr_cache(struct k_heap *h)
+{
+#if CONFIG_MP_NUM_CPUS > 1
+	return &h->cache[arch_curr_cpu()->id];
+#else
+	return &h->cache[0];
+#endif
+}
+
+static void *cache_alloc(struct k_heap *h, int cls, size_t align)
+{
+	struct z_heap_cache *c = curr_cache(h);
+	struct z_heap_magazine *mag = &c->mags[cls];
+	void *ret = NULL;
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	if (mag->count > 0U &&
+	    ((uintptr_t)mag->blocks[mag->count - 1] & (align - 1)) == 0U) {
+		ret = mag->blocks[--mag->count];
+		c->stats.hits++;
+		c->stats.cached_blocks--;
+	} else {
+		c->stats.misses++;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	return ret;
+}
+
+/* Returns false if the block must be freed to the heap instead */
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	int cls = (mem == NULL) ? -1 : free_class(h, mem);
+	void *spill[CACHE_SPILL];
+	uint32_t nspill = 0U;
+
+	if (cls < 0) {
+		return false;
+	}
+
+	struct z_heap_cache *c = curr_cache(h);
+	struct z_heap_magazine *mag = &c->mags[cls];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	if (atomic_get(&h->waiters) != 0) {
+		k_spin_unlock(&c->lock, key);
+		return false;
+	}
+
+	if (mag->count == CONFIG_HEAP_CACHE_DEPTH) {
+		nspill = CACHE_SPILL;
+		mag->count -= nspill;
+		memcpy(spill, &mag->blocks[mag->count], sizeof(spill));
+		c->stats.spilled += nspill;
+		c->stats.cached_blocks -= nspill;
+	}
+	mag->blocks[mag->count++] = mem;
+	c->stats.cached_frees++;
+	c->stats.cached_blocks++;
+
+	k_spin_unlock(&c->lock, key);
+
+	if (nspill != 0U) {
+		key = k_spin_lock(&h->lock);
+		for (uint32_t i = 0; i < nspill; i++) {
+			sys_heap_free(&h->heap, spill[i]);
+		}
+		/* A thread may have started waiting since we checked */
+		if (z_unpend_all(&h->wait_q) != 0) {
+			z_reschedule(&h->lock, key);
+		} else {
+			k_spin_unlock(&h->lock, key);
+		}
+	}
+
+	return true;
+}
+
+/* Called with the heap lock held */
+static void cache_flush_locked(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cache *c = &h->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		for (int cls = 0; cls < CONFIG_HEAP_CACHE_CLASSES; cls++) {
+			struct z_heap_magazine *mag = &c->mags[cls];
+
+			while (mag->count > 0U) {
+				sys_heap_free(&h->heap,
+					      mag->blocks[--mag->count]);
+			}
+		}
+		c->stats.spilled += c->stats.cached_blocks;
+		c->stats.cached_blocks = 0U;
+		c->stats.flushes++;
+
+		k_spin_unlock(&c->lock, key);
+	}
+}
+
+void k_heap_cache_flush(struct k_heap *h)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	cache_flush_locked(h);
+
+	if (z_unpend_all(&h->wait_q) != 0) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+}
+
+void k_heap_cache_stats_get(struct k_heap *h,
+			    struct k_heap_cache_stats *stats)
+{
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_heap_cache *c = &h->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		stats->hits += c->stats.hits;
+		stats->misses += c->stats.misses;
+		stats->cached_frees += c->stats.cached_frees;
+		stats->spilled += c->stats.spilled;
+		stats->flushes += c->stats.flushes;
+		stats->cached_blocks += c->stats.cached_blocks;
+
+		k_spin_unlock(&c->lock, key);
+	}
+}
+
+#endif /* CONFIG_HEAP_CACHE */
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_HEAP_CACHE
+	(void)memset(h->cache, 0, sizeof(h->cache));
+	atomic_set(&h->waiters, 0);
+#endif
 }
 
 static int statics_init(const struct device *unused)
@@ -26,18 +228,63 @@ static int statics_init(const struct device *unused)
 
 SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *h,
+			     struct sys_heap_runtime_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	int ret = sys_heap_runtime_stats_get(&h->heap, stats);
+
+	k_spin_unlock(&h->lock, key);
+	return ret;
+}
+
+int k_heap_runtime_stats_reset_max(struct k_heap *h)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	int ret = sys_heap_runtime_stats_reset_max(&h->heap);
+
+	k_spin_unlock(&h->lock, key);
+	return ret;
+}
+#endif
+
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	int64_t now, end = z_timeout_end_calc(timeout);
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+#ifdef CONFIG_HEAP_CACHE
+	bool waiting = false;
+	int cls = alloc_class(align, bytes);
+
+	if (cls >= 0) {
+		ret = cache_alloc(h, cls, MAX(align, 1));
+		if (ret != NULL) {
+			return ret;
+		}
+		/* Round up so the block can be cached when freed */
+		bytes = class_bytes(cls);
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_HEAP_CACHE
+		if (ret == NULL && !waiting) {
+			waiting = true;
+			atomic_inc(&h->waiters);
+			cache_flush_locked(h);
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+#endif
+
 		now = z_tick_get();
 		if ((ret != NULL) || ((end - now) <= 0)) {
 			break;
@@ -48,12 +295,24 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_HEAP_CACHE
+	if (waiting) {
+		atomic_dec(&h->waiters);
+	}
+#endif
+
 	k_spin_unlock(&h->lock, key);
 	return ret;
 }
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_HEAP_CACHE
+	if (cache_free(h, mem)) {
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
@@ -14,6 +14,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 static struct k_spinlock lock;
 
@@ -21,6 +22,163 @@ static struct k_spinlock lock;
 struct k_mem_slab *_trace_list_k_mem_slab;
 #endif	/* CONFIG_OBJECT_TRACING */
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+
+/* Each slab has a per-CPU cache of free blocks, protected by its own
+ * spinlock, which serves allocations and frees without taking the
+ * slab lock.  Blocks move between the free list and a cache in
+ * batches of CACHE_BATCH: an allocation finding the cache empty
+ * refills it, and a free finding it full drains it, so that a CPU
+ * alternating between the two does not hit the slab lock every time.
+ * The slab lock is always taken before a cache lock, never after.
+ *
+ * Cached blocks count as used in slab->num_used, which only tracks
+ * the free list; k_mem_slab_num_used_get() subtracts them.
+ *
+ * A thread that finds the free list empty flushes all caches before
+ * failing or pending, and counts itself in slab->waiters for the
+ * duration.  Blocks do not enter caches while that count is nonzero,
+ * so that frees go through the free list and wake the waiters.
+ */
+
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CACHE_DEPTH / 2)
+
+/* The caller may migrate right after reading its CPU id: that only
+ * costs locality, the caches are protected by their own lock.
+ */
+static inline struct z_mem_slab_cache *curr_cache(struct k_mem_slab *slab)
+{
+#if CONFIG_MP_NUM_CPUS > 1
+	return &slab->cache[arch_curr_cpu()->id];
+#else
+	return &slab->cache[0];
+#endif
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_cache *c = curr_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool hit = c->count > 0U;
+
+	if (hit) {
+		*mem = c->blocks[--c->count];
+	}
+
+	k_spin_unlock(&c->lock, key);
+	return hit;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct z_mem_slab_cache *c = curr_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool cached = c->count < CONFIG_MEM_SLAB_CACHE_DEPTH &&
+		      atomic_get(&slab->waiters) == 0;
+
+	if (cached) {
+		c->blocks[c->count++] = mem;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	return cached;
+}
+
+/* Called with the slab lock held, after taking a block for the caller */
+static void cache_refill_locked(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cache *c = curr_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	if (atomic_get(&slab->waiters) == 0) {
+		uint32_t n = MIN(CACHE_BATCH,
+				 CONFIG_MEM_SLAB_CACHE_DEPTH - c->count);
+
+		while (n-- > 0U && slab->free_list != NULL) {
+			c->blocks[c->count++] = slab->free_list;
+			slab->free_list = *(char **)(slab->free_list);
+			slab->num_used++;
+		}
+	}
+
+	k_spin_unlock(&c->lock, key);
+}
+
+/* Called with the slab lock held.  Returns false if @a mem must be
+ * freed through the slow path instead.
+ */
+static bool cache_drain_locked(struct k_mem_slab *slab, void *mem)
+{
+	struct z_mem_slab_cache *c = curr_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool cached = atomic_get(&slab->waiters) == 0;
+
+	if (cached) {
+		while (c->count > CONFIG_MEM_SLAB_CACHE_DEPTH - CACHE_BATCH) {
+			char *p = c->blocks[--c->count];
+
+			*(char **)p = slab->free_list;
+			slab->free_list = p;
+			slab->num_used--;
+		}
+		c->blocks[c->count++] = mem;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	return cached;
+}
+
+/* Called with the slab lock held */
+static void cache_flush_locked(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_mem_slab_cache *c = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		while (c->count > 0U) {
+			char *p = c->blocks[--c->count];
+
+			*(char **)p = slab->free_list;
+			slab->free_list = p;
+			slab->num_used--;
+		}
+
+		k_spin_unlock(&c->lock, key);
+	}
+}
+
+void k_mem_slab_cache_flush(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Nobody can be pending: waiters flush before pending, and
+	 * blocks do not enter caches while they wait.
+	 */
+	cache_flush_locked(slab);
+
+	k_spin_unlock(&lock, key);
+}
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t used = slab->num_used;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_mem_slab_cache *c = &slab->cache[i];
+		k_spinlock_key_t ckey = k_spin_lock(&c->lock);
+
+		used -= c->count;
+
+		k_spin_unlock(&c->lock, ckey);
+	}
+
+	k_spin_unlock(&lock, key);
+	return used;
+}
+
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -92,6 +250,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->max_used = 0U;
 #endif
+#ifdef CONFIG_MEM_SLAB_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+	atomic_set(&slab->waiters, 0);
+#endif
 
 	rc = create_free_list(slab);
 	if (rc < 0) {
@@ -108,9 +270,27 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	bool waiting = false;
+
+	if (cache_alloc(slab, mem)) {
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (slab->free_list == NULL) {
+		waiting = true;
+		atomic_inc(&slab->waiters);
+		cache_flush_locked(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -120,6 +300,11 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->max_used = MAX(slab->num_used, slab->max_used);
 #endif
+#ifdef CONFIG_MEM_SLAB_CACHE
+		if (!waiting) {
+			cache_refill_locked(slab);
+		}
+#endif
 
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -132,9 +317,17 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		if (result == 0) {
 			*mem = _current->base.swap_data;
 		}
+#ifdef CONFIG_MEM_SLAB_CACHE
+		atomic_dec(&slab->waiters);
+#endif
 		return result;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (waiting) {
+		atomic_dec(&slab->waiters);
+	}
+#endif
 	k_spin_unlock(&lock, key);
 
 	return result;
@@ -142,7 +335,22 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (cache_free(slab, *mem)) {
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (cache_drain_locked(slab, *mem)) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+#endif
 
 	if (slab->free_list == NULL) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
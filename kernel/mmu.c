@@ -944,17 +944,75 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#if CONFIG_DEMAND_PAGING_READAHEAD_PAGES > 0
+/* Page fault address which would continue a sequential access pattern */
+static void *readahead_next;
+
+/* Page in the data pages following addr, returns the number of pages the
+ * sequential access pattern got ahead by
+ */
+static size_t do_readahead(void *addr)
+{
+	size_t i;
+
+	for (i = 1; i <= CONFIG_DEMAND_PAGING_READAHEAD_PAGES; i++) {
+		uint8_t *pos = (uint8_t *)addr + (i * CONFIG_MMU_PAGE_SIZE);
+
+		if (pos >= (uint8_t *)Z_VIRT_RAM_END - Z_VM_RESERVED ||
+		    !do_page_fault(pos, false)) {
+			/* End of the address space or of the mapping */
+			break;
+		}
+	}
+
+	return i;
+}
+
+static void do_mem_unpin(void *addr);
+
+static bool page_fault_readahead(void *addr)
+{
+	bool sequential, ret;
+	size_t ahead = 1;
+
+	addr = (void *)ROUND_DOWN(addr, CONFIG_MMU_PAGE_SIZE);
+	/* Not worth lengthening ISRs for */
+	sequential = addr == readahead_next && !k_is_in_isr();
+
+	/* Pin the faulting data page so that it can't be evicted to make
+	 * room for the read-ahead ones before it is accessed.
+	 */
+	ret = do_page_fault(addr, sequential);
+	if (ret && sequential) {
+		ahead = do_readahead(addr);
+		do_mem_unpin(addr);
+	}
+	readahead_next = (uint8_t *)addr + (ahead * CONFIG_MMU_PAGE_SIZE);
+
+	return ret;
+}
+#endif /* CONFIG_DEMAND_PAGING_READAHEAD_PAGES > 0 */
+
 bool z_page_fault(void *addr)
 {
 	bool ret;
 
+#if CONFIG_DEMAND_PAGING_READAHEAD_PAGES > 0
+	ret = page_fault_readahead(addr);
+#else
 	ret = do_page_fault(addr, false);
+#endif
 	if (ret) {
 		/* Wasn't an error, increment page fault count */
 		int key;
 
 		key = irq_lock();
 		z_num_pagefaults++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+		if (!k_is_in_isr()) {
+			_current->pagefaults++;
+		}
+#endif
 		irq_unlock(key);
 	}
 	return ret;
@@ -972,6 +1030,20 @@ unsigned long z_num_pagefaults_get(void)
 	return ret;
 }
 
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+unsigned long z_num_pagefaults_thread_get(struct k_thread *thread)
+{
+	unsigned long ret;
+	int key;
+
+	key = irq_lock();
+	ret = thread->pagefaults;
+	irq_unlock(key);
+
+	return ret;
+}
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+
 static void do_mem_unpin(void *addr)
 {
 	struct z_page_frame *pf;
@@ -57,8 +57,13 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
+	msgq->claims = 0;
 	z_waitq_init(&msgq->wait_q);
+	z_waitq_init(&msgq->claim_wait_q);
 	msgq->lock = (struct k_spinlock) {};
+#ifdef CONFIG_POLL
+	sys_dlist_init(&msgq->poll_events);
+#endif
 
 	SYS_TRACING_OBJ_INIT(k_msgq, msgq);
 
@@ -101,7 +106,8 @@ int z_vrfy_k_msgq_alloc_init(struct k_msgq *q, size_t msg_size,
 
 int k_msgq_cleanup(struct k_msgq *msgq)
 {
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL ||
+		z_waitq_head(&msgq->claim_wait_q) != NULL) {
 		return -EBUSY;
 	}
 
@@ -113,45 +119,189 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+static inline void handle_poll_events(struct k_msgq *msgq)
+{
+#ifdef CONFIG_POLL
+	z_handle_obj_poll_events(&msgq->poll_events,
+				 K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#else
+	ARG_UNUSED(msgq);
+#endif
+}
+
+static inline void msgq_write_advance(struct k_msgq *msgq)
+{
+	msgq->write_ptr += msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs++;
+}
+
+static inline void msgq_read_advance(struct k_msgq *msgq)
+{
+	msgq->read_ptr += msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs--;
+}
+
+static inline void msgq_thread_ready(struct k_thread *thread, int value)
+{
+	arch_thread_return_value_set(thread, value);
+	z_ready_thread(thread);
+}
+
+/*
+ * Threads pended in k_msgq_put_claim() or k_msgq_get_claim() have a NULL
+ * swap_data; when a slot or message becomes available they are handed its
+ * address there instead of having data copied for them.
+ *
+ * Threads finding their direction claimed wait on claim_wait_q rather than
+ * wait_q, which thus only ever holds senders or only receivers. They are
+ * woken with MSGQ_RETRY when the claim is finished, and start over. Granting
+ * a claim to a thread of wait_q sends the threads queued behind it back to
+ * start over the same way.
+ */
+
+#define MSGQ_RETRY 1
+
+/* Wake the threads of @a wait_q to start over */
+static void msgq_retry_all(_wait_q_t *wait_q)
+{
+	struct k_thread *thread;
+
+	while ((thread = z_unpend_first_thread(wait_q)) != NULL) {
+		msgq_thread_ready(thread, MSGQ_RETRY);
+	}
+}
+
+/* Pend the current thread on @a wait_q until @a end. Returns MSGQ_RETRY
+ * with the lock taken again, or the result of the wait with it released.
+ */
+static int msgq_wait(struct k_msgq *msgq, k_spinlock_key_t *key,
+		     _wait_q_t *wait_q, k_timeout_t timeout, int64_t end)
+{
+	int ret;
+
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		int64_t now = z_tick_get();
+
+		if ((end - now) <= 0) {
+			k_spin_unlock(&msgq->lock, *key);
+			return -EAGAIN;
+		}
+		timeout = K_TICKS(end - now);
+	}
+
+	ret = z_pend_curr(&msgq->lock, *key, wait_q, timeout);
+	if (ret == MSGQ_RETRY) {
+		*key = k_spin_lock(&msgq->lock);
+	}
+
+	return ret;
+}
+
+/* Hand the message at @a data to a waiting receiver */
+static void msgq_deliver(struct k_msgq *msgq, struct k_thread *receiver,
+			 const void *data)
+{
+	if (receiver->base.swap_data != NULL) {
+		(void)memcpy(receiver->base.swap_data, data, msgq->msg_size);
+	} else {
+		if (data != msgq->write_ptr) {
+			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+		}
+		msgq_write_advance(msgq);
+		msgq->claims |= K_MSGQ_CLAIM_GET;
+		receiver->base.swap_data = msgq->read_ptr;
+
+		/* remaining receivers now wait for the claim */
+		msgq_retry_all(&msgq->wait_q);
+	}
+	msgq_thread_ready(receiver, 0);
+}
+
+/* Let waiting senders use the slot(s) freed by a receiver */
+static void msgq_refill(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+
+	while (msgq->used_msgs < msgq->max_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		if (pending_thread->base.swap_data == NULL) {
+			msgq->claims |= K_MSGQ_CLAIM_PUT;
+			pending_thread->base.swap_data = msgq->write_ptr;
+			msgq_thread_ready(pending_thread, 0);
+
+			/* remaining senders now wait for the claim */
+			msgq_retry_all(&msgq->wait_q);
+			break;
+		}
+
+		/* add thread's message to queue */
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+		       msgq->msg_size);
+		msgq_write_advance(msgq);
+
+		/* wake up waiting thread */
+		msgq_thread_ready(pending_thread, 0);
+	}
+}
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	struct k_thread *pending_thread;
+	int64_t end = z_timeout_end_calc(timeout);
 	k_spinlock_key_t key;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+retry:
+	if ((msgq->claims & K_MSGQ_CLAIM_PUT) != 0U &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* wait for the claimed slot to be committed */
+		result = msgq_wait(msgq, &key, &msgq->claim_wait_q, timeout,
+				   end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		return result;
+	} else if ((msgq->claims & K_MSGQ_CLAIM_PUT) != 0U) {
+		result = -ENOMSG;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (pending_thread != NULL) {
 			/* give message to waiting thread */
-			(void)memcpy(pending_thread->base.swap_data, data,
-			       msgq->msg_size);
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
-			z_reschedule(&msgq->lock, key);
-			return 0;
+			msgq_deliver(msgq, pending_thread, data);
 		} else {
 			/* put message in queue */
 			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
+			msgq_write_advance(msgq);
+			handle_poll_events(msgq);
 		}
-		result = 0;
+		z_reschedule(&msgq->lock, key);
+		return 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for message space to become available */
 		result = -ENOMSG;
 	} else {
 		/* wait for put message success, failure, or timeout */
 		_current->base.swap_data = (void *) data;
-		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = msgq_wait(msgq, &key, &msgq->wait_q, timeout, end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		return result;
 	}
 
 	k_spin_unlock(&msgq->lock, key);
@@ -193,47 +343,44 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+	int64_t end = z_timeout_end_calc(timeout);
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs > 0) {
+retry:
+	if ((msgq->claims & K_MSGQ_CLAIM_GET) != 0U &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* wait for the claimed message to be released */
+		result = msgq_wait(msgq, &key, &msgq->claim_wait_q, timeout,
+				   end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		return result;
+	} else if ((msgq->claims & K_MSGQ_CLAIM_GET) != 0U) {
+		result = -ENOMSG;
+	} else if (msgq->used_msgs > 0) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
-		msgq->used_msgs--;
+		msgq_read_advance(msgq);
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
-			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
-			z_reschedule(&msgq->lock, key);
-			return 0;
-		}
-		result = 0;
+		msgq_refill(msgq);
+		z_reschedule(&msgq->lock, key);
+		return 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
 		result = -ENOMSG;
 	} else {
 		/* wait for get message success or timeout */
 		_current->base.swap_data = data;
-		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = msgq_wait(msgq, &key, &msgq->wait_q, timeout, end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		return result;
 	}
 
 	k_spin_unlock(&msgq->lock, key);
@@ -300,10 +447,210 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	/* a claimed message is gone, a claimed slot stays reserved */
+	if ((msgq->claims & K_MSGQ_CLAIM_GET) != 0U) {
+		msgq->claims &= ~K_MSGQ_CLAIM_GET;
+		msgq_retry_all(&msgq->claim_wait_q);
+	}
 
 	z_reschedule(&msgq->lock, key);
 }
 
+int z_impl_k_msgq_put_claim(struct k_msgq *msgq, void **slot,
+			    k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+retry:
+	if ((msgq->claims & K_MSGQ_CLAIM_PUT) != 0U &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = msgq_wait(msgq, &key, &msgq->claim_wait_q, timeout,
+				   end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		return result;
+	} else if ((msgq->claims & K_MSGQ_CLAIM_PUT) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
+		/* no thread can be waiting to receive into a claimed slot */
+		msgq->claims |= K_MSGQ_CLAIM_PUT;
+		*slot = msgq->write_ptr;
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = -ENOMSG;
+	} else {
+		_current->base.swap_data = NULL;
+		result = msgq_wait(msgq, &key, &msgq->wait_q, timeout, end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		if (result == 0) {
+			*slot = _current->base.swap_data;
+		}
+		return result;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_claim(struct k_msgq *q, void **slot,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(slot, sizeof(*slot)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(q->buffer_start,
+				      q->buffer_end - q->buffer_start));
+
+	return z_impl_k_msgq_put_claim(q, slot, timeout);
+}
+#include <syscalls/k_msgq_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_put_commit(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->claims & K_MSGQ_CLAIM_PUT) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->claims &= ~K_MSGQ_CLAIM_PUT;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		msgq_deliver(msgq, pending_thread, msgq->write_ptr);
+	} else {
+		msgq_write_advance(msgq);
+		handle_poll_events(msgq);
+	}
+
+	/* let the threads held back by the claim start over */
+	msgq_retry_all(&msgq->claim_wait_q);
+
+	z_reschedule(&msgq->lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_commit(struct k_msgq *q)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_put_commit(q);
+}
+#include <syscalls/k_msgq_put_commit_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_claim(struct k_msgq *msgq, void **msg,
+			    k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+retry:
+	if ((msgq->claims & K_MSGQ_CLAIM_GET) != 0U &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = msgq_wait(msgq, &key, &msgq->claim_wait_q, timeout,
+				   end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		return result;
+	} else if ((msgq->claims & K_MSGQ_CLAIM_GET) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0) {
+		msgq->claims |= K_MSGQ_CLAIM_GET;
+		*msg = msgq->read_ptr;
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = -ENOMSG;
+	} else {
+		_current->base.swap_data = NULL;
+		result = msgq_wait(msgq, &key, &msgq->wait_q, timeout, end);
+		if (result == MSGQ_RETRY) {
+			goto retry;
+		}
+		if (result == 0) {
+			*msg = _current->base.swap_data;
+		}
+		return result;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_claim(struct k_msgq *q, void **msg,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(msg, sizeof(*msg)));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(q->buffer_start,
+				     q->buffer_end - q->buffer_start));
+
+	return z_impl_k_msgq_get_claim(q, msg, timeout);
+}
+#include <syscalls/k_msgq_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_release(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->claims & K_MSGQ_CLAIM_GET) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->claims &= ~K_MSGQ_CLAIM_GET;
+
+	msgq_read_advance(msgq);
+
+	/* handle first thread waiting to write (if any) */
+	msgq_refill(msgq);
+
+	/* let the threads held back by the claim start over */
+	msgq_retry_all(&msgq->claim_wait_q);
+
+	z_reschedule(&msgq->lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_release(struct k_msgq *q)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_get_release(q);
+}
+#include <syscalls/k_msgq_get_release_mrsh.c>
+#endif
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_msgq_purge(struct k_msgq *q)
 {
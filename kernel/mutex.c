@@ -116,6 +116,88 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_SPIN
+static bool thread_running(struct k_thread *thread)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (_kernel.cpus[i].current == thread) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Called with the lock held when the mutex is owned by another thread.
+ * While that thread runs on another CPU and nobody is pending on the
+ * mutex, spin with the lock released for at most CONFIG_MUTEX_SPIN_USEC
+ * and within @a timeout, which is updated to the time left.
+ *
+ * The owner's priority is not boosted while spinning: it is running
+ * already.  Should it stop running, the caller pends and boosts it.
+ *
+ * Returns with the lock held, true if the mutex was released.
+ */
+static bool spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key,
+			  k_timeout_t *timeout)
+{
+	volatile struct k_mutex *m = mutex;
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_SPIN_USEC);
+	uint32_t start, elapsed;
+	struct k_thread *owner;
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
+		    Z_TICK_ABS(timeout->ticks) >= 0) {
+			return false;
+		}
+		budget = MIN(budget, k_ticks_to_cyc_floor32(timeout->ticks));
+	}
+
+	if (budget == 0U || z_waitq_head(&mutex->wait_q) != NULL ||
+	    !thread_running(mutex->owner)) {
+		return false;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	start = k_cycle_get_32();
+	do {
+		owner = m->owner;
+		if (m->lock_count == 0U || owner == NULL ||
+		    !thread_running(owner)) {
+			break;
+		}
+		elapsed = k_cycle_get_32() - start;
+	} while (elapsed < budget);
+
+	*key = k_spin_lock(&lock);
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		int64_t left = timeout->ticks -
+			k_cyc_to_ticks_ceil32(k_cycle_get_32() - start);
+
+		*timeout = (left > 0) ? K_TICKS(left) : K_NO_WAIT;
+	}
+
+	return mutex->lock_count == 0U;
+}
+#endif /* CONFIG_MUTEX_SPIN */
+
+static inline void mutex_take(struct k_mutex *mutex)
+{
+	mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+				_current->base.prio :
+				mutex->owner_orig_prio;
+
+	mutex->lock_count++;
+	mutex->owner = _current;
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		mutex->owner_orig_prio);
+}
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -128,29 +210,35 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	key = k_spin_lock(&lock);
 
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+		mutex_take(mutex);
+		k_spin_unlock(&lock, key);
+		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
 
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
-
-		mutex->lock_count++;
-		mutex->owner = _current;
+		return 0;
+	}
 
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		k_spin_unlock(&lock, key);
+		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
+		return -EBUSY;
+	}
 
+#ifdef CONFIG_MUTEX_SPIN
+	if (spin_on_owner(mutex, &key, &timeout)) {
+		mutex_take(mutex);
 		k_spin_unlock(&lock, key);
 		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
 
 		return 0;
 	}
 
-	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* timed out while spinning, no priority was changed */
 		k_spin_unlock(&lock, key);
 		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
-		return -EBUSY;
+		return -EAGAIN;
 	}
+#endif
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
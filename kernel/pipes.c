@@ -131,6 +131,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -444,6 +446,18 @@ int z_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->put_claimed != 0) {
+		/* claimed space must be committed first */
+		k_spin_unlock(&pipe->lock, key);
+#if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
+		if (async_desc != NULL) {
+			pipe_async_free(async_desc);
+		}
+#endif
+		*bytes_written = 0;
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -600,6 +614,13 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->get_claimed != 0) {
+		/* claimed data must be released first */
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -785,6 +806,8 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 	struct k_pipe_async  *async_desc;
 	size_t                dummy_bytes_written;
 
+	__ASSERT(pipe->put_claimed == 0, "pipe has claimed space");
+
 	/* For simplicity, always allocate an asynchronous descriptor */
 	pipe_async_alloc(&async_desc);
 
@@ -802,6 +825,304 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 }
 #endif
 
+/**
+ * @brief Wait until a pipe claim may be attempted again
+ *
+ * The current thread pends as a zero-length reader or writer. The regular
+ * transfer paths treat such a request as satisfied, and so ready it, as
+ * soon as they move data through the pipe.
+ *
+ * @return 0 to retry the claim, -EIO or -EAGAIN to give up
+ */
+static int pipe_claim_pend(struct k_pipe *pipe, k_spinlock_key_t *key,
+			   _wait_q_t *wait_q, k_timeout_t timeout, int64_t end)
+{
+	struct k_pipe_desc pipe_desc = {
+		.buffer = NULL,
+		.bytes_to_xfer = 0,
+	};
+	int64_t now;
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EIO;
+	}
+
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		now = z_tick_get();
+		if ((end - now) <= 0) {
+			return -EAGAIN;
+		}
+		timeout = K_TICKS(end - now);
+	}
+
+	_current->base.swap_data = &pipe_desc;
+	(void)z_pend_curr(&pipe->lock, *key, wait_q, timeout);
+	*key = k_spin_lock(&pipe->lock);
+
+	return 0;
+}
+
+int z_impl_k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	int64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	size_t run_length;
+	int ret;
+
+	if (pipe->buffer == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		if (pipe->put_claimed != 0) {
+			ret = -EBUSY;
+			break;
+		}
+
+		run_length = MIN(pipe->size - pipe->bytes_used,
+				 pipe->size - pipe->write_index);
+		if (run_length > 0) {
+			pipe->put_claimed = run_length;
+			*data = pipe->buffer + pipe->write_index;
+			*size = run_length;
+			ret = 0;
+			break;
+		}
+
+		ret = pipe_claim_pend(pipe, &key, &pipe->wait_q.writers,
+				      timeout, end);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(size, sizeof(*size)));
+	if (pipe->buffer != NULL) {
+		Z_OOPS(Z_SYSCALL_MEMORY_WRITE(pipe->buffer, pipe->size));
+	}
+
+	return z_impl_k_pipe_put_claim(pipe, data, size, timeout);
+}
+#include <syscalls/k_pipe_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_put_commit(struct k_pipe *pipe, size_t bytes)
+{
+	struct k_thread    *reader;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->put_claimed == 0) || (bytes > pipe->put_claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += bytes;
+	pipe->write_index += bytes;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty pipe; hand them the committed data
+	 * the same way k_pipe_put() hands them data from its source buffer.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				pipe->bytes_used, pipe->bytes_used,
+				0, K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	struct k_thread *thread = (struct k_thread *)
+				  sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		/* The thread's read request has been satisfied. Ready it. */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_commit(struct k_pipe *pipe, size_t bytes)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_put_commit(pipe, bytes);
+}
+#include <syscalls/k_pipe_put_commit_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	int64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	size_t run_length;
+	int ret;
+
+	if (pipe->buffer == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		if (pipe->get_claimed != 0) {
+			ret = -EBUSY;
+			break;
+		}
+
+		run_length = MIN(pipe->bytes_used,
+				 pipe->size - pipe->read_index);
+		if (run_length > 0) {
+			pipe->get_claimed = run_length;
+			*data = pipe->buffer + pipe->read_index;
+			*size = run_length;
+			ret = 0;
+			break;
+		}
+
+		ret = pipe_claim_pend(pipe, &key, &pipe->wait_q.readers,
+				      timeout, end);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(size, sizeof(*size)));
+	if (pipe->buffer != NULL) {
+		Z_OOPS(Z_SYSCALL_MEMORY_READ(pipe->buffer, pipe->size));
+	}
+
+	return z_impl_k_pipe_get_claim(pipe, data, size, timeout);
+}
+#include <syscalls/k_pipe_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_release(struct k_pipe *pipe, size_t bytes)
+{
+	struct k_thread    *writer;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->get_claimed == 0) || (bytes > pipe->get_claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= bytes;
+	pipe->read_index += bytes;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full pipe; move their data into the space
+	 * just freed the same way k_pipe_get() does.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				pipe->size - pipe->bytes_used,
+				pipe->size - pipe->bytes_used,
+				0, K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	struct k_thread *thread = (struct k_thread *)
+				  sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+
+		/* Write request has been satisfied */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_release(struct k_pipe *pipe, size_t bytes)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_get_release(pipe, bytes);
+}
+#include <syscalls/k_pipe_get_release_mrsh.c>
+#endif
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -34,10 +34,12 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
-static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_triggered_work(struct k_poll_event *event, uint32_t status,
+				 struct k_work_poll **submit);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -67,11 +69,33 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+		/* Make appends signal events, before checking: this one may
+		 * be registered next
+		 */
+		atomic_or(&event->queue->flags, Z_QUEUE_POLLED);
+#endif
 		if (!k_queue_is_empty(event->queue)) {
 			*state = K_POLL_STATE_FIFO_DATA_AVAILABLE;
 			return true;
 		}
 		break;
+	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+		if (event->msgq->used_msgs > 0) {
+			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
+			return true;
+		}
+		break;
+	case K_POLL_TYPE_RWLOCK_AVAILABLE:
+		/* Make unlocks take the slow path, which signals events,
+		 * before checking: this one may be registered next
+		 */
+		if ((atomic_or(&event->rwlock->state, Z_RWLOCK_POLLED) &
+		     (Z_RWLOCK_WRITER | Z_RWLOCK_READERS)) == 0) {
+			*state = K_POLL_STATE_RWLOCK_AVAILABLE;
+			return true;
+		}
+		break;
 	case K_POLL_TYPE_SIGNAL:
 		if (event->signal->signaled != 0U) {
 			*state = K_POLL_STATE_SIGNALED;
@@ -93,6 +117,22 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Pollers that aren't threads (triggered work, poll sets) have no
+ * priority of their own and are queued behind all polling threads.
+ */
+static inline bool poller_higher_prio(struct z_poller *p1,
+				      struct z_poller *p2)
+{
+	if (p1->mode != MODE_POLL) {
+		return false;
+	}
+	if (p2->mode != MODE_POLL) {
+		return true;
+	}
+	return z_is_t1_higher_prio_than_t2(poller_thread(p1),
+					   poller_thread(p2));
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
@@ -100,15 +140,13 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-	    z_is_t1_higher_prio_than_t2(poller_thread(pending->poller),
-					poller_thread(poller))) {
+	    !poller_higher_prio(poller, pending->poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_is_t1_higher_prio_than_t2(poller_thread(poller),
-					poller_thread(pending->poller))) {
+		if (poller_higher_prio(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -130,6 +168,14 @@ static inline void register_event(struct k_poll_event *event,
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		add_event(&event->queue->poll_events, event, poller);
 		break;
+	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+		add_event(&event->msgq->poll_events, event, poller);
+		break;
+	case K_POLL_TYPE_RWLOCK_AVAILABLE:
+		__ASSERT(event->rwlock != NULL, "invalid reader-writer lock\n");
+		add_event(&event->rwlock->poll_events, event, poller);
+		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		add_event(&event->signal->poll_events, event, poller);
@@ -161,6 +207,14 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		remove = true;
 		break;
+	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+		remove = true;
+		break;
+	case K_POLL_TYPE_RWLOCK_AVAILABLE:
+		__ASSERT(event->rwlock != NULL, "invalid reader-writer lock\n");
+		remove = true;
+		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		remove = true;
@@ -175,6 +229,17 @@ static inline void clear_event_registration(struct k_poll_event *event)
 	if (remove && sys_dnode_is_linked(&event->_node)) {
 		sys_dlist_remove(&event->_node);
 	}
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	/* Let appends take the fast path again once nothing polls */
+	if (event->type == K_POLL_TYPE_DATA_AVAILABLE &&
+	    sys_dlist_is_empty(&event->queue->poll_events)) {
+		atomic_and(&event->queue->flags, (atomic_val_t)~Z_QUEUE_POLLED);
+	}
+#endif
+	if (event->type == K_POLL_TYPE_RWLOCK_AVAILABLE &&
+	    sys_dlist_is_empty(&event->rwlock->poll_events)) {
+		atomic_and(&event->rwlock->state, (atomic_val_t)~Z_RWLOCK_POLLED);
+	}
 }
 
 /* must be called with interrupts locked */
@@ -362,6 +427,12 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		case K_POLL_TYPE_DATA_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->queue, K_OBJ_QUEUE));
 			break;
+		case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+			Z_OOPS(Z_SYSCALL_OBJ(e->msgq, K_OBJ_MSGQ));
+			break;
+		case K_POLL_TYPE_RWLOCK_AVAILABLE:
+			Z_OOPS(Z_SYSCALL_OBJ(e->rwlock, K_OBJ_RWLOCK));
+			break;
 		default:
 			ret = -EINVAL;
 			goto out_free;
@@ -381,17 +452,26 @@ oops_free:
 #include <syscalls/k_poll_mrsh.c>
 #endif
 
-/* must be called with interrupts locked */
-static int signal_poll_event(struct k_poll_event *event, uint32_t state)
+/* Must be called with the poll lock held.  Triggered work to be
+ * submitted is returned in @a submit, for the caller to pass to
+ * submit_triggered_work() once it has released the lock: submitting
+ * work signals the poll events of the work queue.
+ */
+static int signal_poll_event(struct k_poll_event *event, uint32_t state,
+			     struct k_work_poll **submit)
 {
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
 	if (poller) {
+		if (poller->mode == MODE_SET) {
+			return signal_poll_set(event, state);
+		}
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
-			retcode = signal_triggered_work(event, state);
+			retcode = signal_triggered_work(event, state, submit);
 		}
 
 		poller->is_polling = false;
@@ -405,14 +485,59 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	return retcode;
 }
 
+static void submit_triggered_work(struct k_work_poll *twork)
+{
+	if (twork != NULL) {
+		k_work_submit_to_queue(twork->workq, &twork->work);
+	}
+}
+
+/*
+ * Takes the poll lock, under which pollers check the object and register
+ * their events, so that an event cannot be registered right after the
+ * object was found unavailable but missed by this call.
+ */
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_poll *twork = NULL;
 	struct k_poll_event *poll_event;
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
-		(void) signal_poll_event(poll_event, state);
+		(void) signal_poll_event(poll_event, state, &twork);
 	}
+
+	k_spin_unlock(&lock, key);
+	submit_triggered_work(twork);
+}
+
+/*
+ * For objects which become available to all pollers at once. The poll
+ * lock also lets @a polled be cleared from @a flags once no event is
+ * left: is_condition_met() sets it again under the same lock before an
+ * event is registered.
+ */
+void z_handle_obj_poll_events_all(sys_dlist_t *events, uint32_t state,
+				  atomic_t *flags, atomic_val_t polled)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_poll_event *poll_event;
+
+	while ((poll_event = (struct k_poll_event *)sys_dlist_get(events)) !=
+	       NULL) {
+		struct k_work_poll *twork = NULL;
+
+		(void) signal_poll_event(poll_event, state, &twork);
+		if (twork != NULL) {
+			k_spin_unlock(&lock, key);
+			submit_triggered_work(twork);
+			key = k_spin_lock(&lock);
+		}
+	}
+	atomic_and(flags, ~polled);
+
+	k_spin_unlock(&lock, key);
 }
 
 void z_impl_k_poll_signal_init(struct k_poll_signal *signal)
@@ -454,6 +579,7 @@ void z_vrfy_k_poll_signal_check(struct k_poll_signal *signal,
 int z_impl_k_poll_signal_raise(struct k_poll_signal *signal, int result)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_poll *twork = NULL;
 	struct k_poll_event *poll_event;
 
 	signal->result = result;
@@ -465,7 +591,13 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *signal, int result)
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED, &twork);
+
+	if (twork != NULL) {
+		k_spin_unlock(&lock, key);
+		submit_triggered_work(twork);
+		key = k_spin_lock(&lock);
+	}
 
 	z_reschedule(&lock, key);
 	return rc;
@@ -522,18 +654,17 @@ static void triggered_work_expiration_handler(struct _timeout *timeout)
 	k_work_submit_to_queue(twork->workq, &twork->work);
 }
 
-static int signal_triggered_work(struct k_poll_event *event, uint32_t status)
+static int signal_triggered_work(struct k_poll_event *event, uint32_t status,
+				 struct k_work_poll **submit)
 {
 	struct z_poller *poller = event->poller;
 	struct k_work_poll *twork =
 		CONTAINER_OF(poller, struct k_work_poll, poller);
 
 	if (poller->is_polling && twork->workq != NULL) {
-		struct k_work_q *work_q = twork->workq;
-
 		z_abort_timeout(&twork->timeout);
 		twork->poll_result = 0;
-		k_work_submit_to_queue(work_q, &twork->work);
+		*submit = twork;
 	}
 
 	return 0;
@@ -692,3 +823,154 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* Poll sets.  Events stay owned by the set (event->poller points to
+ * the set's poller) for as long as they are in it.  An event's node
+ * is either linked on its object's poll_events list, waiting to be
+ * signaled, or on the set's ready list: the object unlinks it when it
+ * signals, and the set rearms it once its condition no longer holds.
+ */
+
+static inline struct k_poll_set *poll_set(struct z_poller *poller)
+{
+	return CONTAINER_OF(poller, struct k_poll_set, poller);
+}
+
+/* must be called with the poll lock held */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = poll_set(event->poller);
+	struct k_thread *thread;
+
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+	int ret = 0;
+
+	if (event->poller != NULL) {
+		ret = -EBUSY;
+	} else if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		event->state = state;
+		sys_dlist_append(&set->ready, &event->_node);
+	} else {
+		event->state = K_POLL_STATE_NOT_READY;
+		register_event(event, &set->poller);
+	}
+
+	k_spin_unlock(&lock, key);
+	return ret;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret = -EINVAL;
+
+	if (event->poller == &set->poller) {
+		clear_event_registration(event);
+		/* Left on the ready list if its type isn't registered */
+		if (sys_dnode_is_linked(&event->_node)) {
+			sys_dlist_remove(&event->_node);
+		}
+		ret = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+	return ret;
+}
+
+/* Checks the events on the ready list, must be called with the lock
+ * held.  Those still ready are returned and go back to the end of the
+ * list to be checked again next time, the others are rearmed.
+ * Cancelled events are returned once and not rearmed.
+ */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **ready, int max_ready)
+{
+	sys_dlist_t again;
+	sys_dnode_t *node;
+	int n = 0;
+
+	sys_dlist_init(&again);
+
+	while (n < max_ready && (node = sys_dlist_get(&set->ready)) != NULL) {
+		struct k_poll_event *event =
+			CONTAINER_OF(node, struct k_poll_event, _node);
+		uint32_t state = K_POLL_STATE_NOT_READY;
+
+		if ((event->state & K_POLL_STATE_CANCELLED) != 0U) {
+			/* Reported once, then left off both lists */
+			ready[n++] = event;
+		} else if (is_condition_met(event, &state)) {
+			event->state = state;
+			ready[n++] = event;
+			sys_dlist_append(&again, node);
+		} else {
+			event->state = K_POLL_STATE_NOT_READY;
+			register_event(event, &set->poller);
+		}
+	}
+
+	while ((node = sys_dlist_get(&again)) != NULL) {
+		sys_dlist_append(&set->ready, node);
+	}
+
+	return n;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout)
+{
+	int64_t now, end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(max_ready > 0, "no room for ready events\n");
+
+	key = k_spin_lock(&lock);
+
+	while (true) {
+		ret = poll_set_collect(set, ready, max_ready);
+		if (ret > 0) {
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if ((end - now) <= 0) {
+				ret = -EAGAIN;
+				break;
+			}
+			timeout = K_TICKS(end - now);
+		}
+
+		(void) z_pend_curr(&lock, key, &set->wait_q, timeout);
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+	return ret;
+}
@@ -81,6 +81,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
 	z_waitq_init(&queue->wait_q);
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	atomic_ptr_clear(&queue->pending);
+	atomic_clear(&queue->flags);
+#endif
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
@@ -111,6 +115,126 @@ static inline void handle_poll_events(struct k_queue *queue, uint32_t state)
 #endif
 }
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+/*
+ * Appends push items onto queue->pending, a stack linked through the first
+ * word of the items, with a compare-and-swap. Everything else happens
+ * under the queue lock and starts by moving the pending items, in order,
+ * to the tail of data_q. A thread about to wait, and k_poll() about to
+ * poll, set a flag before looking at the queue one last time, and appends
+ * look at the flags after pushing, so that either the item is seen or the
+ * append takes the lock to hand it over.
+ */
+
+/* Called with the queue lock held */
+static void queue_drain(struct k_queue *queue)
+{
+	void *node = atomic_ptr_clear(&queue->pending);
+	void *head = NULL, *tail = node, *next;
+
+	if (node == NULL) {
+		return;
+	}
+
+	while (node != NULL) {
+		next = *(void **)node;
+		*(void **)node = head;
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+}
+
+void z_queue_drain(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	queue_drain(queue);
+	k_spin_unlock(&queue->lock, key);
+}
+
+/* Called with the queue lock held: move pending items to data_q and hand
+ * them over to waiting threads, oldest first. Returns true if items are
+ * left over.
+ */
+static bool queue_drain_to_waiters(struct k_queue *queue)
+{
+	struct k_thread *thread;
+	sys_sfnode_t *node;
+
+	queue_drain(queue);
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread == NULL) {
+			return true;
+		}
+		node = sys_sflist_get_not_empty(&queue->data_q);
+		prepare_thread_to_run(thread, z_queue_node_peek(node, true));
+	}
+
+	if (z_waitq_head(&queue->wait_q) == NULL) {
+		atomic_and(&queue->flags, (atomic_val_t)~Z_QUEUE_WAITERS);
+	}
+
+	return false;
+}
+
+/* Hand appended items over to waiting threads and pollers */
+static void queue_wake(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	if (queue_drain_to_waiters(queue)) {
+		handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+	}
+
+	z_reschedule(&queue->lock, key);
+}
+
+/* Push items linked newest first, from @a newest to @a oldest */
+static void queue_push(struct k_queue *queue, void *newest, void *oldest)
+{
+	void *top;
+
+	do {
+		top = atomic_ptr_get(&queue->pending);
+		*(void **)oldest = top;
+	} while (!atomic_ptr_cas(&queue->pending, top, newest));
+
+	if (unlikely(atomic_get(&queue->flags) != 0)) {
+		queue_wake(queue);
+	}
+}
+#else
+static inline void queue_drain(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline bool queue_drain_to_waiters(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+	return false;
+}
+#endif /* CONFIG_QUEUE_LOCKLESS_APPEND */
+
+/* Called with the queue lock held */
+static bool queue_has_data(struct k_queue *queue, bool will_wait)
+{
+	queue_drain(queue);
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	if (will_wait && sys_sflist_is_empty(&queue->data_q)) {
+		atomic_or(&queue->flags, Z_QUEUE_WAITERS);
+		queue_drain(queue);
+	}
+#else
+	ARG_UNUSED(will_wait);
+#endif
+	return !sys_sflist_is_empty(&queue->data_q);
+}
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
@@ -141,6 +265,8 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 	struct k_thread *first_pending_thread;
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
+	/* Earlier appends first */
+	(void)queue_drain_to_waiters(queue);
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
@@ -181,7 +307,11 @@ void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 
 void k_queue_append(struct k_queue *queue, void *data)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	queue_push(queue, data, data);
+#else
 	(void)queue_insert(queue, NULL, data, false, true);
+#endif
 }
 
 void k_queue_prepend(struct k_queue *queue, void *data)
@@ -227,6 +357,20 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	void *node = head, *prev = NULL, *next;
+
+	/* Relink the items newest first and push them all at once */
+	while (node != NULL) {
+		next = *(void **)node;
+		*(void **)node = prev;
+		prev = node;
+		node = next;
+	}
+	queue_push(queue, tail, head);
+
+	return 0;
+#else
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
@@ -247,6 +391,7 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
 	z_reschedule(&queue->lock, key);
 	return 0;
+#endif
 }
 
 int k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list)
@@ -281,7 +426,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
 
-	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
+	if (likely(queue_has_data(queue,
+				  !K_TIMEOUT_EQ(timeout, K_NO_WAIT)))) {
 		sys_sfnode_t *node;
 
 		node = sys_sflist_get_not_empty(&queue->data_q);
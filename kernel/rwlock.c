@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief reader-writer lock kernel services
+ *
+ * The state of a lock is a single atomic word holding the number of
+ * readers and a writer flag, so that uncontended read locks and unlocks
+ * are a compare-and-swap each and never take the spinlock. Once a thread
+ * has to wait, Z_RWLOCK_WAITERS is set and all operations go through the
+ * slow path under the spinlock, which hands the lock over to the waiters
+ * when it is released. Z_RWLOCK_POLLED likewise routes unlocks through the
+ * slow path while k_poll() may be waiting for the lock.
+ *
+ * Writers are preferred: readers wait while a writer waits, and a lock
+ * released by its last holder goes to the first waiting writer before any
+ * waiting reader. The writer holding a lock inherits the priority of the
+ * highest priority waiter, as with mutexes. Readers are not tracked and do
+ * not inherit priorities.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <syscall_handler.h>
+#include <sys/check.h>
+
+static struct k_spinlock lock;
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	atomic_set(&rwlock->state, 0);
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+	rwlock->writer = NULL;
+	rwlock->writer_orig_prio = K_LOWEST_THREAD_PRIO;
+#ifdef CONFIG_POLL
+	sys_dlist_init(&rwlock->poll_events);
+#endif
+	z_object_init(rwlock);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock);
+}
+#include <syscalls/k_rwlock_init_mrsh.c>
+#endif
+
+/* Take a read lock unless any of @a busy is set */
+static inline bool read_trylock(struct k_rwlock *rwlock, atomic_val_t busy)
+{
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(&rwlock->state);
+		if ((old & busy) != 0) {
+			return false;
+		}
+	} while (!atomic_cas(&rwlock->state, old, old + 1));
+
+	return true;
+}
+
+static struct k_thread *top_waiter(struct k_rwlock *rwlock)
+{
+	struct k_thread *reader = z_waitq_head(&rwlock->rd_wait_q);
+	struct k_thread *writer = z_waitq_head(&rwlock->wr_wait_q);
+
+	if (reader == NULL ||
+	    (writer != NULL && !z_is_prio_higher(reader->base.prio,
+						 writer->base.prio))) {
+		return writer;
+	}
+	return reader;
+}
+
+/* Called with the lock held: set the writer's priority to the highest of
+ * its own and those of the waiters (and of @a thread, about to wait)
+ */
+static void writer_prio_update(struct k_rwlock *rwlock,
+			       struct k_thread *thread)
+{
+	struct k_thread *top = top_waiter(rwlock);
+	int new_prio = rwlock->writer_orig_prio;
+
+	if (rwlock->writer == NULL) {
+		return;
+	}
+
+	if (top != NULL && z_is_prio_higher(top->base.prio, new_prio)) {
+		new_prio = top->base.prio;
+	}
+	if (thread != NULL && z_is_prio_higher(thread->base.prio, new_prio)) {
+		new_prio = thread->base.prio;
+	}
+	new_prio = z_get_new_prio_with_ceiling(new_prio);
+
+	if (rwlock->writer->base.prio != new_prio) {
+		(void)z_set_prio(rwlock->writer, new_prio);
+	}
+}
+
+static void grant_write(struct k_rwlock *rwlock, struct k_thread *thread)
+{
+	atomic_or(&rwlock->state, Z_RWLOCK_WRITER);
+	rwlock->writer = thread;
+	rwlock->writer_orig_prio = thread->base.prio;
+}
+
+/* Called with the lock held after the lock was released or a waiter gave
+ * up: hand the lock over to whoever can take it now.
+ */
+static void wake_waiters(struct k_rwlock *rwlock)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+	struct k_thread *thread;
+
+	if ((state & Z_RWLOCK_WRITER) != 0) {
+		return;
+	}
+
+	thread = z_waitq_head(&rwlock->wr_wait_q);
+	if (thread != NULL) {
+		/* Readers fail their fast path while a writer waits, so
+		 * the count cannot change under us
+		 */
+		if ((state & Z_RWLOCK_READERS) != 0) {
+			return;
+		}
+		z_unpend_thread(thread);
+		grant_write(rwlock, thread);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		writer_prio_update(rwlock, NULL);
+	} else {
+		while ((thread = z_unpend_first_thread(&rwlock->rd_wait_q)) !=
+		       NULL) {
+			atomic_inc(&rwlock->state);
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+		}
+	}
+
+	if (z_waitq_head(&rwlock->rd_wait_q) == NULL &&
+	    z_waitq_head(&rwlock->wr_wait_q) == NULL) {
+		atomic_and(&rwlock->state, (atomic_val_t)~Z_RWLOCK_WAITERS);
+	}
+
+#ifdef CONFIG_POLL
+	state = atomic_get(&rwlock->state);
+	if ((state & Z_RWLOCK_POLLED) != 0 &&
+	    (state & (Z_RWLOCK_WRITER | Z_RWLOCK_READERS)) == 0) {
+		z_handle_obj_poll_events_all(&rwlock->poll_events,
+					     K_POLL_STATE_RWLOCK_AVAILABLE,
+					     &rwlock->state, Z_RWLOCK_POLLED);
+	}
+#endif
+}
+
+/* Called after giving up waiting for the lock */
+static int wait_timed_out(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	wake_waiters(rwlock);
+	writer_prio_update(rwlock, NULL);
+	z_reschedule(&lock, key);
+
+	return -EAGAIN;
+}
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+
+	if (likely(read_trylock(rwlock, Z_RWLOCK_WRITER | Z_RWLOCK_WAITERS))) {
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		if (z_waitq_head(&rwlock->wr_wait_q) == NULL &&
+		    read_trylock(rwlock, Z_RWLOCK_WRITER)) {
+			k_spin_unlock(&lock, key);
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		}
+
+		/* Re-check after making releases take the slow path */
+		state = atomic_or(&rwlock->state, Z_RWLOCK_WAITERS);
+		if ((state & Z_RWLOCK_WAITERS) != 0) {
+			break;
+		}
+	}
+
+	writer_prio_update(rwlock, _current);
+
+	if (z_pend_curr(&lock, key, &rwlock->rd_wait_q, timeout) == 0) {
+		/* wake_waiters() counted us as a reader */
+		return 0;
+	}
+
+	return wait_timed_out(rwlock);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_read_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(&rwlock->state);
+
+		CHECKIF((old & Z_RWLOCK_READERS) == 0 ||
+			(old & Z_RWLOCK_WRITER) != 0) {
+			return -EINVAL;
+		}
+
+		if ((old & (Z_RWLOCK_WAITERS | Z_RWLOCK_POLLED)) != 0) {
+			break;
+		}
+	} while (!atomic_cas(&rwlock->state, old, old - 1));
+
+	if ((old & (Z_RWLOCK_WAITERS | Z_RWLOCK_POLLED)) == 0) {
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	old = atomic_dec(&rwlock->state);
+	if ((old & Z_RWLOCK_READERS) == 1) {
+		wake_waiters(rwlock);
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+
+	__ASSERT(!arch_is_in_isr(), "reader-writer locks cannot be "
+		 "write locked in ISRs");
+
+	key = k_spin_lock(&lock);
+
+	if (unlikely(rwlock->writer == _current)) {
+		k_spin_unlock(&lock, key);
+		return -EDEADLK;
+	}
+
+	for (;;) {
+		state = atomic_get(&rwlock->state);
+
+		if ((state & (Z_RWLOCK_WRITER | Z_RWLOCK_READERS)) == 0) {
+			if (atomic_cas(&rwlock->state, state,
+				       state | Z_RWLOCK_WRITER)) {
+				rwlock->writer = _current;
+				rwlock->writer_orig_prio = _current->base.prio;
+				k_spin_unlock(&lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		}
+
+		/* Re-check after making releases take the slow path */
+		state = atomic_or(&rwlock->state, Z_RWLOCK_WAITERS);
+		if ((state & Z_RWLOCK_WAITERS) != 0) {
+			break;
+		}
+	}
+
+	writer_prio_update(rwlock, _current);
+
+	if (z_pend_curr(&lock, key, &rwlock->wr_wait_q, timeout) == 0) {
+		/* wake_waiters() made us the writer */
+		return 0;
+	}
+
+	return wait_timed_out(rwlock);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_write_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "reader-writer locks cannot be "
+		 "write unlocked in ISRs");
+
+	CHECKIF(rwlock->writer != _current) {
+		return -EPERM;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (_current->base.prio != rwlock->writer_orig_prio) {
+		(void)z_set_prio(_current, rwlock->writer_orig_prio);
+	}
+	rwlock->writer = NULL;
+	atomic_and(&rwlock->state, (atomic_val_t)~Z_RWLOCK_WRITER);
+
+	wake_waiters(rwlock);
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif
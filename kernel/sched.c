@@ -416,6 +416,196 @@ void z_time_slice(int ticks)
 }
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+/* Constant bandwidth servers.  The budget of the thread a CPU runs is
+ * charged, in cycles, each time the CPU picks a thread and on each timer
+ * announcement, and the timer is programmed to fire when the budget runs
+ * out as is done for time slices.  Throttled threads are made runnable
+ * again by their own timeout.
+ */
+
+/* Sum of the shares of all threads, in 1/65536 of a CPU */
+static uint32_t cbs_bandwidth;
+
+#define CBS_MAX_BANDWIDTH \
+	((uint32_t)(((uint64_t)CONFIG_SCHED_CBS_MAX_UTILIZATION << 16) / 100U))
+
+static void ready_thread(struct k_thread *thread);
+
+static inline bool has_cbs(struct k_thread *thread)
+{
+	return thread->base.cbs.budget != 0U;
+}
+
+static void cbs_replenish(struct _timeout *timeout)
+{
+	struct k_thread *thread = CONTAINER_OF(timeout, struct k_thread,
+					       base.cbs.timeout);
+
+	LOCKED(&sched_spinlock) {
+		if (has_cbs(thread)) {
+			thread->base.cbs.remaining = thread->base.cbs.budget;
+			thread->base.prio_deadline += thread->base.cbs.period;
+		}
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+		ready_thread(thread);
+	}
+}
+
+/* Called when a thread becomes runnable: start a new period unless the
+ * budget left would not take the thread over its share until the
+ * current deadline, i.e. unless remaining / left < budget / period.
+ */
+static void cbs_wakeup(struct k_thread *thread)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	uint32_t now = k_cycle_get_32();
+	int32_t left = (int32_t)((uint32_t)thread->base.prio_deadline - now);
+
+	if (left <= 0 ||
+	    (uint64_t)MAX(cbs->remaining, 0) * cbs->period >=
+	    (uint64_t)left * cbs->budget) {
+		cbs->remaining = cbs->budget;
+		thread->base.prio_deadline = now + cbs->period;
+	}
+}
+
+/* Called once @a thread has used up its budget.  It is throttled until
+ * its deadline, unless that has already passed, in which case the
+ * deadline is simply postponed by a period.
+ */
+static void cbs_throttle(struct k_thread *thread, uint32_t now)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	int32_t left = (int32_t)((uint32_t)thread->base.prio_deadline - now);
+	uint32_t overrun = (uint32_t)-cbs->remaining;
+
+	cbs->stats.overruns++;
+	if (overrun > cbs->stats.max_overrun_cycles) {
+		cbs->stats.max_overrun_cycles = overrun;
+	}
+
+	if (left <= 0) {
+		cbs->remaining = cbs->budget;
+		thread->base.prio_deadline = now + cbs->period;
+		if (z_is_thread_queued(thread)) {
+			dequeue_thread(&_kernel.ready_q.runq, thread);
+			queue_thread(&_kernel.ready_q.runq, thread);
+		}
+		return;
+	}
+
+	cbs->stats.throttles++;
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(&_kernel.ready_q.runq, thread);
+	}
+	thread->base.thread_state |= _THREAD_THROTTLED;
+	z_add_timeout(&cbs->timeout, cbs_replenish,
+		      K_TICKS(k_cyc_to_ticks_ceil32(left)));
+}
+
+/* Charge the thread this CPU runs for the time since it was last
+ * charged.  Called with sched_spinlock held.
+ */
+static void cbs_charge(void)
+{
+	struct _cpu *cpu = _current_cpu;
+	struct k_thread *thread = cpu->cbs_thread;
+	uint32_t now, used;
+
+	if (thread == NULL) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+	used = now - cpu->cbs_start;
+	cpu->cbs_start = now;
+
+	thread->base.cbs.remaining -= (int32_t)MIN(used, (uint32_t)INT32_MAX);
+	if (thread->base.cbs.remaining <= 0) {
+		cbs_throttle(thread, now);
+		if ((thread->base.thread_state & _THREAD_THROTTLED) != 0U) {
+			cpu->cbs_thread = NULL;
+			cpu->cbs_ticks = 0;
+		}
+	}
+}
+
+/* Program the timer to fire when the budget of the thread runs out */
+static void cbs_arm(struct _cpu *cpu, struct k_thread *thread)
+{
+	int ticks = MAX((int)k_cyc_to_ticks_ceil32(thread->base.cbs.remaining),
+			1);
+
+	cpu->cbs_ticks = ticks + z_clock_elapsed();
+	z_set_timeout_expiry(ticks, false);
+}
+
+/* Called with sched_spinlock held, right after cbs_charge(), once the
+ * CPU has picked @a thread to run
+ */
+static void cbs_switch(struct k_thread *thread)
+{
+	struct _cpu *cpu = _current_cpu;
+
+	if (thread == cpu->cbs_thread) {
+		return;
+	}
+
+	if (has_cbs(thread)) {
+		cpu->cbs_thread = thread;
+		cpu->cbs_start = k_cycle_get_32();
+		cbs_arm(cpu, thread);
+	} else {
+		cpu->cbs_thread = NULL;
+		cpu->cbs_ticks = 0;
+	}
+}
+
+/* Called with sched_spinlock held: forget the budget of @a thread */
+static void cbs_release(struct k_thread *thread)
+{
+	unsigned int i;
+
+	(void)z_abort_timeout(&thread->base.cbs.timeout);
+	cbs_bandwidth -= thread->base.cbs.bandwidth;
+	thread->base.cbs.bandwidth = 0U;
+	thread->base.cbs.budget = 0U;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (_kernel.cpus[i].cbs_thread == thread) {
+			_kernel.cpus[i].cbs_thread = NULL;
+			_kernel.cpus[i].cbs_ticks = 0;
+		}
+	}
+}
+
+/* Called out of each timer interrupt */
+void z_sched_cbs_tick(void)
+{
+	LOCKED(&sched_spinlock) {
+		struct _cpu *cpu = _current_cpu;
+
+		if (cpu->cbs_thread != NULL) {
+			cbs_charge();
+			if (cpu->cbs_thread != NULL) {
+				cbs_arm(cpu, cpu->cbs_thread);
+			}
+			update_cache(0);
+		}
+	}
+}
+#else
+static inline void cbs_charge(void)
+{
+}
+
+static inline void cbs_switch(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif
+
 /* Track cooperative threads preempted by metairqs so we can return to
  * them specifically.  Called at the moment a new thread has been
  * selected to run.
@@ -437,6 +627,8 @@ static void update_metairq_preempt(struct k_thread *thread)
 static void update_cache(int preempt_ok)
 {
 #ifndef CONFIG_SMP
+	cbs_charge();
+
 	struct k_thread *thread = next_up();
 
 	if (should_preempt(thread, preempt_ok)) {
@@ -450,6 +642,7 @@ static void update_cache(int preempt_ok)
 	} else {
 		_kernel.ready_q.cache = _current;
 	}
+	cbs_switch(_kernel.ready_q.cache);
 
 #else
 	/* The way this works is that the CPU record keeps its
@@ -473,6 +666,11 @@ static void ready_thread(struct k_thread *thread)
 	 */
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		sys_trace_thread_ready(thread);
+#ifdef CONFIG_SCHED_CBS
+		if (has_cbs(thread)) {
+			cbs_wakeup(thread);
+		}
+#endif
 		queue_thread(&_kernel.ready_q.runq, thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
@@ -627,6 +825,10 @@ void z_thread_single_abort(struct k_thread *thread)
 			ready_thread(waiter);
 		}
 
+#ifdef CONFIG_SCHED_CBS
+		cbs_release(thread);
+#endif
+
 		if (z_is_idle_thread_object(_current)) {
 			update_cache(1);
 		}
@@ -968,7 +1170,9 @@ struct k_thread *z_get_next_ready_thread(void)
 	struct k_thread *ret = 0;
 
 	LOCKED(&sched_spinlock) {
+		cbs_charge();
 		ret = next_up();
+		cbs_switch(ret);
 	}
 
 	return ret;
@@ -996,7 +1200,9 @@ void *z_get_next_switch_handle(void *interrupted)
 		if (IS_ENABLED(CONFIG_SMP)) {
 			old_thread->switch_handle = NULL;
 		}
+		cbs_charge();
 		new_thread = next_up();
+		cbs_switch(new_thread);
 
 		if (old_thread != new_thread) {
 			update_metairq_preempt(new_thread);
@@ -1156,17 +1362,19 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 }
 
 #ifdef CONFIG_SCHED_MULTIQ
-# if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
-# error Too many priorities for multiqueue scheduler (max 32)
+# if PRIQ_BITMAP_SIZE > 32
+# error Too many priorities for multiqueue scheduler (max 1024)
 # endif
 #endif
 
 ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 {
-	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int priority = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int word = priority / 32;
 
-	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
-	pq->bitmask |= BIT(priority_bit);
+	sys_dlist_append(&pq->queues[priority], &thread->base.qnode_dlist);
+	pq->bitmask[word] |= BIT(priority % 32);
+	pq->summary |= BIT(word);
 }
 
 ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
@@ -1177,23 +1385,28 @@ ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread
 		return;
 	}
 #endif
-	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int priority = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	int word = priority / 32;
 
 	sys_dlist_remove(&thread->base.qnode_dlist);
-	if (sys_dlist_is_empty(&pq->queues[priority_bit])) {
-		pq->bitmask &= ~BIT(priority_bit);
+	if (sys_dlist_is_empty(&pq->queues[priority])) {
+		pq->bitmask[word] &= ~BIT(priority % 32);
+		if (pq->bitmask[word] == 0U) {
+			pq->summary &= ~BIT(word);
+		}
 	}
 }
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 {
-	if (!pq->bitmask) {
+	if (!pq->summary) {
 		return NULL;
 	}
 
 	struct k_thread *thread = NULL;
-	sys_dlist_t *l = &pq->queues[__builtin_ctz(pq->bitmask)];
-	sys_dnode_t *n = sys_dlist_peek_head(l);
+	int word = __builtin_ctz(pq->summary);
+	int priority = word * 32 + __builtin_ctz(pq->bitmask[word]);
+	sys_dnode_t *n = sys_dlist_peek_head(&pq->queues[priority]);
 
 	if (n != NULL) {
 		thread = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
@@ -1312,6 +1525,112 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 }
 #include <syscalls/k_thread_deadline_set_mrsh.c>
 #endif
+
+#ifdef CONFIG_SCHED_CBS
+/* Called with sched_spinlock held */
+static void cbs_set(struct k_thread *thread, uint32_t budget, uint32_t period,
+		    uint32_t bandwidth)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+
+	cbs_bandwidth += bandwidth - cbs->bandwidth;
+	cbs->bandwidth = bandwidth;
+	cbs->budget = budget;
+	cbs->period = period;
+	cbs->remaining = budget;
+	thread->base.prio_deadline = k_cycle_get_32() + period;
+
+	if ((thread->base.thread_state & _THREAD_THROTTLED) != 0U) {
+		(void)z_abort_timeout(&cbs->timeout);
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+		ready_thread(thread);
+	} else if (z_is_thread_queued(thread)) {
+		dequeue_thread(&_kernel.ready_q.runq, thread);
+		queue_thread(&_kernel.ready_q.runq, thread);
+	}
+
+	if (thread == _current) {
+		_current_cpu->cbs_thread = thread;
+		_current_cpu->cbs_start = k_cycle_get_32();
+		cbs_arm(_current_cpu, thread);
+	}
+}
+
+int k_thread_cbs_set(k_tid_t tid, uint32_t budget_us, uint32_t period_us)
+{
+	struct k_thread *thread = tid;
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	uint32_t budget, period, bandwidth;
+	int ret = 0;
+
+	if (budget_us == 0U) {
+		LOCKED(&sched_spinlock) {
+			cbs_release(thread);
+			if ((thread->base.thread_state & _THREAD_THROTTLED) != 0U) {
+				thread->base.thread_state &= ~_THREAD_THROTTLED;
+				ready_thread(thread);
+			}
+		}
+		return 0;
+	}
+
+	if (period_us == 0U || budget_us > period_us) {
+		return -EINVAL;
+	}
+
+	budget = (uint32_t)k_us_to_cyc_ceil64(budget_us);
+	period = (uint32_t)k_us_to_cyc_ceil64(period_us);
+	if (period > (uint32_t)INT32_MAX) {
+		return -EINVAL;
+	}
+	bandwidth = MAX((uint32_t)(((uint64_t)budget << 16) / period), 1U);
+
+	LOCKED(&sched_spinlock) {
+		if (cbs_bandwidth - cbs->bandwidth + bandwidth >
+		    CBS_MAX_BANDWIDTH) {
+			ret = -EBUSY;
+		} else {
+			cbs_set(thread, budget, period, bandwidth);
+		}
+	}
+
+	return ret;
+}
+
+int z_impl_k_thread_cbs_stats_get(k_tid_t tid,
+				  struct k_thread_cbs_stats *stats)
+{
+	struct k_thread *thread = tid;
+	int ret = -EINVAL;
+
+	LOCKED(&sched_spinlock) {
+		if (has_cbs(thread)) {
+			*stats = thread->base.cbs.stats;
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cbs_stats_get(k_tid_t tid,
+					struct k_thread_cbs_stats *stats)
+{
+	struct k_thread_cbs_stats kstats;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_OBJ(tid, K_OBJ_THREAD));
+	ret = z_impl_k_thread_cbs_stats_get(tid, &kstats);
+	if (ret == 0) {
+		Z_OOPS(z_user_to_copy(stats, &kstats, sizeof(kstats)));
+	}
+
+	return ret;
+}
+#include <syscalls/k_thread_cbs_stats_get_mrsh.c>
+#endif
+#endif /* CONFIG_SCHED_CBS */
 #endif
 
 void z_impl_k_yield(void)
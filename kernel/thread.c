@@ -309,6 +309,9 @@ const char *k_thread_state_str(k_tid_t thread_id)
 	case _THREAD_ABORTING:
 		return "aborting";
 		break;
+	case _THREAD_THROTTLED:
+		return "throttled";
+		break;
 	case _THREAD_QUEUED:
 		return "queued";
 		break;
@@ -557,6 +560,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
 	new_thread->syscall_frame = NULL;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	(void)memset(&new_thread->obj_cache, 0, sizeof(new_thread->obj_cache));
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -641,6 +647,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #ifdef CONFIG_THREAD_RUNTIME_STATS
 	memset(&new_thread->rt_stats, 0, sizeof(new_thread->rt_stats));
 #endif
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	new_thread->pagefaults = 0;
+#endif
 
 	return stack_ptr;
 }
@@ -822,6 +831,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
+
+#ifdef CONFIG_SCHED_CBS
+	thread_base->cbs = (struct _thread_cbs) {};
+	z_init_timeout(&thread_base->cbs.timeout);
+#endif
 }
 
 FUNC_NORETURN void k_thread_user_mode_enter(k_thread_entry_t entry,
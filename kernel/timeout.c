@@ -11,6 +11,7 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
+#include <sys/math_extras.h>
 
 #define LOCKED(lck) for (k_spinlock_key_t __i = {},			\
 					  __key = k_spin_lock(lck);	\
@@ -19,7 +20,9 @@
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -41,6 +44,215 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_BITS CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK ((uint64_t)WHEEL_SLOTS - 1U)
+#define WHEEL_NONE UINT64_MAX
+
+/* Hierarchical timing wheel, keyed by absolute expiry tick (stored
+ * in dticks).  A timeout expiring at tick E lives at the lowest level
+ * L for which E and the wheel base only differ in bits below
+ * WHEEL_BITS * (L + 1), in slot (E >> (WHEEL_BITS * L)) & WHEEL_MASK,
+ * or on the overflow list if there is no such level.
+ *
+ * So a level 0 slot holds timeouts expiring at exactly one tick, and
+ * every occupied slot of a level lies after the base's own slot in
+ * that level.  The earliest timeout is thus in the first occupied
+ * slot of the lowest occupied level.  When the base enters a new slot
+ * of a higher level, that slot's timeouts are redistributed to the
+ * lower levels ("cascaded").
+ */
+static struct {
+	/* Tick the wheel is positioned at, follows curr_tick */
+	uint64_t base;
+
+	/* Cached earliest expiry, recomputed when next_valid is false */
+	uint64_t next;
+	bool next_valid;
+
+	/* Bit N of occupied[L] is set if slots[L][N] is non-empty.
+	 * Empty slots are left uninitialized until first used.
+	 */
+	uint64_t occupied[WHEEL_LEVELS];
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	sys_dlist_t overflow;
+} wheel = {
+	.overflow = SYS_DLIST_STATIC_INIT(&wheel.overflow),
+};
+
+/* Returns the list holding (or that would hold) a timeout expiring
+ * at @expiry, setting *level and *slot.  *level is WHEEL_LEVELS for
+ * the overflow list.
+ */
+static sys_dlist_t *wheel_list(uint64_t expiry, int *level, int *slot)
+{
+	uint64_t diff = expiry ^ wheel.base;
+	int l = diff == 0U ? 0
+		: (63 - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+
+	if (l >= WHEEL_LEVELS) {
+		*level = WHEEL_LEVELS;
+		*slot = 0;
+		return &wheel.overflow;
+	}
+
+	*level = l;
+	*slot = (expiry >> (l * WHEEL_BITS)) & WHEEL_MASK;
+	return &wheel.slots[l][*slot];
+}
+
+static void wheel_place(struct _timeout *t)
+{
+	int level, slot;
+	sys_dlist_t *list = wheel_list(t->dticks, &level, &slot);
+
+	if (level < WHEEL_LEVELS &&
+	    (wheel.occupied[level] & BIT64(slot)) == 0U) {
+		sys_dlist_init(list);
+		wheel.occupied[level] |= BIT64(slot);
+	}
+	sys_dlist_append(list, &t->node);
+}
+
+static uint64_t list_min(sys_dlist_t *list)
+{
+	uint64_t min = WHEEL_NONE;
+	struct _timeout *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		min = MIN(min, (uint64_t)t->dticks);
+	}
+	return min;
+}
+
+static uint64_t wheel_next(void)
+{
+	if (wheel.next_valid) {
+		return wheel.next;
+	}
+
+	wheel.next = WHEEL_NONE;
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel.occupied[l] != 0U) {
+			int slot = u64_count_trailing_zeros(wheel.occupied[l]);
+
+			wheel.next = (l == 0)
+				? ((wheel.base & ~WHEEL_MASK) | slot)
+				: list_min(&wheel.slots[l][slot]);
+			break;
+		}
+	}
+
+	if (wheel.next == WHEEL_NONE) {
+		wheel.next = list_min(&wheel.overflow);
+	}
+
+	wheel.next_valid = true;
+	return wheel.next;
+}
+
+static void wheel_add(struct _timeout *t)
+{
+	uint64_t next = wheel_next();
+
+	wheel_place(t);
+	wheel.next = MIN(next, (uint64_t)t->dticks);
+}
+
+static void wheel_remove(struct _timeout *t)
+{
+	int level, slot;
+	sys_dlist_t *list = wheel_list(t->dticks, &level, &slot);
+
+	sys_dlist_remove(&t->node);
+	if (level < WHEEL_LEVELS && sys_dlist_is_empty(list)) {
+		wheel.occupied[level] &= ~BIT64(slot);
+	}
+
+	if ((uint64_t)t->dticks == wheel.next) {
+		wheel.next_valid = false;
+	}
+}
+
+static void cascade(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_place(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Moves the wheel base to @tick.  No timeout may expire before it. */
+static void wheel_advance(uint64_t tick)
+{
+	uint64_t old = wheel.base;
+
+	if (tick == old) {
+		return;
+	}
+
+	wheel.base = tick;
+
+	if ((old >> (WHEEL_LEVELS * WHEEL_BITS)) !=
+	    (tick >> (WHEEL_LEVELS * WHEEL_BITS))) {
+		sys_dlist_t far;
+		sys_dnode_t *node;
+
+		/* Some of these may land back on the overflow list */
+		sys_dlist_init(&far);
+		while ((node = sys_dlist_get(&wheel.overflow)) != NULL) {
+			sys_dlist_append(&far, node);
+		}
+		cascade(&far);
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		int slot = (tick >> (l * WHEEL_BITS)) & WHEEL_MASK;
+
+		if ((old >> (l * WHEEL_BITS)) != (tick >> (l * WHEEL_BITS)) &&
+		    (wheel.occupied[l] & BIT64(slot)) != 0U) {
+			wheel.occupied[l] &= ~BIT64(slot);
+			cascade(&wheel.slots[l][slot]);
+		}
+	}
+}
+
+/* Removes and returns the earliest timeout if it expires at or
+ * before @tick, advancing the wheel to its expiry.
+ */
+static struct _timeout *wheel_expire(uint64_t tick)
+{
+	uint64_t next = wheel_next();
+	sys_dlist_t *list;
+
+	if (next > tick) {
+		return NULL;
+	}
+
+	wheel_advance(next);
+
+	list = &wheel.slots[0][next & WHEEL_MASK];
+	sys_dnode_t *node = sys_dlist_get(list);
+
+	if (sys_dlist_is_empty(list)) {
+		wheel.occupied[0] &= ~BIT64(next & WHEEL_MASK);
+		wheel.next_valid = false;
+	}
+
+	return CONTAINER_OF(node, struct _timeout, node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	wheel_remove(t);
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -64,6 +276,8 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0U;
@@ -71,15 +285,27 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t next = wheel_next();
+	int32_t ret = next == WHEEL_NONE ? MAX_WAIT
+		: CLAMP((int64_t)(next - curr_tick) - ticks_elapsed,
+			0, MAX_WAIT);
+#else
+	struct _timeout *to = first();
 	int32_t ret = to == NULL ? MAX_WAIT
 		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
 		ret = _current_cpu->slice_ticks;
 	}
+#endif
+#ifdef CONFIG_SCHED_CBS
+	if (_current_cpu->cbs_ticks && _current_cpu->cbs_ticks < ret) {
+		ret = _current_cpu->cbs_ticks;
+	}
 #endif
 	return ret;
 }
@@ -106,6 +332,13 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
+		bool is_first;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		to->dticks = curr_tick + ticks + elapsed();
+		is_first = (uint64_t)to->dticks < wheel_next();
+		wheel_add(to);
+#else
 		struct _timeout *t;
 
 		to->dticks = ticks + elapsed();
@@ -122,7 +355,10 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			sys_dlist_append(&timeout_list, &to->node);
 		}
 
-		if (to == first()) {
+		is_first = (to == first());
+#endif
+
+		if (is_first) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -168,12 +404,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -239,11 +479,29 @@ void z_clock_announce(int32_t ticks)
 #ifdef CONFIG_TIMESLICING
 	z_time_slice(ticks);
 #endif
+#ifdef CONFIG_SCHED_CBS
+	z_sched_cbs_tick();
+#endif
 
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t end_tick = curr_tick + ticks;
+	struct _timeout *t;
+
+	while ((t = wheel_expire(end_tick)) != NULL) {
+		curr_tick = t->dticks;
+		announce_remaining = end_tick - curr_tick;
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+	}
+
+	wheel_advance(end_tick);
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
@@ -261,6 +519,7 @@ void z_clock_announce(int32_t ticks)
 	if (first() != NULL) {
 		first()->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -59,6 +59,23 @@ extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 
 static void clear_perms_cb(struct z_object *ko, void *ctx_ptr);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/* Bumped after a thread lost its permission on an object, or an object was
+ * freed. This invalidates the object caches of all threads, entries are
+ * only ever added for the generation read before validating the object.
+ */
+static atomic_t obj_cache_gen;
+
+static inline void obj_cache_invalidate(void)
+{
+	(void)atomic_inc(&obj_cache_gen);
+}
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -275,6 +292,7 @@ static bool thread_idx_alloc(uintptr_t *tidx)
 			/* Clear permission from all objects */
 			z_object_wordlist_foreach(clear_perms_cb,
 						   (void *)*tidx);
+			obj_cache_invalidate();
 
 			return true;
 		}
@@ -299,6 +317,7 @@ static void thread_idx_free(uintptr_t tidx)
 {
 	/* To prevent leaked permission when index is recycled */
 	z_object_wordlist_foreach(clear_perms_cb, (void *)tidx);
+	obj_cache_invalidate();
 
 	sys_bitfield_set_bit((mem_addr_t)_thread_idx_map, tidx);
 }
@@ -404,6 +423,7 @@ void k_object_free(void *obj)
 	k_spin_unlock(&objfree_lock, key);
 
 	if (dyn != NULL) {
+		obj_cache_invalidate();
 		k_free(dyn);
 	}
 }
@@ -500,6 +520,10 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 
 	rb_remove(&obj_rb_tree, &dyn->node);
 	sys_dlist_remove(&dyn->obj_list);
+	/* Cached lookups must not outlive the object: invalidate before
+	 * its memory can be handed out again
+	 */
+	obj_cache_invalidate();
 	k_free(dyn);
 out:
 #endif
@@ -544,6 +568,7 @@ void z_thread_perms_clear(struct z_object *ko, struct k_thread *thread)
 
 	if (index != -1) {
 		sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
+		obj_cache_invalidate();
 		unref_check(ko, index);
 	}
 }
@@ -561,6 +586,7 @@ void z_thread_perms_all_clear(struct k_thread *thread)
 
 	if ((int)index != -1) {
 		z_object_wordlist_foreach(clear_perms_cb, (void *)index);
+		obj_cache_invalidate();
 	}
 }
 
@@ -648,6 +674,27 @@ void k_object_access_all_grant(const void *object)
 	}
 }
 
+static inline int obj_init_check(struct z_object *ko,
+				 enum _obj_init_check init)
+{
+	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
+	if (likely(init == _OBJ_INIT_TRUE)) {
+		/* Object MUST be intialized */
+		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U)) {
+			return -EINVAL;
+		}
+	} else if (init < _OBJ_INIT_TRUE) { /* _OBJ_INIT_FALSE case */
+		/* Object MUST NOT be initialized */
+		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U)) {
+			return -EADDRINUSE;
+		}
+	} else {
+		/* _OBJ_INIT_ANY */
+	}
+
+	return 0;
+}
+
 int z_object_validate(struct z_object *ko, enum k_objects otype,
 		       enum _obj_init_check init)
 {
@@ -663,23 +710,68 @@ int z_object_validate(struct z_object *ko, enum k_objects otype,
 		return -EPERM;
 	}
 
-	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
-	if (likely(init == _OBJ_INIT_TRUE)) {
-		/* Object MUST be intialized */
-		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U)) {
-			return -EINVAL;
-		}
-	} else if (init < _OBJ_INIT_TRUE) { /* _OBJ_INIT_FALSE case */
-		/* Object MUST NOT be initialized */
-		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U)) {
-			return -EADDRINUSE;
+	return obj_init_check(ko, init);
+}
+
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+static struct z_object *obj_cache_find(struct _thread_obj_cache *cache,
+				       const void *obj, uint32_t gen)
+{
+	if (cache->gen != gen) {
+		return NULL;
+	}
+
+	for (int i = 0; i < CONFIG_USERSPACE_OBJ_CACHE_SIZE; i++) {
+		if (cache->obj[i] == obj) {
+			return cache->ko[i];
 		}
-	} else {
-		/* _OBJ_INIT_ANY */
 	}
 
-	return 0;
+	return NULL;
+}
+
+static void obj_cache_add(struct _thread_obj_cache *cache, const void *obj,
+			  struct z_object *ko, uint32_t gen)
+{
+	if (cache->gen != gen) {
+		(void)memset(cache->obj, 0, sizeof(cache->obj));
+		cache->gen = gen;
+		cache->next = 0U;
+	}
+
+	cache->obj[cache->next] = obj;
+	cache->ko[cache->next] = ko;
+	cache->next = (cache->next + 1U) % CONFIG_USERSPACE_OBJ_CACHE_SIZE;
+}
+
+int z_object_validate_cached(const void *obj, enum k_objects otype,
+			     enum _obj_init_check init)
+{
+	struct _thread_obj_cache *cache = &_current->obj_cache;
+	uint32_t gen = (uint32_t)atomic_get(&obj_cache_gen);
+	struct z_object *ko;
+	int ret;
+
+	/* The thread was granted access to a cached object, only its type
+	 * and initialization state need checking. Failures take the slow
+	 * path below, so that they are reported the same way.
+	 */
+	ko = obj_cache_find(cache, obj, gen);
+	if (likely(ko != NULL) &&
+	    (otype == K_OBJ_ANY || ko->type == otype) &&
+	    obj_init_check(ko, init) == 0) {
+		return 0;
+	}
+
+	ko = z_object_find(obj);
+	ret = z_obj_validation_check(ko, obj, otype, init);
+	if (ret == 0) {
+		obj_cache_add(cache, obj, ko, gen);
+	}
+
+	return ret;
 }
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
 
 void z_object_init(const void *obj)
 {
@@ -714,6 +806,7 @@ void z_object_recycle(const void *obj)
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
+		obj_cache_invalidate();
 	}
 }
 
@@ -17,6 +17,7 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <sys/check.h>
+#include <sys/math_extras.h>
 
 #define WORKQUEUE_THREAD_NAME	"workqueue"
 
@@ -69,6 +70,34 @@ static int work_cancel(struct k_delayed_work *work)
 	return 0;
 }
 
+#ifdef CONFIG_WORKQUEUE_COALESCE
+/* Moves a relative delay's expiry later by at most the item's slack,
+ * to the tick in range with the most trailing zero bits, so items
+ * with overlapping ranges tend to share an expiry tick.
+ */
+static k_timeout_t apply_slack(struct k_delayed_work *work,
+			       k_timeout_t delay)
+{
+	if (work->slack == 0U || K_TIMEOUT_EQ(delay, K_FOREVER) ||
+	    Z_TICK_ABS(delay.ticks) >= 0) {
+		return delay;
+	}
+
+	/* Absolute expiry as computed by z_add_timeout() */
+	uint64_t now = z_tick_get();
+	uint64_t expires = now + delay.ticks + 1;
+	uint64_t limit = expires + work->slack;
+	int bit = 63 - u64_count_leading_zeros(expires ^ limit);
+
+	/* Clear the bits below the highest one that differs: still
+	 * within [expires, limit] since that bit is set in limit only
+	 */
+	limit &= ~BIT64_MASK(bit);
+
+	return K_TICKS(limit - now - 1);
+}
+#endif
+
 int k_delayed_work_submit_to_queue(struct k_work_q *work_q,
 				   struct k_delayed_work *work,
 				   k_timeout_t delay)
@@ -109,6 +138,10 @@ int k_delayed_work_submit_to_queue(struct k_work_q *work_q,
 		return 0;
 	}
 
+#ifdef CONFIG_WORKQUEUE_COALESCE
+	delay = apply_slack(work, delay);
+#endif
+
 	/* Add timeout */
 	z_add_timeout(&work->timeout, work_timeout, delay);
 
@@ -32,6 +32,54 @@ K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 
 #define HEAP_BYTES CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE
 
+#if defined(CONFIG_HEAP_CACHE) && !defined(CONFIG_USERSPACE)
+/* Without user mode the arena can be a k_heap, whose front-end cache
+ * then serves small allocations without taking the heap lock.
+ */
+K_HEAP_DEFINE(z_malloc_heap, HEAP_BYTES);
+
+void *malloc(size_t size)
+{
+	void *ret = k_heap_aligned_alloc(&z_malloc_heap,
+					 __alignof__(z_max_align_t),
+					 size, K_NO_WAIT);
+	if (ret == NULL) {
+		errno = ENOMEM;
+	}
+
+	return ret;
+}
+
+void *realloc(void *ptr, size_t requested_size)
+{
+	size_t old_size;
+	void *ret;
+
+	if (ptr == NULL) {
+		return malloc(requested_size);
+	}
+
+	if (requested_size == 0) {
+		k_heap_free(&z_malloc_heap, ptr);
+		return NULL;
+	}
+
+	/* The block may sit in the cache, so it is always moved */
+	ret = malloc(requested_size);
+	if (ret != NULL) {
+		old_size = sys_heap_usable_size(&z_malloc_heap.heap, ptr);
+		(void)memcpy(ret, ptr, MIN(old_size, requested_size));
+		k_heap_free(&z_malloc_heap, ptr);
+	}
+
+	return ret;
+}
+
+void free(void *ptr)
+{
+	k_heap_free(&z_malloc_heap, ptr);
+}
+#else
 Z_GENERIC_SECTION(POOL_SECTION) static struct sys_heap z_malloc_heap;
 Z_GENERIC_SECTION(POOL_SECTION) struct sys_mutex z_malloc_heap_mutex;
 Z_GENERIC_SECTION(POOL_SECTION) static char z_malloc_heap_mem[HEAP_BYTES];
@@ -93,6 +141,7 @@ void free(void *ptr)
 }
 
 SYS_INIT(malloc_prepare, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_HEAP_CACHE && !CONFIG_USERSPACE */
 #else /* No malloc arena */
 void *malloc(size_t size)
 {
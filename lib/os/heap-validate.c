@@ -93,6 +93,8 @@ bool sys_heap_validate(struct sys_heap *heap)
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
 	 */
+	size_t free_chunks = 0;
+
 	for (int b = 0; b <= bucket_idx(h, h->len); b++) {
 		chunkid_t c0 = h->buckets[b].next;
 		uint32_t n = 0;
@@ -105,6 +107,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 				return false;
 			}
 			set_chunk_used(h, c, true);
+			free_chunks += chunk_size(h, c);
 		}
 
 		bool empty = (h->avail_buckets & (1 << b)) == 0;
@@ -119,6 +122,15 @@ bool sys_heap_validate(struct sys_heap *heap)
 		}
 	}
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	/* The running count must match the free lists */
+	if (free_chunks != h->free_chunks) {
+		return false;
+	}
+#else
+	ARG_UNUSED(free_chunks);
+#endif
+
 	/*
 	 * Walk through the chunks linearly again, verifying that all chunks
 	 * but solo headers are now USED (i.e. all free blocks were found
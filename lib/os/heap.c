@@ -6,8 +6,63 @@
 #include <sys/sys_heap.h>
 #include <kernel.h>
 #include <string.h>
+#include <errno.h>
 #include "heap.h"
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+
+/* Free memory is accounted as chunks enter and leave the free lists
+ * (single-unit free fragments of big heaps are never listed and so
+ * count as allocated), the peak at the end of each allocation.
+ */
+static inline void heap_stats_free_add(struct z_heap *h, size_t sz)
+{
+	h->free_chunks += sz;
+}
+
+static inline void heap_stats_free_sub(struct z_heap *h, size_t sz)
+{
+	h->free_chunks -= sz;
+}
+
+static inline size_t allocated_chunks(struct z_heap *h)
+{
+	return h->len - chunk_size(h, 0) - h->free_chunks;
+}
+
+static inline void heap_stats_update_max(struct z_heap *h)
+{
+	h->max_allocated_chunks = MAX(h->max_allocated_chunks,
+				      allocated_chunks(h));
+}
+
+#else
+static inline void heap_stats_free_add(struct z_heap *h, size_t sz) { }
+static inline void heap_stats_free_sub(struct z_heap *h, size_t sz) { }
+static inline void heap_stats_update_max(struct z_heap *h) { }
+#endif
+
+#ifdef CONFIG_SYS_HEAP_LATENCY_STATS
+
+/* Bin 0 counts calls of zero cycles, bin N >= 1 those of
+ * [2^(N-1), 2^N) cycles, the last bin everything above.
+ */
+static inline void latency_record(uint32_t *bins, uint32_t t0)
+{
+	uint32_t dt = k_cycle_get_32() - t0;
+	int bin = (dt == 0U) ? 0 : 32 - __builtin_clz(dt);
+
+	bins[MIN(bin, SYS_HEAP_LATENCY_BINS - 1)]++;
+}
+
+#define LATENCY_START() uint32_t t0 = k_cycle_get_32()
+#define LATENCY_RECORD(h, hist) latency_record((h)->hist, t0)
+
+#else
+#define LATENCY_START() /**/
+#define LATENCY_RECORD(h, hist) /**/
+#endif
+
 static void *chunk_mem(struct z_heap *h, chunkid_t c)
 {
 	chunk_unit_t *buf = chunk_buf(h);
@@ -26,6 +81,8 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	CHECK(b->next != 0);
 	CHECK(h->avail_buckets & (1 << bidx));
 
+	heap_stats_free_sub(h, chunk_size(h, c));
+
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
 		h->avail_buckets &= ~(1 << bidx);
@@ -52,6 +109,8 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
+	heap_stats_free_add(h, chunk_size(h, c));
+
 	if (b->next == 0U) {
 		CHECK((h->avail_buckets & (1 << bidx)) == 0);
 
@@ -139,7 +198,7 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
-void sys_heap_free(struct sys_heap *heap, void *mem)
+static void heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
 		return; /* ISO C free() semantics */
@@ -167,6 +226,17 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	free_chunk(h, c);
 }
 
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+	size_t addr = (size_t)mem;
+	size_t chunk_base = (size_t)&chunk_buf(h)[c];
+	size_t chunk_sz = chunk_size(h, c) * CHUNK_UNIT;
+
+	return chunk_sz - (addr - chunk_base);
+}
+
 static chunkid_t alloc_chunk(struct z_heap *h, size_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -221,7 +291,7 @@ static chunkid_t alloc_chunk(struct z_heap *h, size_t sz)
 	return 0;
 }
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+static void *heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 
@@ -245,7 +315,8 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	return chunk_mem(h, c);
 }
 
-void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+static void *heap_aligned_alloc(struct sys_heap *heap, size_t align,
+				size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 	size_t padded_sz, gap, rewind;
@@ -263,7 +334,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		gap = MIN(rewind, chunk_header_bytes(h));
 	} else {
 		if (align <= chunk_header_bytes(h)) {
-			return sys_heap_alloc(heap, bytes);
+			return heap_alloc(heap, bytes);
 		}
 		rewind = 0;
 		gap = chunk_header_bytes(h);
@@ -312,17 +383,17 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	return mem;
 }
 
-void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
-			       size_t align, size_t bytes)
+static void *heap_aligned_realloc(struct sys_heap *heap, void *ptr,
+				  size_t align, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 
 	/* special realloc semantics */
 	if (ptr == NULL) {
-		return sys_heap_aligned_alloc(heap, align, bytes);
+		return heap_aligned_alloc(heap, align, bytes);
 	}
 	if (bytes == 0) {
-		sys_heap_free(heap, ptr);
+		heap_free(heap, ptr);
 		return NULL;
 	}
 
@@ -366,18 +437,125 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	}
 
 	/* Fallback: allocate and copy */
-	void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+	void *ptr2 = heap_aligned_alloc(heap, align, bytes);
 
 	if (ptr2 != NULL) {
 		size_t prev_size = chunk_size(h, c) * CHUNK_UNIT
 				   - chunk_header_bytes(h) - align_gap;
 
 		memcpy(ptr2, ptr, MIN(prev_size, bytes));
-		sys_heap_free(heap, ptr);
+		heap_free(heap, ptr);
 	}
 	return ptr2;
 }
 
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	LATENCY_START();
+
+	heap_free(heap, mem);
+	LATENCY_RECORD(heap->heap, free_cycles);
+}
+
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	LATENCY_START();
+	void *ret = heap_alloc(heap, bytes);
+
+	heap_stats_update_max(heap->heap);
+	LATENCY_RECORD(heap->heap, alloc_cycles);
+	return ret;
+}
+
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	LATENCY_START();
+	void *ret = heap_aligned_alloc(heap, align, bytes);
+
+	heap_stats_update_max(heap->heap);
+	LATENCY_RECORD(heap->heap, alloc_cycles);
+	return ret;
+}
+
+void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
+			       size_t align, size_t bytes)
+{
+	LATENCY_START();
+	void *ret = heap_aligned_realloc(heap, ptr, align, bytes);
+
+	heap_stats_update_max(heap->heap);
+	LATENCY_RECORD(heap->heap, alloc_cycles);
+	return ret;
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_heap_runtime_stats *stats)
+{
+	if (heap == NULL || stats == NULL) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	size_t hdr = chunk_header_bytes(h);
+	size_t largest = 0;
+
+	(void)memset(stats, 0, sizeof(*stats));
+
+	int nb_buckets = bucket_idx(h, h->len) + 1;
+
+	stats->nb_buckets = nb_buckets;
+	for (int i = 0; i < nb_buckets; i++) {
+		chunkid_t first = h->buckets[i].next, c = first;
+
+		if (first == 0U) {
+			continue;
+		}
+		do {
+			stats->bucket_blocks[i]++;
+			largest = MAX(largest, chunk_size(h, c));
+			c = next_free_chunk(h, c);
+		} while (c != first);
+		stats->free_blocks += stats->bucket_blocks[i];
+	}
+
+	stats->free_bytes = h->free_chunks * CHUNK_UNIT;
+	stats->allocated_bytes = allocated_chunks(h) * CHUNK_UNIT;
+	stats->max_allocated_bytes = h->max_allocated_chunks * CHUNK_UNIT;
+	stats->largest_free_bytes = largest > 0 ? largest * CHUNK_UNIT - hdr : 0;
+	if (h->free_chunks > 0U) {
+		stats->fragmentation = 100U - (uint32_t)((100U * largest) /
+							 h->free_chunks);
+	}
+
+#ifdef CONFIG_SYS_HEAP_LATENCY_STATS
+	(void)memcpy(stats->alloc_cycles, h->alloc_cycles,
+		     sizeof(stats->alloc_cycles));
+	(void)memcpy(stats->free_cycles, h->free_cycles,
+		     sizeof(stats->free_cycles));
+#endif
+	return 0;
+}
+
+int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
+{
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+
+	h->max_allocated_chunks = allocated_chunks(h);
+#ifdef CONFIG_SYS_HEAP_LATENCY_STATS
+	(void)memset(h->alloc_cycles, 0, sizeof(h->alloc_cycles));
+	(void)memset(h->free_cycles, 0, sizeof(h->free_cycles));
+#endif
+	return 0;
+}
+
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	/* Must fit in a 31 bit count of HUNK_UNIT */
@@ -400,6 +578,14 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->chunk0_hdr_area = 0;
 	h->len = buf_sz;
 	h->avail_buckets = 0;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_chunks = 0;
+	h->max_allocated_chunks = 0;
+#endif
+#ifdef CONFIG_SYS_HEAP_LATENCY_STATS
+	(void)memset(h->alloc_cycles, 0, sizeof(h->alloc_cycles));
+	(void)memset(h->free_cycles, 0, sizeof(h->free_cycles));
+#endif
 
 	int nb_buckets = bucket_idx(h, buf_sz) + 1;
 	size_t chunk0_size = chunksz(sizeof(struct z_heap) +
@@ -61,6 +61,14 @@ struct z_heap {
 	uint64_t chunk0_hdr_area;  /* matches the largest header */
 	uint32_t len;
 	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	size_t free_chunks;
+	size_t max_allocated_chunks;
+#endif
+#ifdef CONFIG_SYS_HEAP_LATENCY_STATS
+	uint32_t alloc_cycles[SYS_HEAP_LATENCY_BINS];
+	uint32_t free_cycles[SYS_HEAP_LATENCY_BINS];
+#endif
 	struct z_heap_bucket buckets[0];
 };
 
@@ -67,11 +67,253 @@ static inline bool item_lessthan(struct k_p4wq_work *a, struct k_p4wq_work *b)
 	return false;
 }
 
-static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
+#ifdef CONFIG_P4WQ_EXECUTOR
+/* Work item states, see k_p4wq_work_depend() and k_p4wq_wait() */
+enum {
+	WORK_IDLE,
+	WORK_PENDING,	/* submitted, waiting for prerequisites */
+	WORK_QUEUED,	/* in the queue or running */
+	WORK_DONE,
+};
+
+/* The dependency graph may span queues, so it (and item completion
+ * state) is protected by one global lock.  It is never taken with a
+ * queue lock held or vice versa.  Waiters sleep on the wait queue of
+ * their item.
+ */
+static struct k_spinlock dag_lock;
+
+static void queue_item(struct k_p4wq *queue, struct k_p4wq_work *item);
+static void p4wq_loop(void *p0, void *p1, void *p2);
+
+/* Returns true if a submitted item can be queued right away, false
+ * if it has to wait for its prerequisites.
+ */
+static bool work_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	k_spinlock_key_t k = k_spin_lock(&dag_lock);
+	bool ready = item->npending == 0;
+
+	__ASSERT(item->state != WORK_PENDING, "item already submitted");
+	/* Nobody waits for an idle or completed item, and a statically
+	 * zeroed item's wait queue isn't initialized yet
+	 */
+	if (item->state != WORK_QUEUED) {
+		z_waitq_init(&item->waitq);
+	}
+	item->queue = queue;
+	item->state = ready ? WORK_QUEUED : WORK_PENDING;
+	k_spin_unlock(&dag_lock, k);
+
+	return ready;
+}
+
+/* Called from the worker thread after an item's handler returned:
+ * releases dependents whose last prerequisite this was and wakes
+ * waiters.
+ */
+static void work_done(struct k_p4wq_work *w)
+{
+	sys_slist_t ready;
+	sys_snode_t *n;
+	bool wake;
+	k_spinlock_key_t k = k_spin_lock(&dag_lock);
+
+	sys_slist_init(&ready);
+	w->state = WORK_DONE;
+	while ((n = sys_slist_get(&w->successors)) != NULL) {
+		struct k_p4wq_work *s =
+			CONTAINER_OF(n, struct k_p4wq_dep, node)->work;
+
+		if (--s->npending == 0 && s->state == WORK_PENDING) {
+			s->state = WORK_QUEUED;
+			sys_slist_append(&ready, &s->readynode);
+		}
+	}
+	wake = z_unpend_all(&w->waitq) != 0;
+	k_spin_unlock(&dag_lock, k);
+
+	while ((n = sys_slist_get(&ready)) != NULL) {
+		struct k_p4wq_work *s =
+			CONTAINER_OF(n, struct k_p4wq_work, readynode);
+
+		queue_item(s->queue, s);
+	}
+
+	if (wake) {
+		z_reschedule_unlocked();
+	}
+}
+
+int k_p4wq_work_depend(struct k_p4wq_work *work,
+		       struct k_p4wq_work *prereq,
+		       struct k_p4wq_dep *dep)
+{
+	int ret = 0;
+	k_spinlock_key_t k = k_spin_lock(&dag_lock);
+
+	if (work->state == WORK_PENDING || work->state == WORK_QUEUED) {
+		ret = -EBUSY;
+	} else {
+		dep->work = work;
+		sys_slist_append(&prereq->successors, &dep->node);
+		work->npending++;
+	}
+
+	k_spin_unlock(&dag_lock, k);
+	return ret;
+}
+
+int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout)
+{
+	int64_t now, end = z_timeout_end_calc(timeout);
+	int ret = 0;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t k = k_spin_lock(&dag_lock);
+
+	while (work->state != WORK_DONE) {
+		if (work->state == WORK_IDLE) {
+			ret = -EINVAL;
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if ((end - now) <= 0) {
+				ret = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ?
+					-EBUSY : -EAGAIN;
+				break;
+			}
+			timeout = K_TICKS(end - now);
+		}
+
+		(void) z_pend_curr(&dag_lock, k, &work->waitq, timeout);
+		k = k_spin_lock(&dag_lock);
+	}
+
+	k_spin_unlock(&dag_lock, k);
+	return ret;
+}
+
+/* Claims a free pool slot for a new thread, returns its index or -1.
+ * A retired thread's slot can only be reused once the thread is
+ * actually dead.
+ */
+static int pool_reserve(struct k_p4wq *queue)
+{
+	if (queue->nthreads >= queue->max_threads || k_is_in_isr()) {
+		return -1;
+	}
+
+	for (int i = 0; i < queue->max_threads; i++) {
+		if ((queue->live & BIT(i)) == 0U &&
+		    ((queue->started & BIT(i)) == 0U ||
+		     z_is_thread_state_set(&queue->threads[i], _THREAD_DEAD))) {
+			queue->live |= BIT(i);
+			queue->started |= BIT(i);
+			queue->nthreads++;
+			return i;
+		}
+	}
+	return -1;
+}
+
+static void pool_spawn(struct k_p4wq *queue, int slot)
+{
+	struct k_thread *th = &queue->threads[slot];
+	uintptr_t ssz = K_THREAD_STACK_LEN(queue->stack_size);
+
+	/* Pool threads pass their slot number (plus one, so fixed
+	 * threads from k_p4wq_add_thread() can be told apart)
+	 */
+	k_thread_create(th, &queue->stacks[ssz * slot], queue->stack_size,
+			p4wq_loop, queue, (void *)(uintptr_t)(slot + 1), NULL,
+			K_HIGHEST_THREAD_PRIO, 0, K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (queue->cpu_mask != 0U) {
+		k_thread_cpu_mask_clear(th);
+		for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			if ((queue->cpu_mask & BIT(cpu)) != 0U) {
+				k_thread_cpu_mask_enable(th, cpu);
+			}
+		}
+	}
+#endif
+
+	k_thread_start(th);
+}
+
+/* Called with the queue lock held by a pool thread whose idle wait
+ * timed out.  Returns true if the thread should exit.
+ */
+static bool pool_retire(struct k_p4wq *queue, uintptr_t slot)
+{
+	if (slot == 0 || queue->nthreads <= queue->min_threads ||
+	    rb_get_max(&queue->queue) != NULL) {
+		return false;
+	}
+
+	queue->nthreads--;
+	queue->live &= ~BIT(slot - 1);
+	return true;
+}
+
+void k_p4wq_pool_init(struct k_p4wq *queue, struct k_thread *threads,
+		      struct z_thread_stack_element *stacks,
+		      size_t stack_size, uint32_t min_threads,
+		      uint32_t max_threads, uint32_t cpu_mask)
+{
+	__ASSERT(min_threads <= max_threads && max_threads <= 32,
+		 "bad pool size");
+	__ASSERT(cpu_mask == 0U || IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+		 "pool CPU mask needs CONFIG_SCHED_CPU_MASK");
+
+	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+
+	__ASSERT(queue->max_threads == 0U, "pool already initialized");
+	queue->threads = threads;
+	queue->stacks = stacks;
+	queue->stack_size = stack_size;
+	queue->min_threads = min_threads;
+	queue->max_threads = max_threads;
+	queue->cpu_mask = cpu_mask;
+	for (int i = 0; i < min_threads; i++) {
+		(void)pool_reserve(queue);
+	}
+	k_spin_unlock(&queue->lock, k);
+
+	for (int i = 0; i < min_threads; i++) {
+		pool_spawn(queue, i);
+	}
+}
+
+int k_p4wq_pool_size(struct k_p4wq *queue)
+{
+	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+	int ret = queue->nthreads;
+
+	k_spin_unlock(&queue->lock, k);
+	return ret;
+}
+#endif /* CONFIG_P4WQ_EXECUTOR */
+
+static void p4wq_loop(void *p0, void *p1, void *p2)
 {
-	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	struct k_p4wq *queue = p0;
+#ifdef CONFIG_P4WQ_EXECUTOR
+	uintptr_t slot = (uintptr_t)p1;
+	bool can_retire = slot != 0 && CONFIG_P4WQ_IDLE_TIMEOUT_MS > 0 &&
+		queue->min_threads < queue->max_threads;
+	k_timeout_t idle = can_retire ?
+		K_MSEC(CONFIG_P4WQ_IDLE_TIMEOUT_MS) : K_FOREVER;
+#else
+	ARG_UNUSED(p1);
+	k_timeout_t idle = K_FOREVER;
+#endif
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
 	while (true) {
@@ -97,14 +339,41 @@ static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 			if (!thread_was_requeued(_current)) {
 				sys_dlist_remove(&w->dlnode);
 				w->thread = NULL;
+#ifdef CONFIG_P4WQ_EXECUTOR
+				k_spin_unlock(&queue->lock, k);
+				work_done(w);
+				k = k_spin_lock(&queue->lock);
+#endif
 			}
 		} else {
-			z_pend_curr(&queue->lock, k, &queue->waitq, K_FOREVER);
+			int ret = z_pend_curr(&queue->lock, k, &queue->waitq,
+					      idle);
+
 			k = k_spin_lock(&queue->lock);
+#ifdef CONFIG_P4WQ_EXECUTOR
+			if (ret == -EAGAIN && pool_retire(queue, slot)) {
+				k_spin_unlock(&queue->lock, k);
+				return;
+			}
+#else
+			ARG_UNUSED(ret);
+#endif
 		}
 	}
 }
 
+void k_p4wq_work_init(struct k_p4wq_work *work)
+{
+	work->thread = NULL;
+#ifdef CONFIG_P4WQ_EXECUTOR
+	work->queue = NULL;
+	sys_slist_init(&work->successors);
+	z_waitq_init(&work->waitq);
+	work->npending = 0U;
+	work->state = WORK_IDLE;
+#endif
+}
+
 void k_p4wq_init(struct k_p4wq *queue)
 {
 	memset(queue, 0, sizeof(*queue));
@@ -128,6 +397,12 @@ static int static_init(const struct device *dev)
 
 	Z_STRUCT_SECTION_FOREACH(k_p4wq_initparam, pp) {
 		k_p4wq_init(pp->queue);
+#ifdef CONFIG_P4WQ_EXECUTOR
+		k_p4wq_pool_init(pp->queue, pp->threads, pp->stacks,
+				 pp->stack_size, pp->min, pp->num,
+				 pp->cpu_mask);
+		continue;
+#endif
 		for (int i = 0; i < pp->num; i++) {
 			uintptr_t ssz = K_THREAD_STACK_LEN(pp->stack_size);
 
@@ -145,7 +420,7 @@ static int static_init(const struct device *dev)
  */
 SYS_INIT(static_init, SMP, 99);
 
-void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+static void queue_item(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
@@ -199,11 +474,21 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	struct k_thread *th = z_unpend_first_thread(&queue->waitq);
 
 	if (th == NULL) {
+#ifdef CONFIG_P4WQ_EXECUTOR
+		int slot = pool_reserve(queue);
+
+		if (slot >= 0) {
+			k_spin_unlock(&queue->lock, k);
+			pool_spawn(queue, slot);
+			return;
+		}
+#endif
 		LOG_WRN("Out of worker threads, priority guarantee violated");
 		goto out;
 	}
 
 	set_prio(th, item);
+	arch_thread_return_value_set(th, 0);
 	z_ready_thread(th);
 	z_reschedule(&queue->lock, k);
 	return;
@@ -212,6 +497,16 @@ out:
 	k_spin_unlock(&queue->lock, k);
 }
 
+void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+#ifdef CONFIG_P4WQ_EXECUTOR
+	if (!work_submit(queue, item)) {
+		return;
+	}
+#endif
+	queue_item(queue, item);
+}
+
 bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
@@ -222,5 +517,18 @@ bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 	}
 
 	k_spin_unlock(&queue->lock, k);
+
+#ifdef CONFIG_P4WQ_EXECUTOR
+	k = k_spin_lock(&dag_lock);
+	if (ret || item->state == WORK_PENDING) {
+		item->state = WORK_IDLE;
+		ret = true;
+	}
+	if (ret && z_unpend_all(&item->waitq) != 0) {
+		z_reschedule(&dag_lock, k);
+	} else {
+		k_spin_unlock(&dag_lock, k);
+	}
+#endif
 	return ret;
 }
@@ -82,53 +82,42 @@ static void byte_indexes_rewind(struct ring_buf *buf)
 	k_spin_unlock(&buf->lock, key);
 }
 
-int ring_buf_item_put(struct ring_buf *buf, uint16_t type, uint8_t value,
-		      uint32_t *data, uint8_t size32)
+/* Writes an item (header and data) at index @a tail */
+static void item_write(struct ring_buf *buf, uint32_t tail, uint16_t type,
+		       uint8_t value, const uint32_t *data, uint8_t size32)
 {
-	uint32_t i, space, index, rc;
-
-	space = ring_buf_space_get(buf);
-	if (space >= (size32 + 1)) {
-		struct ring_element *header =
-		    (struct ring_element *)&buf->buf.buf32[mod(buf, buf->tail)];
+	struct ring_element *header =
+	    (struct ring_element *)&buf->buf.buf32[mod(buf, tail)];
+	uint32_t i, index;
 
-		header->type = type;
-		header->length = size32;
-		header->value = value;
+	header->type = type;
+	header->length = size32;
+	header->value = value;
 
-		if (likely(buf->mask)) {
-			for (i = 0U; i < size32; ++i) {
-				index = (i + buf->tail + 1) & buf->mask;
-				buf->buf.buf32[index] = data[i];
-			}
-		} else {
-			for (i = 0U; i < size32; ++i) {
-				index = (i + buf->tail + 1) % buf->size;
-				buf->buf.buf32[index] = data[i];
-			}
+	if (likely(buf->mask)) {
+		for (i = 0U; i < size32; ++i) {
+			index = (i + tail + 1) & buf->mask;
+			buf->buf.buf32[index] = data[i];
 		}
-
-		buf->tail = buf->tail + size32 + 1;
-		rc = 0U;
 	} else {
-		buf->misc.item_mode.dropped_put_count++;
-		rc = -EMSGSIZE;
+		for (i = 0U; i < size32; ++i) {
+			index = (i + tail + 1) % buf->size;
+			buf->buf.buf32[index] = data[i];
+		}
 	}
-
-	return rc;
 }
 
-int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
-		      uint32_t *data, uint8_t *size32)
+/* Reads the item at index @a head, returns its size including the
+ * header or -EMSGSIZE (with @a size32 set to the needed size) if it
+ * doesn't fit in @a size32 words.
+ */
+static int item_read(struct ring_buf *buf, uint32_t head, uint16_t *type,
+		     uint8_t *value, uint32_t *data, uint8_t *size32)
 {
 	struct ring_element *header;
 	uint32_t i, index;
 
-	if (ring_buf_is_empty(buf)) {
-		return -EAGAIN;
-	}
-
-	header = (struct ring_element *) &buf->buf.buf32[mod(buf, buf->head)];
+	header = (struct ring_element *) &buf->buf.buf32[mod(buf, head)];
 
 	if (header->length > *size32) {
 		*size32 = header->length;
@@ -141,23 +130,113 @@ int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 
 	if (likely(buf->mask)) {
 		for (i = 0U; i < header->length; ++i) {
-			index = (i + buf->head + 1) & buf->mask;
+			index = (i + head + 1) & buf->mask;
 			data[i] = buf->buf.buf32[index];
 		}
 	} else {
 		for (i = 0U; i < header->length; ++i) {
-			index = (i + buf->head + 1) % buf->size;
+			index = (i + head + 1) % buf->size;
 			data[i] = buf->buf.buf32[index];
 		}
 	}
 
-	buf->head = buf->head + header->length + 1;
+	return header->length + 1;
+}
+
+int ring_buf_item_put(struct ring_buf *buf, uint16_t type, uint8_t value,
+		      uint32_t *data, uint8_t size32)
+{
+	uint32_t space;
+	int rc;
+
+	space = ring_buf_space_get(buf);
+	if (space >= (size32 + 1)) {
+		item_write(buf, buf->tail, type, value, data, size32);
+		buf->tail = buf->tail + size32 + 1;
+		rc = 0U;
+	} else {
+		buf->misc.item_mode.dropped_put_count++;
+		rc = -EMSGSIZE;
+	}
+
+	return rc;
+}
+
+int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
+		      uint32_t *data, uint8_t *size32)
+{
+	int rc;
+
+	if (ring_buf_is_empty(buf)) {
+		return -EAGAIN;
+	}
+
+	rc = item_read(buf, buf->head, type, value, data, size32);
+	if (rc < 0) {
+		return rc;
+	}
+
+	buf->head = buf->head + rc;
 
 	item_indexes_rewind(buf);
 
 	return 0;
 }
 
+int ring_buf_item_put_batch(struct ring_buf *buf,
+			    const struct ring_buf_item *items, size_t count)
+{
+	uint32_t space = ring_buf_space_get(buf);
+	uint32_t tail = buf->tail;
+	size_t n;
+
+	for (n = 0; n < count; n++) {
+		const struct ring_buf_item *item = &items[n];
+
+		if (space < (item->size32 + 1U)) {
+			break;
+		}
+
+		item_write(buf, tail, item->type, item->value, item->data,
+			   item->size32);
+		tail += item->size32 + 1U;
+		space -= item->size32 + 1U;
+	}
+
+	/* Publish all items at once */
+	buf->tail = tail;
+	buf->misc.item_mode.dropped_put_count += count - n;
+
+	return n;
+}
+
+int ring_buf_item_get_batch(struct ring_buf *buf,
+			    struct ring_buf_item *items, size_t count)
+{
+	uint32_t head = buf->head;
+	size_t n;
+
+	for (n = 0; n < count && head != buf->tail; n++) {
+		struct ring_buf_item *item = &items[n];
+		int rc = item_read(buf, head, &item->type, &item->value,
+				   item->data, &item->size32);
+
+		if (rc < 0) {
+			if (n == 0) {
+				return rc;
+			}
+			break;
+		}
+		head += rc;
+	}
+
+	/* Free all items at once */
+	buf->head = head;
+	item_indexes_rewind(buf);
+
+	return n;
+}
+
 /** @brief Wraps index if it exceeds the limit.
  *
  * @param val  Value
@@ -226,6 +305,25 @@ uint32_t ring_buf_put(struct ring_buf *buf, const uint8_t *data, uint32_t size)
 	return total_size;
 }
 
+uint32_t ring_buf_put_claim_sg(struct ring_buf *buf,
+			       struct ring_buf_seg seg[2], uint32_t size)
+{
+	seg[0].size = ring_buf_put_claim(buf, &seg[0].data, size);
+	seg[1].size = 0U;
+	seg[1].data = NULL;
+
+	/* Only a claim stopped by the buffer end can continue at its start */
+	if (seg[0].size < size) {
+		seg[1].size = ring_buf_put_claim(buf, &seg[1].data,
+						 size - seg[0].size);
+		if (seg[1].size == 0U) {
+			seg[1].data = NULL;
+		}
+	}
+
+	return seg[0].size + seg[1].size;
+}
+
 uint32_t ring_buf_get_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 {
 	uint32_t space, granted_size, trail_size, tmp_head_mod;
@@ -280,3 +378,180 @@ uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
 
 	return total_size;
 }
+
+uint32_t ring_buf_get_claim_sg(struct ring_buf *buf,
+			       struct ring_buf_seg seg[2], uint32_t size)
+{
+	seg[0].size = ring_buf_get_claim(buf, &seg[0].data, size);
+	seg[1].size = 0U;
+	seg[1].data = NULL;
+
+	if (seg[0].size < size) {
+		seg[1].size = ring_buf_get_claim(buf, &seg[1].data,
+						 size - seg[0].size);
+		if (seg[1].size == 0U) {
+			seg[1].data = NULL;
+		}
+	}
+
+	return seg[0].size + seg[1].size;
+}
+
+/* Lock-free multi-producer, multi-consumer ring: a bounded queue of
+ * fixed-size slots, each with a sequence number (see Vyukov's bounded
+ * MPMC queue).  Slot i of lap n is free for writing when its sequence
+ * is i + n * count, holds a record when it is one more.  Slots are
+ * laid out as the sequence word, the record length and the data.
+ *
+ * The sequence is stored relative to the slot index so that a zeroed
+ * buffer is a valid empty ring (and RING_BUF_MP_DECLARE needs no
+ * runtime init).
+ */
+#define MP_SEQ 0
+#define MP_LEN 1
+#define MP_DATA 2
+
+static inline uint32_t *mp_slot(struct ring_buf_mp *buf, uint32_t idx)
+{
+	return &buf->buf[idx * buf->slot_words];
+}
+
+static inline uint32_t mp_slot_idx(struct ring_buf_mp *buf, uint8_t *data)
+{
+	uint32_t *slot = (uint32_t *)data - MP_DATA;
+
+	return (slot - buf->buf) / buf->slot_words;
+}
+
+static inline uint32_t mp_seq_get(struct ring_buf_mp *buf, uint32_t idx)
+{
+	atomic_t *seq = (atomic_t *)&mp_slot(buf, idx)[MP_SEQ];
+
+	return (uint32_t)atomic_get(seq) + idx;
+}
+
+static inline void mp_seq_set(struct ring_buf_mp *buf, uint32_t idx,
+			      uint32_t val)
+{
+	atomic_t *seq = (atomic_t *)&mp_slot(buf, idx)[MP_SEQ];
+
+	atomic_set(seq, (atomic_val_t)(val - idx));
+}
+
+/* Claims the slot at index @a pos, for which the sequence must be
+ * pos + @a ready, advancing @a idx past it.  Returns NULL if the slot
+ * at the current index is not ready.
+ */
+static uint32_t *mp_claim(struct ring_buf_mp *buf, atomic_t *idx,
+			  uint32_t ready)
+{
+	uint32_t pos = (uint32_t)atomic_get(idx);
+
+	for (;;) {
+		uint32_t i = pos & buf->mask;
+		int32_t diff = (int32_t)(mp_seq_get(buf, i) - (pos + ready));
+
+		if (diff == 0) {
+			if (atomic_cas(idx, pos, pos + 1)) {
+				return mp_slot(buf, i);
+			}
+		} else if (diff < 0) {
+			/* Full (writers) or empty (readers) */
+			return NULL;
+		}
+
+		/* Another context got there first, retry */
+		pos = (uint32_t)atomic_get(idx);
+	}
+}
+
+uint32_t ring_buf_mp_put_claim(struct ring_buf_mp *buf, uint8_t **data)
+{
+	uint32_t *slot = mp_claim(buf, &buf->wr, 0);
+
+	if (slot == NULL) {
+		return 0;
+	}
+
+	*data = (uint8_t *)&slot[MP_DATA];
+	return buf->slot_size;
+}
+
+int ring_buf_mp_put_finish(struct ring_buf_mp *buf, uint8_t *data,
+			   uint32_t size)
+{
+	uint32_t idx = mp_slot_idx(buf, data);
+	int ret = 0;
+
+	/* The slot must be published in any case, or readers would stall
+	 * on it: an invalid record is discarded instead.
+	 */
+	if (size > buf->slot_size) {
+		size = 0U;
+		ret = -EINVAL;
+	}
+
+	mp_slot(buf, idx)[MP_LEN] = size;
+	mp_seq_set(buf, idx, mp_seq_get(buf, idx) + 1);
+
+	return ret;
+}
+
+int ring_buf_mp_put(struct ring_buf_mp *buf, const uint8_t *data,
+		    uint32_t size)
+{
+	uint8_t *dst;
+
+	if (size > buf->slot_size) {
+		return -EINVAL;
+	}
+
+	if (ring_buf_mp_put_claim(buf, &dst) == 0) {
+		return -EMSGSIZE;
+	}
+
+	memcpy(dst, data, size);
+	return ring_buf_mp_put_finish(buf, dst, size);
+}
+
+uint32_t ring_buf_mp_get_claim(struct ring_buf_mp *buf, uint8_t **data)
+{
+	uint32_t *slot;
+
+	while ((slot = mp_claim(buf, &buf->rd, 1)) != NULL) {
+		if (slot[MP_LEN] != 0U) {
+			*data = (uint8_t *)&slot[MP_DATA];
+			return slot[MP_LEN];
+		}
+
+		/* Discarded claim, release it and look further */
+		ring_buf_mp_get_finish(buf, (uint8_t *)&slot[MP_DATA]);
+	}
+
+	return 0;
+}
+
+void ring_buf_mp_get_finish(struct ring_buf_mp *buf, uint8_t *data)
+{
+	uint32_t idx = mp_slot_idx(buf, data);
+
+	/* The sequence is pos + 1, make it pos + count for the next lap */
+	mp_seq_set(buf, idx, mp_seq_get(buf, idx) + buf->mask);
+}
+
+uint32_t ring_buf_mp_get(struct ring_buf_mp *buf, uint8_t *data,
+			 uint32_t size)
+{
+	uint8_t *src;
+	uint32_t len = ring_buf_mp_get_claim(buf, &src);
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	len = MIN(len, size);
+	memcpy(data, src, len);
+	ring_buf_mp_get_finish(buf, src);
+
+	return len;
+}
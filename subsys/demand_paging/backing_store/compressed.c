@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <sys/sys_heap.h>
+#include <kernel_arch_interface.h>
+
+/*
+ * Evicted data pages are compressed into a RAM pool, so that the pool holds
+ * more data pages than its size in pages would suggest. The compressor
+ * produces LZ4 block format data using a greedy single-probe match finder,
+ * which trades some ratio for a short and predictable page-out time.
+ *
+ * Each location token is the index of a slot descriptor times the page
+ * size. A slot records where the compressed data lives in the pool and how
+ * long it is; a length of zero denotes an all-zero data page, which takes no
+ * pool space at all, and a length of one page denotes a data page stored
+ * uncompressed because it did not shrink.
+ *
+ * z_backing_store_page_out() has no way to report failure, so
+ * z_backing_store_location_get() already reserves an uncompressed page worth
+ * of pool memory which z_backing_store_page_out() shrinks in place to the
+ * compressed size. One extra page of pool memory is held back at all times
+ * so that page faults can always be serviced.
+ *
+ * Like the RAM backing store, locations are released as soon as their data
+ * page is paged back in, so Z_PAGE_FRAME_BACKED is never set.
+ */
+
+BUILD_ASSERT(CONFIG_MMU_PAGE_SIZE <= UINT16_MAX,
+	     "page size too large for compressed slot lengths");
+
+#define LZ_MIN_MATCH		4
+#define LZ_LAST_LITERALS	5
+#define LZ_MFLIMIT		12
+#define LZ_HASH_BITS		12
+#define LZ_MAX_OFFSET		0xFFFF
+#define LZ_RUN_MASK		0xF
+
+struct slot {
+	void *data;
+	uint16_t len;
+};
+
+static struct slot slots[CONFIG_BACKING_STORE_COMPRESSED_PAGES];
+static struct k_mem_slab slot_slab;
+static unsigned int free_slots;
+
+static char __aligned(8) pool_mem[CONFIG_BACKING_STORE_COMPRESSED_POOL_SIZE];
+static struct sys_heap pool;
+static void *fault_reserve;
+
+static uint16_t lz_table[1 << LZ_HASH_BITS];
+
+static inline uint32_t lz_read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	(void)memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint32_t lz_hash(uint32_t v)
+{
+	return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t *lz_put_length(uint8_t *op, size_t len)
+{
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = (uint8_t)len;
+
+	return op;
+}
+
+/* Worst-case encoded size of a sequence, bar the match offset */
+static inline size_t lz_sequence_bound(size_t literals, size_t match)
+{
+	return 1 + (literals / 255) + 1 + literals + (match / 255) + 1;
+}
+
+/*
+ * Compress @a len bytes at @a src into at most @a cap bytes at @a dst.
+ *
+ * Returns the compressed size, or 0 if the data does not fit.
+ */
+static size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst,
+			  size_t cap)
+{
+	const uint8_t *ip = src + 1;
+	const uint8_t *anchor = src;
+	const uint8_t *mflimit = src + len - LZ_MFLIMIT;
+	const uint8_t *matchlimit = src + len - LZ_LAST_LITERALS;
+	uint8_t *op = dst;
+	uint8_t *oend = dst + cap;
+	size_t literals, match;
+	uint8_t *token;
+
+	(void)memset(lz_table, 0, sizeof(lz_table));
+
+	while (ip < mflimit) {
+		uint32_t h = lz_hash(lz_read32(ip));
+		const uint8_t *ref = src + lz_table[h];
+		const uint8_t *mp, *rp;
+
+		lz_table[h] = (uint16_t)(ip - src);
+
+		if (ref >= ip || (ip - ref) > LZ_MAX_OFFSET ||
+		    lz_read32(ref) != lz_read32(ip)) {
+			ip++;
+			continue;
+		}
+
+		while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+			ip--;
+			ref--;
+		}
+
+		mp = ip + LZ_MIN_MATCH;
+		rp = ref + LZ_MIN_MATCH;
+		while (mp < matchlimit && *mp == *rp) {
+			mp++;
+			rp++;
+		}
+
+		literals = ip - anchor;
+		match = mp - ip - LZ_MIN_MATCH;
+		if ((size_t)(oend - op) < lz_sequence_bound(literals, match) + 2) {
+			return 0;
+		}
+
+		token = op++;
+		*token = (uint8_t)((MIN(literals, LZ_RUN_MASK) << 4) |
+				   MIN(match, LZ_RUN_MASK));
+		if (literals >= LZ_RUN_MASK) {
+			op = lz_put_length(op, literals - LZ_RUN_MASK);
+		}
+		(void)memcpy(op, anchor, literals);
+		op += literals;
+		*op++ = (uint8_t)(ip - ref);
+		*op++ = (uint8_t)((ip - ref) >> 8);
+		if (match >= LZ_RUN_MASK) {
+			op = lz_put_length(op, match - LZ_RUN_MASK);
+		}
+
+		ip = mp;
+		anchor = ip;
+	}
+
+	literals = src + len - anchor;
+	if ((size_t)(oend - op) < lz_sequence_bound(literals, 0)) {
+		return 0;
+	}
+	token = op++;
+	*token = (uint8_t)(MIN(literals, LZ_RUN_MASK) << 4);
+	if (literals >= LZ_RUN_MASK) {
+		op = lz_put_length(op, literals - LZ_RUN_MASK);
+	}
+	(void)memcpy(op, anchor, literals);
+	op += literals;
+
+	return op - dst;
+}
+
+/*
+ * Decompress @a len bytes at @a src into at most @a cap bytes at @a dst.
+ *
+ * Returns the decompressed size, or -1 if the data is corrupt.
+ */
+static int lz_decompress(const uint8_t *src, size_t len, uint8_t *dst,
+			 size_t cap)
+{
+	const uint8_t *ip = src;
+	const uint8_t *iend = src + len;
+	uint8_t *op = dst;
+	uint8_t *oend = dst + cap;
+	size_t literals, match, offset;
+	const uint8_t *ref;
+	uint8_t token, b;
+
+	while (ip < iend) {
+		token = *ip++;
+
+		literals = token >> 4;
+		if (literals == LZ_RUN_MASK) {
+			do {
+				if (ip >= iend) {
+					return -1;
+				}
+				b = *ip++;
+				literals += b;
+			} while (b == 255);
+		}
+		if (literals > (size_t)(iend - ip) ||
+		    literals > (size_t)(oend - op)) {
+			return -1;
+		}
+		(void)memcpy(op, ip, literals);
+		op += literals;
+		ip += literals;
+
+		if (ip == iend) {
+			/* last sequence has no match */
+			break;
+		}
+
+		if ((iend - ip) < 2) {
+			return -1;
+		}
+		offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > (size_t)(op - dst)) {
+			return -1;
+		}
+
+		match = token & LZ_RUN_MASK;
+		if (match == LZ_RUN_MASK) {
+			do {
+				if (ip >= iend) {
+					return -1;
+				}
+				b = *ip++;
+				match += b;
+			} while (b == 255);
+		}
+		match += LZ_MIN_MATCH;
+		if (match > (size_t)(oend - op)) {
+			return -1;
+		}
+
+		/* matches may overlap their own output */
+		ref = op - offset;
+		while (match-- > 0) {
+			*op++ = *ref++;
+		}
+	}
+
+	return op - dst;
+}
+
+static bool page_is_zero(const void *page)
+{
+	const uint32_t *word = page;
+
+	for (size_t i = 0; i < CONFIG_MMU_PAGE_SIZE / sizeof(*word); i++) {
+		if (word[i] != 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static struct slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location <
+		 (CONFIG_BACKING_STORE_COMPRESSED_PAGES * CONFIG_MMU_PAGE_SIZE),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static uintptr_t slot_to_location(struct slot *slot)
+{
+	__ASSERT(slot >= slots && slot < slots + ARRAY_SIZE(slots),
+		 "bad slot pointer %p", slot);
+
+	return (slot - slots) * CONFIG_MMU_PAGE_SIZE;
+}
+
+static void fault_reserve_refill(void)
+{
+	if (fault_reserve == NULL) {
+		fault_reserve = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	}
+}
+
+int z_backing_store_location_get(struct z_page_frame *pf, uintptr_t *location,
+				 bool page_fault)
+{
+	struct slot *slot;
+	void *data;
+	int ret;
+
+	if ((!page_fault && free_slots == 1) || free_slots == 0) {
+		return -ENOMEM;
+	}
+
+	data = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	if (data == NULL && page_fault) {
+		data = fault_reserve;
+		fault_reserve = NULL;
+	}
+	if (data == NULL) {
+		return -ENOMEM;
+	}
+
+	ret = k_mem_slab_alloc(&slot_slab, (void **)&slot, K_NO_WAIT);
+	__ASSERT(ret == 0, "slot count mismatch");
+	(void)ret;
+	slot->data = data;
+	slot->len = CONFIG_MMU_PAGE_SIZE;
+	*location = slot_to_location(slot);
+	free_slots--;
+
+	return 0;
+}
+
+void z_backing_store_location_free(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+
+	if (slot->data != NULL) {
+		sys_heap_free(&pool, slot->data);
+	}
+	k_mem_slab_free(&slot_slab, (void **)&slot);
+	free_slots++;
+
+	fault_reserve_refill();
+}
+
+void z_backing_store_page_out(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	void *data;
+	size_t len;
+
+	if (page_is_zero(Z_SCRATCH_PAGE)) {
+		sys_heap_free(&pool, slot->data);
+		slot->data = NULL;
+		slot->len = 0;
+	} else {
+		len = lz_compress(Z_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE,
+				  slot->data, CONFIG_MMU_PAGE_SIZE - 1);
+		if (len == 0) {
+			(void)memcpy(slot->data, Z_SCRATCH_PAGE,
+				     CONFIG_MMU_PAGE_SIZE);
+			len = CONFIG_MMU_PAGE_SIZE;
+		} else {
+			/* Give back the tail, keep the whole block on failure */
+			data = sys_heap_aligned_realloc(&pool, slot->data, 0,
+							len);
+			if (data != NULL) {
+				slot->data = data;
+			}
+		}
+		slot->len = len;
+	}
+
+	fault_reserve_refill();
+}
+
+void z_backing_store_page_in(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	int ret;
+
+	if (slot->len == 0) {
+		(void)memset(Z_SCRATCH_PAGE, 0, CONFIG_MMU_PAGE_SIZE);
+	} else if (slot->len == CONFIG_MMU_PAGE_SIZE) {
+		(void)memcpy(Z_SCRATCH_PAGE, slot->data, CONFIG_MMU_PAGE_SIZE);
+	} else {
+		ret = lz_decompress(slot->data, slot->len, Z_SCRATCH_PAGE,
+				    CONFIG_MMU_PAGE_SIZE);
+		__ASSERT(ret == CONFIG_MMU_PAGE_SIZE,
+			 "corrupt compressed page at location 0x%lx",
+			 location);
+		(void)ret;
+	}
+}
+
+void z_backing_store_page_finalize(struct z_page_frame *pf, uintptr_t location)
+{
+	z_backing_store_location_free(location);
+}
+
+void z_backing_store_init(void)
+{
+	k_mem_slab_init(&slot_slab, slots, sizeof(struct slot),
+			CONFIG_BACKING_STORE_COMPRESSED_PAGES);
+	free_slots = CONFIG_BACKING_STORE_COMPRESSED_PAGES;
+
+	sys_heap_init(&pool, pool_mem, sizeof(pool_mem));
+	fault_reserve_refill();
+	__ASSERT(fault_reserve != NULL, "compressed backing store pool too small");
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Flash partition backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <kernel_arch_interface.h>
+
+/*
+ * Evicted data pages are stored in the fixed flash partition labeled
+ * "demand-paging" in devicetree. Each location token is the byte offset of
+ * a page-sized slot within that partition, so the partition size sets the
+ * capacity of the backing store.
+ *
+ * Unlike the RAM backing store, a slot is not released when its data page is
+ * paged back in. The slot keeps a clean copy of the data page and the page
+ * frame is marked Z_PAGE_FRAME_BACKED, so that evicting the page again
+ * before it is written to needs no flash erase or write at all. Slots holding
+ * clean copies are reclaimed when no free slots are left.
+ *
+ * Flash drivers are not ready when z_backing_store_init() runs, so the
+ * partition is opened on first use. All flash operations are performed with
+ * interrupts or the scheduler locked, so the flash driver must not block.
+ */
+
+#if !FLASH_AREA_LABEL_EXISTS(demand_paging)
+#error "Need a fixed partition named 'demand-paging'!"
+#endif
+
+#define FLASH_PARTITION		FLASH_AREA_ID(demand_paging)
+#define NUM_SLOTS		(FLASH_AREA_SIZE(demand_paging) / \
+				 CONFIG_MMU_PAGE_SIZE)
+
+BUILD_ASSERT(NUM_SLOTS > 1, "demand-paging partition too small");
+
+enum slot_state {
+	SLOT_FREE,
+	/* Holds the only copy of an evicted data page */
+	SLOT_EVICTED,
+	/* Holds a clean copy of a data page which is in memory */
+	SLOT_CACHED,
+};
+
+static uint8_t slot_state[NUM_SLOTS];
+static struct z_page_frame *slot_owner[NUM_SLOTS];
+static unsigned int free_slots;
+static unsigned int cached_slots;
+static const struct flash_area *flash_area;
+
+static unsigned int location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location < (NUM_SLOTS * CONFIG_MMU_PAGE_SIZE),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return location / CONFIG_MMU_PAGE_SIZE;
+}
+
+static uintptr_t slot_to_location(unsigned int slot)
+{
+	return slot * CONFIG_MMU_PAGE_SIZE;
+}
+
+static void partition_open(void)
+{
+	int ret;
+
+	ret = flash_area_open(FLASH_PARTITION, &flash_area);
+	__ASSERT(ret == 0, "failed to open demand-paging partition (%d)", ret);
+
+#if __ASSERT_ON && defined(CONFIG_FLASH_PAGE_LAYOUT)
+	struct flash_pages_info info;
+
+	ret = flash_get_page_info_by_offs(flash_area_get_device(flash_area),
+					  flash_area->fa_off, &info);
+	__ASSERT(ret == 0 && (flash_area->fa_off % CONFIG_MMU_PAGE_SIZE) == 0 &&
+		 (CONFIG_MMU_PAGE_SIZE % info.size) == 0,
+		 "demand-paging partition not aligned to flash erase blocks");
+#endif
+	(void)ret;
+}
+
+static void slot_release(unsigned int slot)
+{
+	if (slot_state[slot] == SLOT_CACHED) {
+		cached_slots--;
+	}
+	slot_state[slot] = SLOT_FREE;
+	slot_owner[slot] = NULL;
+	free_slots++;
+}
+
+/* Take a free slot, or failing that reclaim one holding a clean copy */
+static unsigned int slot_take(void)
+{
+	unsigned int slot;
+
+	if (free_slots != 0U) {
+		for (slot = 0; slot_state[slot] != SLOT_FREE; slot++) {
+		}
+	} else {
+		for (slot = 0; slot_state[slot] != SLOT_CACHED; slot++) {
+		}
+		slot_owner[slot]->flags &= ~Z_PAGE_FRAME_BACKED;
+		slot_release(slot);
+	}
+
+	slot_state[slot] = SLOT_EVICTED;
+	free_slots--;
+
+	return slot;
+}
+
+int z_backing_store_location_get(struct z_page_frame *pf, uintptr_t *location,
+				 bool page_fault)
+{
+	unsigned int avail = free_slots + cached_slots;
+	unsigned int slot;
+
+	if (flash_area == NULL) {
+		partition_open();
+	}
+
+	if ((pf->flags & Z_PAGE_FRAME_BACKED) != 0U) {
+		/* The clean copy becomes the only copy, no room needed */
+		for (slot = 0; slot < NUM_SLOTS; slot++) {
+			if (slot_owner[slot] == pf) {
+				slot_state[slot] = SLOT_EVICTED;
+				slot_owner[slot] = NULL;
+				cached_slots--;
+				*location = slot_to_location(slot);
+
+				return 0;
+			}
+		}
+
+		/* Stale flag, the page needs a slot like any other */
+		__ASSERT(false, "no slot for backed page frame");
+		pf->flags &= ~Z_PAGE_FRAME_BACKED;
+	}
+
+	if ((!page_fault && avail == 1) || avail == 0) {
+		return -ENOMEM;
+	}
+
+	*location = slot_to_location(slot_take());
+
+	return 0;
+}
+
+void z_backing_store_location_free(uintptr_t location)
+{
+	slot_release(location_to_slot(location));
+}
+
+void z_backing_store_page_out(uintptr_t location)
+{
+	int ret;
+
+	ret = flash_area_erase(flash_area, location, CONFIG_MMU_PAGE_SIZE);
+	if (ret == 0) {
+		ret = flash_area_write(flash_area, location, Z_SCRATCH_PAGE,
+				       CONFIG_MMU_PAGE_SIZE);
+	}
+	if (ret != 0) {
+		__ASSERT(false, "failed to page out to 0x%lx (%d)", location,
+			 ret);
+		k_panic();
+	}
+}
+
+void z_backing_store_page_in(uintptr_t location)
+{
+	int ret;
+
+	ret = flash_area_read(flash_area, location, Z_SCRATCH_PAGE,
+			      CONFIG_MMU_PAGE_SIZE);
+	if (ret != 0) {
+		__ASSERT(false, "failed to page in from 0x%lx (%d)", location,
+			 ret);
+		k_panic();
+	}
+}
+
+void z_backing_store_page_finalize(struct z_page_frame *pf, uintptr_t location)
+{
+	unsigned int slot = location_to_slot(location);
+
+	/* Keep the slot as a clean copy of the data page */
+	slot_state[slot] = SLOT_CACHED;
+	slot_owner[slot] = pf;
+	cached_slots++;
+	pf->flags |= Z_PAGE_FRAME_BACKED;
+}
+
+void z_backing_store_init(void)
+{
+	free_slots = NUM_SLOTS;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* Page frames are arranged on a circular list which a clock hand sweeps
+ * across, one page frame at a time, only when a page frame needs to be
+ * evicted. There is no periodic scan of all page frames.
+ *
+ * Each page frame has an age weight approximating how recently and how
+ * often its data page was used. When the hand passes a page frame whose
+ * data page was accessed since the last pass, its weight is raised and the
+ * accessed state cleared; otherwise its weight decays. Page frames whose
+ * weight has decayed to zero are outside of the working set and are
+ * eviction candidates, clean ones first: a dirty candidate is only evicted
+ * if no clean one turns up within CONFIG_EVICTION_CLOCK_SCAN_LIMIT page
+ * frames, which bounds the time spent looking for one.
+ */
+
+static uint8_t weights[Z_NUM_PAGE_FRAMES];
+static unsigned int hand;
+
+static inline struct z_page_frame *hand_advance(void)
+{
+	struct z_page_frame *pf = &z_page_frames[hand];
+
+	hand = (hand + 1U) % Z_NUM_PAGE_FRAMES;
+
+	return pf;
+}
+
+/* Every sweep decays the weight of each evictable page frame not accessed in
+ * the meantime, so a candidate turns up within this many steps of the hand
+ */
+#define MAX_STEPS	(Z_NUM_PAGE_FRAMES * \
+			 (CONFIG_EVICTION_CLOCK_MAX_WEIGHT + 2))
+
+struct z_page_frame *z_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *dirty_pf = NULL;
+	unsigned int scanned = 0U;
+	uintptr_t flags;
+	uint8_t *weight;
+
+	for (size_t step = 0; step < MAX_STEPS; step++) {
+		pf = hand_advance();
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+		weight = &weights[pf - z_page_frames];
+
+		/* Clear accessed bit in page tables */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0U) {
+			if (*weight < CONFIG_EVICTION_CLOCK_MAX_WEIGHT) {
+				(*weight)++;
+			}
+		} else if (*weight > 0U) {
+			(*weight)--;
+		} else if ((flags & ARCH_DATA_PAGE_DIRTY) == 0U) {
+			*dirty_ptr = false;
+			return pf;
+		} else if (dirty_pf == NULL) {
+			dirty_pf = pf;
+		}
+
+		scanned++;
+		if (dirty_pf != NULL &&
+		    scanned >= CONFIG_EVICTION_CLOCK_SCAN_LIMIT) {
+			break;
+		}
+	}
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(dirty_pf != NULL, "no page to evict");
+
+	*dirty_ptr = true;
+
+	return dirty_pf;
+}
+
+void z_eviction_init(void)
+{
+	/* Start out with all data pages considered part of the working set,
+	 * so that the first sweep of the hand does not evict page frames
+	 * mapped at boot just because nothing was accessed yet.
+	 */
+	for (size_t i = 0; i < Z_NUM_PAGE_FRAMES; i++) {
+		weights[i] = 1U;
+	}
+}
@@ -54,11 +54,108 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** All of the port and address fields are specified */
+#define NET_CONN_TUPLE_SPEC		(NET_CONN_REMOTE_ADDR_SPEC | \
+					 NET_CONN_LOCAL_ADDR_SPEC |  \
+					 NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_LOCAL_PORT_SPEC)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Every used UDP or TCP connection handler is also in exactly one of
+ * these: fully specified ones are hashed by protocol, remote address
+ * and port and local port, those only bound to a local port by protocol
+ * and local port, and the rest are kept in a list.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_listen[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wild;
+
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash = (hash ^ val) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+static inline sys_slist_t *conn_hash_bucket(sys_slist_t *table,
+					    uint32_t hash)
+{
+	return &table[hash % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+/* Ports are in network byte order */
+static sys_slist_t *conn_tuple_bucket(uint16_t proto, sa_family_t family,
+				      const void *remote_addr,
+				      uint16_t remote_port,
+				      uint16_t local_port)
+{
+	uint32_t hash = conn_hash_mix(proto,
+				      ((uint32_t)remote_port << 16) |
+				      local_port);
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		const struct in6_addr *addr6 = remote_addr;
+
+		for (int i = 0; i < 4; i++) {
+			hash = conn_hash_mix(hash, UNALIGNED_GET(
+						     &addr6->s6_addr32[i]));
+		}
+	} else {
+		const struct in_addr *addr4 = remote_addr;
+
+		hash = conn_hash_mix(hash, UNALIGNED_GET(&addr4->s_addr));
+	}
+
+	return conn_hash_bucket(conn_hash, hash);
+}
+
+static inline sys_slist_t *conn_listen_bucket(uint16_t proto,
+					      uint16_t local_port)
+{
+	return conn_hash_bucket(conn_listen,
+				conn_hash_mix(proto, local_port));
+}
+
+/* Where a used connection handler is indexed */
+static sys_slist_t *conn_index(struct net_conn *conn)
+{
+	if ((conn->proto != IPPROTO_UDP && conn->proto != IPPROTO_TCP) ||
+	    !((IS_ENABLED(CONFIG_NET_IPV6) && conn->family == AF_INET6) ||
+	      (IS_ENABLED(CONFIG_NET_IPV4) && conn->family == AF_INET))) {
+		return &conn_wild;
+	}
+
+	if ((conn->flags & NET_CONN_TUPLE_SPEC) == NET_CONN_TUPLE_SPEC) {
+		const void *remote_addr;
+
+		if (conn->family == AF_INET6) {
+			remote_addr = &net_sin6(&conn->remote_addr)->sin6_addr;
+		} else {
+			remote_addr = &net_sin(&conn->remote_addr)->sin_addr;
+		}
+
+		return conn_tuple_bucket(conn->proto, conn->family,
+					 remote_addr,
+					 net_sin(&conn->remote_addr)->sin_port,
+					 net_sin(&conn->local_addr)->sin_port);
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) &&
+	    !(conn->flags & (NET_CONN_REMOTE_ADDR_SPEC |
+			     NET_CONN_REMOTE_PORT_SPEC))) {
+		return conn_listen_bucket(conn->proto,
+					  net_sin(&conn->local_addr)->sin_port);
+	}
+
+	return &conn_wild;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -132,6 +229,10 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_prepend(conn_index(conn), &conn->hash_node);
+#endif
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -379,6 +480,10 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_find_and_remove(conn_index(conn), &conn->hash_node);
+#endif
+
 	conn_set_unused(conn);
 
 	return 0;
@@ -457,6 +562,126 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+/* Check the ports and addresses of a UDP or TCP connection handler
+ * against those of a packet.  Ports are in network byte order.
+ */
+static bool conn_end_points_match(struct net_conn *conn,
+				  struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  uint16_t src_port,
+				  uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Pick the best match of @a list as net_conn_input() does */
+static void conn_lookup_list(sys_slist_t *list, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port,
+			     struct net_conn **best_match, int16_t *best_rank)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, hash_node) {
+		if (conn->proto != proto) {
+			continue;
+		}
+
+		if (conn->family != AF_UNSPEC &&
+		    conn->family != net_pkt_family(pkt)) {
+			continue;
+		}
+
+		if (!conn_end_points_match(conn, pkt, ip_hdr,
+					   src_port, dst_port)) {
+			continue;
+		}
+
+		if (*best_match != NULL &&
+		    (*best_match)->flags & NET_CONN_REMOTE_PORT_SPEC) {
+			return;
+		}
+
+		if (*best_rank < NET_CONN_RANK(conn->flags)) {
+			*best_rank = NET_CONN_RANK(conn->flags);
+			*best_match = conn;
+		}
+	}
+}
+
+/* Find the handler of a unicast UDP or TCP packet */
+static struct net_conn *conn_lookup(struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    uint8_t proto,
+				    uint16_t src_port,
+				    uint16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+	const void *src;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = &ip_hdr->ipv6->src;
+	} else {
+		src = &ip_hdr->ipv4->src;
+	}
+
+	/* A fully specified handler ranks above any other */
+	SYS_SLIST_FOR_EACH_CONTAINER(conn_tuple_bucket(proto, family, src,
+						       src_port, dst_port),
+				     conn, hash_node) {
+		if (conn->proto == proto && conn->family == family &&
+		    conn_end_points_match(conn, pkt, ip_hdr,
+					  src_port, dst_port)) {
+			return conn;
+		}
+	}
+
+	conn_lookup_list(&conn_wild, pkt, ip_hdr, proto, src_port, dst_port,
+			 &best_match, &best_rank);
+	conn_lookup_list(conn_listen_bucket(proto, dst_port), pkt, ip_hdr,
+			 proto, src_port, dst_port, &best_match, &best_rank);
+
+	return best_match;
+}
+#else
+static inline struct net_conn *conn_lookup(struct net_pkt *pkt,
+					   union net_ip_header *ip_hdr,
+					   uint8_t proto,
+					   uint16_t src_port,
+					   uint16_t dst_port)
+{
+	return NULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
@@ -621,6 +846,19 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	/* A unicast UDP or TCP packet goes to a single handler, which the
+	 * lookup tables find without going through all of them.
+	 */
+	if (IS_ENABLED(CONFIG_NET_CONN_HASH) && !is_mcast_pkt &&
+	    !is_bcast_pkt &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP) &&
+	    (net_pkt_family(pkt) == AF_INET ||
+	     net_pkt_family(pkt) == AF_INET6)) {
+		best_match = conn_lookup(pkt, ip_hdr, proto,
+					 src_port, dst_port);
+		goto match;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* For packet socket data, the proto is set to ETH_P_ALL but
 		 * the listener might have a specific protocol set. This is ok
@@ -674,34 +912,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
+			if (!conn_end_points_match(conn, pkt, ip_hdr,
+						   src_port, dst_port)) {
+				continue;
 			}
 
 			/* If we have an existing best_match, and that one
@@ -775,6 +988,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+match:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -835,6 +1049,15 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+		sys_slist_init(&conn_listen[i]);
+	}
+
+	sys_slist_init(&conn_wild);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
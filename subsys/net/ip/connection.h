@@ -50,6 +50,11 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node in the lookup tables */
+	sys_snode_t hash_node;
+#endif
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -273,6 +273,15 @@ static inline int check_ip_addr(struct net_pkt *pkt)
 #define check_ip_addr(pkt) 0
 #endif
 
+static int loopback_segment(struct net_pkt *seg, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	processing_data(seg, true);
+
+	return 0;
+}
+
 /* Called when data needs to be sent to network */
 int net_send_data(struct net_pkt *pkt)
 {
@@ -308,6 +317,19 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+		/* The receiving side expects segments of the MSS */
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt)) {
+			status = net_tcp_gso_segment(pkt, loopback_segment,
+						     NULL);
+			if (status < 0) {
+				return status;
+			}
+
+			net_pkt_unref(pkt);
+			return 0;
+		}
+
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -344,24 +366,19 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 	net_pkt_print();
 }
 
-static void process_rx_packet(struct k_work *work)
+void net_process_rx_packet(struct net_pkt *pkt)
 {
-	struct net_pkt *pkt;
-
-	pkt = CONTAINER_OF(work, struct net_pkt, work);
-
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+/* Return the traffic class the packet is queued to */
+static uint8_t net_queue_rx_tc(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
 
-	k_work_init(net_pkt_work(pkt), process_rx_packet);
-
 #if defined(CONFIG_NET_STATISTICS)
 	net_stats_update_tc_recv_pkt(iface, tc);
 	net_stats_update_tc_recv_bytes(iface, tc, net_pkt_get_len(pkt));
@@ -372,11 +389,10 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
-	net_tc_submit_to_rx_queue(tc, pkt);
+	return tc;
 }
 
-/* Called by driver when an IP packet has been received */
-int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+static int net_recv_prepare(struct net_if *iface, struct net_pkt *pkt)
 {
 	if (!pkt || !iface) {
 		return -EINVAL;
@@ -402,11 +418,65 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 
 	net_pkt_set_iface(pkt, iface);
 
-	net_queue_rx(iface, pkt);
+	return 0;
+}
+
+/* Called by driver when an IP packet has been received */
+int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+{
+	int ret;
+
+	ret = net_recv_prepare(iface, pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_tc_submit_to_rx_queue(net_queue_rx_tc(iface, pkt), pkt);
 
 	return 0;
 }
 
+/* Called by driver with a batch of received packets */
+int net_recv_data_list(struct net_if *iface, sys_slist_t *list)
+{
+	sys_slist_t queues[NET_TC_RX_COUNT];
+	sys_slist_t rejected;
+	sys_snode_t *node;
+	int i, ret = 0;
+
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		sys_slist_init(&queues[i]);
+	}
+
+	sys_slist_init(&rejected);
+
+	while ((node = sys_slist_get(list))) {
+		struct net_pkt *pkt = CONTAINER_OF(node, struct net_pkt,
+						   rx_node);
+		int err;
+
+		err = net_recv_prepare(iface, pkt);
+		if (err < 0) {
+			sys_slist_append(&rejected, node);
+			ret = err;
+			continue;
+		}
+
+		sys_slist_append(&queues[net_queue_rx_tc(iface, pkt)],
+				 node);
+	}
+
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		if (!sys_slist_is_empty(&queues[i])) {
+			net_tc_submit_list_to_rx_queue(i, &queues[i]);
+		}
+	}
+
+	*list = rejected;
+
+	return ret;
+}
+
 static inline void l3_init(void)
 {
 	net_icmpv4_init();
@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -200,6 +201,32 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+static int l2_send_segment(struct net_pkt *seg, void *user_data)
+{
+	struct net_if *iface = user_data;
+	int status;
+
+	status = net_if_l2(iface)->send(iface, seg);
+	if (status < 0) {
+		net_pkt_unref(seg);
+	}
+
+	return status;
+}
+
+/* Split a large TCP packet that the device cannot segment itself */
+static int l2_send_segmented(struct net_if *iface, struct net_pkt *pkt)
+{
+	int status;
+
+	status = net_tcp_gso_segment(pkt, l2_send_segment, iface);
+	if (status >= 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return status;
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -266,7 +293,12 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) &&
+		    net_if_need_tcp_segmentation(iface)) {
+			status = l2_send_segmented(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && status >= 0 &&
 		    context) {
@@ -3393,7 +3425,7 @@ void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
 	}
 }
 
-static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
+static bool hw_caps_missing(struct net_if *iface, enum ethernet_hw_caps caps)
 {
 #if defined(CONFIG_NET_L2_ETHERNET)
 	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
@@ -3408,12 +3440,17 @@ static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
 
 bool net_if_need_calc_tx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
+	return hw_caps_missing(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
 }
 
 bool net_if_need_calc_rx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+	return hw_caps_missing(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+}
+
+bool net_if_need_tcp_segmentation(struct net_if *iface)
+{
+	return hw_caps_missing(iface, ETHERNET_HW_TCP_SEG_OFFLOAD);
 }
 
 int net_if_get_by_iface(struct net_if *iface)
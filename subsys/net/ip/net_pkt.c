@@ -951,6 +951,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 	sa_family_t family = net_pkt_family(pkt);
 	size_t max_len;
 
+	/* A large TCP packet is split in segments that fit the MTU before
+	 * it is sent.
+	 */
+	if (net_pkt_gso_size(pkt)) {
+		return size;
+	}
+
 	if (net_pkt_iface(pkt)) {
 		max_len = net_if_get_mtu(net_pkt_iface(pkt));
 	} else {
@@ -984,6 +991,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP data is queued in chunks up to the size of a large segment */
+	if (proto == IPPROTO_TCP) {
+		max_len = MAX(max_len, CONFIG_NET_TCP_GSO_MAX_SIZE + existing);
+	}
+#endif
+
 	max_len -= existing;
 
 	return MIN(size, max_len);
@@ -1737,6 +1751,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
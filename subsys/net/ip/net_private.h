@@ -88,6 +88,8 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list);
+extern void net_process_rx_packet(struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -209,6 +211,59 @@ static inline uint16_t net_calc_chksum_tcp(struct net_pkt *pkt)
 	return net_calc_chksum(pkt, IPPROTO_TCP);
 }
 
+/**
+ * @brief Update a checksum for a change of the data it covers (RFC 1624)
+ *
+ * All the values are as stored in the packet, in network byte order.
+ *
+ * @param chksum	Checksum field to update
+ * @param old_data	Previous data, of an even length
+ * @param new_data	New data, at the same offset in the packet
+ * @param len		Length of the data
+ *
+ * @return Updated checksum field
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+				  const void *new_data, size_t len);
+
+/**
+ * @brief Update a checksum for a change of a 16-bit field (RFC 1624)
+ *
+ * @param chksum	Checksum field to update, in network byte order
+ * @param old_val	Previous value of the field, in network byte order
+ * @param new_val	New value of the field, in network byte order
+ *
+ * @return Updated checksum field
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m'), which does not depend on the byte order */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+/**
+ * @brief Update a checksum for a change of a 32-bit field (RFC 1624)
+ *
+ * @param chksum	Checksum field to update, in network byte order
+ * @param old_val	Previous value of the field, in network byte order
+ * @param new_val	New value of the field, in network byte order
+ *
+ * @return Updated checksum field
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, old_val >> 16, new_val >> 16);
+
+	return net_chksum_update16(chksum, old_val & 0xffff, new_val & 0xffff);
+}
+
 static inline char *net_sprint_ll_addr(const uint8_t *ll, uint8_t ll_len)
 {
 	static char buf[sizeof("xx:xx:xx:xx:xx:xx:xx:xx")];
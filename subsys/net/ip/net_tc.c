@@ -35,6 +35,19 @@ K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
 
+/* Received packets wait in a FIFO per traffic class, which a single work
+ * item drains up to CONFIG_NET_TC_RX_BUDGET packets at a time. A burst
+ * of packets then costs one wakeup of the RX thread instead of one per
+ * packet.
+ */
+struct rx_queue {
+	struct k_fifo fifo;
+	struct k_work work;
+	uint8_t tc;
+};
+
+static struct rx_queue rx_queues[NET_TC_RX_COUNT];
+
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 	if (k_work_pending(net_pkt_work(pkt))) {
@@ -52,7 +65,44 @@ void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+	k_fifo_put(&rx_queues[tc].fifo, pkt);
+	k_work_submit_to_queue(&rx_classes[tc].work_q, &rx_queues[tc].work);
+}
+
+void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list)
+{
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	uint32_t tick = k_cycle_get_32();
+	struct net_pkt *pkt;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, pkt, rx_node) {
+		net_pkt_set_rx_stats_tick(pkt, tick);
+	}
+#endif
+
+	k_fifo_put_slist(&rx_queues[tc].fifo, list);
+	k_work_submit_to_queue(&rx_classes[tc].work_q, &rx_queues[tc].work);
+}
+
+static void tc_rx_handler(struct k_work *work)
+{
+	struct rx_queue *queue = CONTAINER_OF(work, struct rx_queue, work);
+	struct net_pkt *pkt;
+	int budget;
+
+	for (budget = CONFIG_NET_TC_RX_BUDGET; budget > 0; budget--) {
+		pkt = k_fifo_get(&queue->fifo, K_NO_WAIT);
+		if (!pkt) {
+			return;
+		}
+
+		net_process_rx_packet(pkt);
+	}
+
+	/* Let the other work items and threads run before the rest */
+	if (!k_fifo_is_empty(&queue->fifo)) {
+		k_work_submit_to_queue(&rx_classes[queue->tc].work_q, work);
+	}
 }
 
 int net_tx_priority2tc(enum net_priority prio)
@@ -256,6 +306,10 @@ void net_tc_rx_init(void)
 		uint8_t thread_priority;
 		int priority;
 
+		k_fifo_init(&rx_queues[i].fifo);
+		k_work_init(&rx_queues[i].work, tc_rx_handler);
+		rx_queues[i].tc = i;
+
 		thread_priority = rx_tc2thread(i);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
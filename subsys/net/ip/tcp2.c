@@ -20,16 +20,23 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
-#include "tcp2_priv.h"
+#include "tcp_internal.h"
 
 #define ACK_TIMEOUT_MS CONFIG_NET_TCP_ACK_TIMEOUT
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
 
+/* Bounds of the RTO computed from RTT measurements, RFC 6298 ch 2 */
+#define TCP_RTO_MIN_MS 100
+#define TCP_RTO_MAX_MS 60000
+
+#define TCP_DUP_ACK_THRESHOLD 3
+
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
-static int tcp_window = NET_IPV6_MTU;
+static int tcp_window = CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE ?
+	CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE : NET_IPV6_MTU;
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -475,7 +482,7 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 
 		tcp_send(pkt);
 
-		if (forget == false && !k_delayed_work_remaining_get(
+		if (forget == false && !k_delayed_work_remaining_ticks(
 				&conn->send_timer)) {
 			conn->send_retries = tcp_retries;
 			conn->in_retransmission = true;
@@ -596,11 +603,17 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
 	uint8_t opt, opt_len;
+	struct tcphdr *th = th_get(pkt);
+	bool syn = th && (th_flags(th) & SYN);
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS, window scale and SACK permitted are only valid on SYN */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -633,6 +646,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -644,9 +661,56 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
+			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != TCPOLEN_SACK_PERM) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
 			break;
+		case TCPOPT_TIMESTAMP:
+			if (opt_len != TCPOLEN_TIMESTAMP) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case TCPOPT_SACK:
+			if ((opt_len - 2) % 8 != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_num < TCP_SACK_MAX_BLOCKS;
+			     i += 8) {
+				struct tcp_sack_block *block =
+				  &recv_options->sack[recv_options->sack_num++];
+
+				block->start = ntohl(UNALIGNED_GET(
+					(uint32_t *)(options + i)));
+				block->end = ntohl(UNALIGNED_GET(
+					(uint32_t *)(options + i + 4)));
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -741,11 +805,114 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+static size_t tcp_option_nops(uint8_t *opts, size_t len, size_t count)
+{
+	while (count--) {
+		opts[len++] = TCPOPT_NOP;
+	}
+
+	return len;
+}
+
+/* Write the options of a segment with the given flags, padded to a
+ * multiple of 4 bytes, and return their length. An active open offers
+ * all the enabled options, the other segments only carry the ones the
+ * peer agreed on in its SYN.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags,
+				uint8_t *opts)
+{
+	bool offer = (flags & (SYN | ACK)) == SYN;
+	bool ws = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		(offer || conn->wscale_ok);
+	bool ts = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) &&
+		(offer || conn->ts_ok);
+	bool sack_perm = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		(offer || conn->sack_ok);
+	size_t len = 0;
+
+	if (flags & SYN) {
+		uint16_t mss = net_tcp_get_recv_mss(conn);
+
+		if (mss) {
+			opts[len++] = TCPOPT_MAXSEG;
+			opts[len++] = TCPOLEN_MAXSEG;
+			UNALIGNED_PUT(htons(mss), (uint16_t *)(opts + len));
+			len += 2;
+		}
+
+		if (ws) {
+			len = tcp_option_nops(opts, len, 1);
+			opts[len++] = TCPOPT_WINDOW;
+			opts[len++] = TCPOLEN_WINDOW;
+			opts[len++] = conn->rcv_wscale;
+		}
+
+		if (sack_perm) {
+			/* Fill the padding of the timestamps if any */
+			if (!ts) {
+				len = tcp_option_nops(opts, len, 2);
+			}
+			opts[len++] = TCPOPT_SACK_PERM;
+			opts[len++] = TCPOLEN_SACK_PERM;
+		}
+	} else {
+		sack_perm = false;
+	}
+
+	if (ts) {
+		if (!sack_perm) {
+			len = tcp_option_nops(opts, len, 2);
+		}
+		opts[len++] = TCPOPT_TIMESTAMP;
+		opts[len++] = TCPOLEN_TIMESTAMP;
+		UNALIGNED_PUT(htonl(k_uptime_get_32()),
+			      (uint32_t *)(opts + len));
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		UNALIGNED_PUT(htonl(conn->ts_recent),
+			      (uint32_t *)(opts + len + 4));
+#endif
+		len += 8;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Report the out-of-order data we have queued. The queue only
+	 * holds sequential data so there is at most one block.
+	 */
+	if (!(flags & SYN) && (flags & ACK) && conn->sack_ok &&
+	    !net_pkt_is_empty(conn->queue_recv_data)) {
+		uint32_t start = tcp_get_seq(conn->queue_recv_data->buffer);
+		uint32_t end = start + net_pkt_get_len(conn->queue_recv_data);
+
+		len = tcp_option_nops(opts, len, 2);
+		opts[len++] = TCPOPT_SACK;
+		opts[len++] = 2 + sizeof(struct tcp_sack_block);
+		UNALIGNED_PUT(htonl(start), (uint32_t *)(opts + len));
+		UNALIGNED_PUT(htonl(end), (uint32_t *)(opts + len + 4));
+		len += sizeof(struct tcp_sack_block);
+	}
+#endif
+
+	return len;
+}
+
+/* The payload that fits in a data segment next to the options it will
+ * carry, RFC 6691 ch 2 and RFC 7323 ch 3.2.
+ */
+static int tcp_data_mss(struct tcp *conn)
+{
+	uint8_t opts[TCP_OPTIONS_MAX_LEN];
+
+	return conn_mss(conn) - tcp_options_build(conn, PSH | ACK, opts);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, const uint8_t *opts, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	uint32_t win = conn->recv_win;
+	int ret;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -754,18 +921,28 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	memset(th, 0, sizeof(struct tcphdr));
 
+	/* The window of a SYN segment is never scaled */
+	if (!(flags & SYN) && conn->wscale_ok) {
+		win >>= conn->rcv_wscale;
+	}
+
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
+	th->th_off = 5 + opts_len / 4;
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(MIN(win, UINT16_MAX)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
 		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret < 0 || opts_len == 0) {
+		return ret;
+	}
+
+	return net_pkt_write(pkt, opts, opts_len);
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -788,15 +965,25 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t opts[TCP_OPTIONS_MAX_LEN];
+	size_t opts_len = tcp_options_build(conn, flags, opts);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
 
+	/* Let the driver or net_if split a segment larger than the MSS,
+	 * with the size tcp_send_data() picked for the payload
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && data &&
+	    net_pkt_gso_size(data)) {
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
+	}
+
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
@@ -809,7 +996,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -874,9 +1061,216 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+static uint32_t tcp_rto_get(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	/* Back off exponentially while the same data is retransmitted */
+	return MIN(conn->rto << MIN(conn->send_data_retries, 16U),
+		   TCP_RTO_MAX_MS);
+#else
+	ARG_UNUSED(conn);
+
+	return tcp_rto;
+#endif
+}
+
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+/* Update the RTO with an RTT measurement, RFC 6298 ch 2 */
+static void tcp_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	if (!conn->rtt_valid) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+		conn->rtt_valid = true;
+	} else {
+		int32_t delta = rtt - (conn->srtt >> 3);
+
+		conn->srtt += delta;
+		if (delta < 0) {
+			delta = -delta;
+		}
+		conn->rttvar += delta - (conn->rttvar >> 2);
+	}
+
+	conn->rto = CLAMP((conn->srtt >> 3) + MAX(conn->rttvar, 1U),
+			  TCP_RTO_MIN_MS, TCP_RTO_MAX_MS);
+
+	NET_DBG("conn: %p rtt %u srtt %u rttvar %u rto %u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+#endif
+
+/* Time the segment just sent unless one is already being timed */
+static void tcp_rtt_start(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	if (!conn->rtt_timing && !conn->ts_ok) {
+		conn->rtt_timing = true;
+		conn->rtt_seq = conn->seq + conn->unacked_len;
+		conn->rtt_start = k_uptime_get_32();
+	}
+#endif
+}
+
+/* Karn's algorithm: do not measure the RTT of retransmitted data */
+static void tcp_rtt_cancel(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	conn->rtt_timing = false;
+#endif
+}
+
+/* Measure the RTT with an ACK acknowledging new data */
+static void tcp_rtt_update(struct tcp *conn, uint32_t ack)
+{
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	uint32_t now = k_uptime_get_32();
+
+	if (conn->ts_ok) {
+		if (conn->recv_options.ts_found && conn->recv_options.tsecr) {
+			tcp_rtt_sample(conn, now - conn->recv_options.tsecr);
+		}
+	} else if (conn->rtt_timing &&
+		   net_tcp_seq_cmp(ack, conn->rtt_seq) >= 0) {
+		conn->rtt_timing = false;
+		tcp_rtt_sample(conn, now - conn->rtt_start);
+	}
+#endif
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_remove(struct tcp *conn, int i)
+{
+	conn->sacked_num--;
+	memmove(&conn->sacked[i], &conn->sacked[i + 1],
+		(conn->sacked_num - i) * sizeof(conn->sacked[0]));
+}
+
+/* Merge the SACK blocks of the received segment into the scoreboard,
+ * which is kept sorted, after dropping what is acknowledged.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	int i, j;
+
+	for (i = 0; i < conn->sacked_num; ) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(block->end, conn->seq) <= 0) {
+			tcp_sack_remove(conn, i);
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->start, conn->seq) < 0) {
+			block->start = conn->seq;
+		}
+
+		i++;
+	}
+
+	for (i = 0; conn->sack_ok && i < opts->sack_num; i++) {
+		struct tcp_sack_block new = opts->sack[i];
+
+		/* Skip duplicate SACKs and bogus blocks */
+		if (net_tcp_seq_cmp(new.start, new.end) >= 0 ||
+		    net_tcp_seq_cmp(new.start, conn->seq) < 0 ||
+		    net_tcp_seq_cmp(new.end, snd_nxt) > 0) {
+			continue;
+		}
+
+		for (j = 0; j < conn->sacked_num; ) {
+			struct tcp_sack_block *block = &conn->sacked[j];
+
+			if (net_tcp_seq_cmp(new.start, block->end) <= 0 &&
+			    net_tcp_seq_cmp(new.end, block->start) >= 0) {
+				if (net_tcp_seq_cmp(block->start,
+						    new.start) < 0) {
+					new.start = block->start;
+				}
+				if (net_tcp_seq_cmp(block->end, new.end) > 0) {
+					new.end = block->end;
+				}
+				tcp_sack_remove(conn, j);
+				continue;
+			}
+
+			j++;
+		}
+
+		for (j = 0; j < conn->sacked_num &&
+		     net_tcp_seq_cmp(conn->sacked[j].start, new.start) < 0;
+		     j++) {
+		}
+
+		if (conn->sacked_num == TCP_SACK_MAX_BLOCKS) {
+			/* Keep the lowest blocks, the holes between them are
+			 * retransmitted first.
+			 */
+			if (j == TCP_SACK_MAX_BLOCKS) {
+				continue;
+			}
+			conn->sacked_num--;
+		}
+
+		memmove(&conn->sacked[j + 1], &conn->sacked[j],
+			(conn->sacked_num - j) * sizeof(conn->sacked[0]));
+		conn->sacked[j] = new;
+		conn->sacked_num++;
+	}
+}
+
+/* Find the first hole not yet retransmitted below the highest SACKed data */
+static bool tcp_sack_next_hole(struct tcp *conn, uint32_t *start,
+			       uint32_t *end)
+{
+	uint32_t seq = conn->sack_rexmit;
+	int i;
+
+	if (net_tcp_seq_cmp(seq, conn->seq) < 0) {
+		seq = conn->seq;
+	}
+
+	for (i = 0; i < conn->sacked_num; i++) {
+		if (net_tcp_seq_cmp(seq, conn->sacked[i].start) < 0) {
+			*start = seq;
+			*end = conn->sacked[i].start;
+			return true;
+		}
+
+		if (net_tcp_seq_cmp(seq, conn->sacked[i].end) < 0) {
+			seq = conn->sacked[i].end;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Amount of data allowed in flight */
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN(conn->send_win, conn->cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_window(conn));
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	/* The congestion window is counted in bytes, so avoid sending the
+	 * silly small segments that would fill it up, RFC 1122 ch 4.2.3.4
+	 */
+	if (conn->unacked_len > 0 &&
+	    conn->unacked_len + conn_mss(conn) > tcp_send_window(conn)) {
+		window_full = true;
+	}
+#endif
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -901,32 +1295,93 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+#if defined(CONFIG_NET_TCP_GSO)
+/* Allocate the payload of a segment larger than the MSS, which is not
+ * limited by the MTU of the interface and is split in @a mss parts.
+ */
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, int len, int mss)
 {
-	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_iface(pkt, conn->iface);
+	net_pkt_set_family(pkt, net_context_get_family(conn->context));
+	net_pkt_set_gso_size(pkt, mss);
+
+	/* Do not wait, the caller falls back to the MSS */
+	if (net_pkt_alloc_buffer(pkt, len, IPPROTO_TCP, K_NO_WAIT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#else
+#define tcp_gso_pkt_alloc(_conn, _len, _mss) NULL
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Send len bytes of the send_data queue starting at pos, in segments
+ * of at most mss bytes of data
+ */
+static int tcp_send_segment(struct tcp *conn, int pos, int len, int mss)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	if (len > mss) {
+		pkt = tcp_gso_pkt_alloc(conn, len, mss);
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+	}
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		/* A large segment is retried with the MSS by the caller */
+		if (len <= mss) {
+			NET_ERR("conn: %p packet allocation failed, len=%d",
+				conn, len);
+		}
+		return -ENOBUFS;
 	}
 
 	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int mss = tcp_data_mss(conn);
+	int ret = 0;
+	int pos, len;
+
+	pos = conn->unacked_len;
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   (int)tcp_send_window(conn) - conn->unacked_len,
+		   MAX(mss, TCP_GSO_MAX_SIZE));
+
+	ret = tcp_send_segment(conn, pos, len, mss);
+	if (ret == -ENOBUFS && len > mss) {
+		/* Not enough buffers for a large segment */
+		len = mss;
+		ret = tcp_send_segment(conn, pos, len, mss);
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
@@ -936,21 +1391,182 @@ static int tcp_send_data(struct tcp *conn)
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
+			tcp_rtt_start(conn);
 		}
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
-
 	conn_send_data_dump(conn);
 
- out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Retransmit the first segment the peer has not received, after a
+ * duplicate or a partial ACK.
+ */
+static void tcp_retransmit_lost(struct tcp *conn)
+{
+	int mss = tcp_data_mss(conn);
+	int pos = 0;
+	int len = MIN(conn->unacked_len, mss);
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sacked_num > 0) {
+		uint32_t start, end;
+
+		if (!tcp_sack_next_hole(conn, &start, &end)) {
+			return;
+		}
+
+		pos = start - conn->seq;
+		len = MIN3((int)(end - start), mss, conn->unacked_len - pos);
+		conn->sack_rexmit = start + len;
+	}
+#endif
+
+	if (len <= 0) {
+		return;
+	}
+
+	NET_DBG("conn: %p retransmit seq %u len %d", conn, conn->seq + pos,
+		len);
+
+	if (tcp_send_segment(conn, pos, len, mss) == 0) {
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
+	tcp_rtt_cancel(conn);
+}
+
+static void tcp_cc_init(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	/* Initial window, RFC 3390 */
+	conn->cwnd = MIN(4 * mss, MAX(2 * mss, 4380U));
+	conn->ssthresh = UINT32_MAX;
+	conn->recover = conn->seq - 1;
+	conn->dup_acks = 0;
+	conn->in_recovery = false;
+
+	conn->cc->init(conn);
+}
+
+/* New data has been acknowledged, conn->seq is already updated */
+static void tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->dup_acks = 0;
+
+	if (!conn->in_recovery) {
+		conn->cc->ack(conn, acked);
+		conn->cwnd = MIN(conn->cwnd, TCP_CWND_MAX);
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+		/* Full acknowledgment, deflate the window, RFC 6582 ch 3.2 */
+		conn->in_recovery = false;
+		conn->cwnd = MIN(conn->ssthresh,
+				 MAX((uint32_t)conn->unacked_len, mss) + mss);
+		return;
+	}
+
+	/* Partial acknowledgment: the next segment was lost too */
+	tcp_retransmit_lost(conn);
+
+	conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+	if (acked >= mss) {
+		conn->cwnd += mss;
+	}
+	conn->cwnd = MAX(conn->cwnd, mss);
+}
+
+/* Fast retransmit and fast recovery, RFC 6582 ch 3.2 */
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	if (conn->in_recovery) {
+		conn->cwnd = MIN(conn->cwnd + mss, TCP_CWND_MAX);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->sack_ok) {
+			tcp_retransmit_lost(conn);
+		}
+		return;
+	}
+
+	if (++conn->dup_acks != TCP_DUP_ACK_THRESHOLD) {
+		return;
+	}
+
+	/* Only reduce the window once per window of data */
+	if (net_tcp_seq_cmp(conn->seq, conn->recover) <= 0) {
+		return;
+	}
+
+	NET_DBG("conn: %p fast retransmit, cwnd %u flight %d", conn,
+		conn->cwnd, conn->unacked_len);
+
+	conn->cc->loss(conn);
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->in_recovery = true;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_rexmit = conn->seq;
+#endif
+
+	tcp_retransmit_lost(conn);
+
+	conn->cwnd = conn->ssthresh + TCP_DUP_ACK_THRESHOLD * mss;
+}
+
+/* First retransmission timeout of some data, conn->unacked_len is still
+ * the data in flight.
+ */
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	conn->cc->loss(conn);
+
+	conn->cwnd = conn_mss(conn);
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->in_recovery = false;
+	conn->dup_acks = 0;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The peer may have discarded the data it reported, RFC 2018 ch 8 */
+	conn->sacked_num = 0;
+#endif
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+/* An ACK acknowledging nothing new nor changing the window while data
+ * is in flight, RFC 5681 ch 2
+ */
+static bool tcp_is_dup_ack(struct tcp *conn, struct tcphdr *th, size_t len,
+			   uint32_t prev_win)
+{
+	return IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL) &&
+		th_ack(th) == conn->seq && len == 0 && conn->unacked_len > 0 &&
+		conn->send_win == prev_win &&
+		(th_flags(th) & (SYN | FIN | RST | ACK)) == ACK;
+}
+
+static void tcp_dup_ack(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	tcp_sack_update(conn);
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	tcp_cc_dup_ack(conn);
+#endif
+}
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -979,7 +1595,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 		subscribe = true;
 	}
 
-	if (k_delayed_work_remaining_get(&conn->send_data_timer)) {
+	if (k_delayed_work_remaining_ticks(&conn->send_data_timer)) {
 		subscribe = false;
 	}
 
@@ -995,7 +1611,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 		conn->send_data_retries = 0;
 		k_delayed_work_submit_to_queue(&tcp_work_q,
 					       &conn->send_data_timer,
-					       K_MSEC(tcp_rto));
+					       K_MSEC(tcp_rto_get(conn)));
 	}
  out:
 	return ret;
@@ -1033,6 +1649,13 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (conn->data_mode == TCP_DATA_MODE_SEND) {
+		tcp_cc_timeout(conn);
+	}
+#endif
+	tcp_rtt_cancel(conn);
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1061,7 +1684,7 @@ static void tcp_resend_data(struct k_work *work)
 	}
 
 	k_delayed_work_submit_to_queue(&tcp_work_q, &conn->send_data_timer,
-				       K_MSEC(tcp_rto));
+				       K_MSEC(tcp_rto_get(conn)));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1146,10 +1769,24 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win = tcp_window;
+	conn->recv_win = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ?
+		tcp_window : MIN(tcp_window, UINT16_MAX);
 	conn->seq = (IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 		     IS_ENABLED(CONFIG_NET_TEST)) ? 0 : sys_rand32_get();
 
+	while (conn->rcv_wscale < TCP_WSCALE_MAX &&
+	       (conn->recv_win >> conn->rcv_wscale) > UINT16_MAX) {
+		conn->rcv_wscale++;
+	}
+
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	conn->rto = tcp_rto;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	conn->cc = IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC) ?
+		&tcp_cc_cubic : &tcp_cc_newreno;
+#endif
+
 	sys_slist_init(&conn->send_queue);
 
 	k_delayed_work_init(&conn->send_timer, tcp_send_process);
@@ -1241,12 +1878,22 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 union net_proto_header *proto,
 				 void *user_data)
 {
+	struct net_context *context = user_data;
 	struct tcp *conn;
 	struct tcphdr *th;
 
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
+	/* The connection handler that net_conn_input() matched is the one
+	 * of the connection itself unless it is a listening one, so check
+	 * that connection before searching all of them.
+	 */
+	conn = context->tcp;
+	if (conn != NULL && tcp_conn_cmp(conn, pkt)) {
+		goto in;
+	}
+
 	conn = tcp_conn_search(pkt);
 	if (conn) {
 		goto in;
@@ -1255,7 +1902,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	th = th_get(pkt);
 
 	if (th_flags(th) & SYN && !(th_flags(th) & ACK)) {
-		struct tcp *conn_old = ((struct net_context *)user_data)->tcp;
+		struct tcp *conn_old = context->tcp;
 
 		conn = tcp_conn_new(pkt);
 		if (!conn) {
@@ -1378,6 +2025,37 @@ static bool tcp_validate_seq(struct tcp *conn, struct tcphdr *hdr)
 		(net_tcp_seq_cmp(th_seq(hdr), conn->ack + conn->recv_win) < 0);
 }
 
+/* Enable the options both ends sent in their SYN, conn->recv_options
+ * holds the ones of the peer.
+ */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && opts->wnd_found) {
+		conn->wscale_ok = true;
+		conn->snd_wscale = MIN(opts->window, TCP_WSCALE_MAX);
+	} else {
+		conn->recv_win = MIN(conn->recv_win, UINT16_MAX);
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (opts->ts_found) {
+		conn->ts_ok = true;
+		conn->ts_recent = opts->tsval;
+	}
+#endif
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && opts->sack_perm_found) {
+		conn->sack_ok = true;
+	}
+
+	NET_DBG("conn: %p wscale %d/%d ts %d sack %d", conn,
+		conn->wscale_ok ? conn->snd_wscale : -1,
+		conn->wscale_ok ? conn->rcv_wscale : -1,
+		conn->ts_ok, conn->sack_ok);
+}
+
 static void print_seq_list(struct net_buf *buf)
 {
 	struct net_buf *tmp = buf;
@@ -1511,6 +2189,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint32_t prev_win = conn->send_win;
 	size_t len;
 	int ret;
 
@@ -1542,6 +2221,12 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	/* Timestamps and SACK blocks only apply to the segment carrying them */
+	conn->recv_options.ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->recv_options.sack_num = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -1554,6 +2239,19 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		size_t max_win;
 
 		conn->send_win = ntohs(th_win(th));
+		if (!(th_flags(th) & SYN) && conn->wscale_ok) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		/* Segments without timestamps are accepted, even if the
+		 * option was negotiated.
+		 */
+		if (conn->ts_ok && conn->recv_options.ts_found &&
+		    net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+			conn->ts_recent = conn->recv_options.tsval;
+		}
+#endif
 
 #if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
@@ -1584,6 +2282,7 @@ next_state:
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_options_negotiate(conn);
 			tcp_out(conn, SYN | ACK);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
@@ -1604,6 +2303,9 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_delayed_work_cancel(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_init(conn);
+#endif
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1637,6 +2339,10 @@ next_state:
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+			tcp_options_negotiate(conn);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_init(conn);
+#endif
 			if (len) {
 				if (tcp_data_get(conn, pkt, &len) < 0) {
 					break;
@@ -1704,9 +2410,20 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#if defined(CONFIG_NET_TCP_SACK)
+			tcp_sack_update(conn);
+#endif
+			tcp_rtt_update(conn, th_ack(th));
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			if (conn->data_mode == TCP_DATA_MODE_SEND) {
+				tcp_cc_ack(conn, len_acked);
+			}
+#endif
+
 			conn_send_data_dump(conn);
 
-			if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
+			if (!k_delayed_work_remaining_ticks(
+				    &conn->send_data_timer)) {
 				NET_DBG("conn: %p, Missing a subscription "
 					"of the send_data queue timer", conn);
 				break;
@@ -1728,6 +2445,15 @@ next_state:
 				break;
 			}
 
+			ret = tcp_send_queued_data(conn);
+			if (ret < 0 && ret != -ENOBUFS) {
+				tcp_out(conn, RST);
+				conn_state(conn, TCP_CLOSED);
+				break;
+			}
+		} else if (th && tcp_is_dup_ack(conn, th, len, prev_win)) {
+			tcp_dup_ack(conn);
+
 			ret = tcp_send_queued_data(conn);
 			if (ret < 0 && ret != -ENOBUFS) {
 				tcp_out(conn, RST);
@@ -1748,6 +2474,12 @@ next_state:
 			} else if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
 				tcp_out_of_order_data(conn, pkt, len,
 						      th_seq(th));
+
+				/* Let the peer detect the loss, RFC 5681 ch 4.2 */
+				if (IS_ENABLED(
+					CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+					tcp_out(conn, ACK);
+				}
 			}
 		}
 		break;
@@ -1878,7 +2610,7 @@ int net_tcp_put(struct net_context *context)
 			 */
 			k_delayed_work_submit_to_queue(&tcp_work_q,
 						       &conn->send_data_timer,
-						       K_MSEC(tcp_rto));
+						       K_MSEC(tcp_rto_get(conn)));
 		} else {
 			int ret;
 
@@ -1942,7 +2674,7 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 
 	if (tcp_window_full(conn)) {
 		/* Trigger resend if the timer is not active */
-		if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
+		if (!k_delayed_work_remaining_ticks(&conn->send_data_timer)) {
 			NET_DBG("Window full, trigger resend");
 			tcp_resend_data(&conn->send_data_timer.work);
 		}
@@ -2222,13 +2954,149 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* The segments of a large packet get their checksum once it is
+	 * split, see net_tcp_gso_segment().
+	 */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+#define GSO_BUF_TIMEOUT K_MSEC(100)
+
+static void tcp_gso_seg_attrs(struct net_pkt *pkt, struct net_pkt *seg)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tci(seg, net_pkt_vlan_tci(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	memcpy(&seg->lladdr_src, &pkt->lladdr_src, sizeof(seg->lladdr_src));
+	memcpy(&seg->lladdr_dst, &pkt->lladdr_dst, sizeof(seg->lladdr_dst));
+}
+
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_pkt_cursor payload;
+	size_t hdr_len, len, off;
+	struct tcphdr *th;
+	uint32_t seq;
+	uint8_t flags;
+	int ret, sent = 0;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + th->th_off * 4;
+	len = net_pkt_get_len(pkt) - hdr_len;
+	seq = ntohl(UNALIGNED_GET(&th->th_seq));
+	flags = UNALIGNED_GET(&th->th_flags);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, hdr_len)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_backup(pkt, &payload);
+
+	/* Each segment is a copy of the headers followed by its part of
+	 * the payload. Only the last one keeps the PSH and FIN flags.
+	 */
+	for (off = 0; off < len; off += mss) {
+		size_t seg_len = MIN(len - off, mss);
+		struct net_pkt *seg;
+
+		seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+						hdr_len + seg_len, AF_UNSPEC, 0,
+						GSO_BUF_TIMEOUT);
+		if (!seg) {
+			return -ENOBUFS;
+		}
+
+		tcp_gso_seg_attrs(pkt, seg);
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_copy(seg, pkt, hdr_len)) {
+			goto fail;
+		}
+
+		net_pkt_cursor_restore(pkt, &payload);
+
+		if (net_pkt_copy(seg, pkt, seg_len)) {
+			goto fail;
+		}
+
+		net_pkt_cursor_backup(pkt, &payload);
+
+		net_pkt_cursor_init(seg);
+		net_pkt_set_overwrite(seg, true);
+
+		if (net_pkt_skip(seg, ip_len)) {
+			goto fail;
+		}
+
+		th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+		if (!th) {
+			goto fail;
+		}
+
+		UNALIGNED_PUT(htonl(seq + off), &th->th_seq);
+
+		if (off + seg_len < len) {
+			UNALIGNED_PUT(flags & ~(PSH | FIN), &th->th_flags);
+		}
+
+		if (net_pkt_set_data(seg, &tcp_access) ||
+		    tcp_finalize_pkt(seg) < 0) {
+			goto fail;
+		}
+
+		net_pkt_cursor_init(seg);
+
+		ret = cb(seg, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		sent += ret;
+		continue;
+fail:
+		net_pkt_unref(seg);
+		return -ENOBUFS;
+	}
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control algorithms. The congestion window is counted in
+ * bytes and the times in milliseconds.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+static uint32_t tcp_cc_flight_half(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2, 2U * conn_mss(conn));
+}
+
+/* Slow start and congestion avoidance with byte counting, RFC 5681 ch 3.1
+ * and RFC 3465
+ */
+void tcp_cc_reno_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->cwnd < conn->ssthresh) {
+		conn->cwnd += MIN(acked, mss);
+	} else {
+		conn->cwnd += MAX((uint32_t)((uint64_t)mss * acked / conn->cwnd),
+				  1U);
+	}
+}
+
+static void newreno_init(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void newreno_loss(struct tcp *conn)
+{
+	conn->ssthresh = tcp_cc_flight_half(conn);
+}
+
+const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.ack = tcp_cc_reno_ack,
+	.loss = newreno_loss,
+};
+
+/* CUBIC, RFC 8312, with C = 0.4 and beta = 0.7 */
+#define CUBIC_BETA 717 /* / 1024 */
+#define CUBIC_FAST_CONVERGENCE 870 /* (1 + beta) / 2, / 1024 */
+#define CUBIC_MAX_OFFS (1 << 20) /* ms, keeps offs^3 * 4 * mss in int64 */
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint32_t x = 0;
+	int bit;
+
+	/* The cube root of a 64 bit value fits in 22 bits */
+	for (bit = 21; bit >= 0; bit--) {
+		uint64_t y = x | BIT(bit);
+
+		if (y * y <= a / y) {
+			x = y;
+		}
+	}
+
+	return x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->cc_data.cubic, 0, sizeof(conn->cc_data.cubic));
+}
+
+static void cubic_loss(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->cc_data.cubic;
+
+	cubic->in_epoch = false;
+
+	/* Fast convergence, ch 4.6: release bandwidth to new flows */
+	if (conn->cwnd < cubic->w_last_max) {
+		cubic->w_last_max = conn->cwnd;
+		cubic->w_max = (uint64_t)conn->cwnd * CUBIC_FAST_CONVERGENCE /
+			       1024;
+	} else {
+		cubic->w_last_max = conn->cwnd;
+		cubic->w_max = conn->cwnd;
+	}
+
+	conn->ssthresh = MAX((uint32_t)((uint64_t)conn->cwnd * CUBIC_BETA /
+					1024),
+			     2U * conn_mss(conn));
+}
+
+static void cubic_ack(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cubic *cubic = &conn->cc_data.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t rtt = conn->rtt_valid ? conn->srtt >> 3 : 0;
+	uint32_t target, elapsed;
+	int64_t offs, delta;
+
+	if (conn->cwnd < conn->ssthresh) {
+		tcp_cc_reno_ack(conn, acked);
+		return;
+	}
+
+	if (!cubic->in_epoch) {
+		cubic->in_epoch = true;
+		cubic->epoch_start = now;
+
+		if (conn->cwnd < cubic->w_max) {
+			/* K = cbrt((w_max - cwnd) / C) in segments and s */
+			cubic->k = cubic_root((uint64_t)(cubic->w_max -
+							 conn->cwnd) *
+					      2500000000ULL / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = conn->cwnd;
+		}
+	}
+
+	/* W_cubic(t + RTT) = C * (t + RTT - K)^3 + origin, ch 4.1 */
+	elapsed = now - cubic->epoch_start;
+	offs = CLAMP((int64_t)elapsed + rtt - cubic->k, -CUBIC_MAX_OFFS,
+		     CUBIC_MAX_OFFS);
+	delta = offs * offs * offs / 1000000 * 4 * mss / 10000;
+	target = CLAMP((int64_t)cubic->origin + delta, mss, TCP_CWND_MAX);
+
+	/* TCP friendly region, ch 4.2: do not grow slower than Reno would
+	 * with the same average window, 3 * (1 - beta) / (1 + beta) = 0.529
+	 * segments per RTT.
+	 */
+	if (rtt) {
+		uint64_t w_est = (uint64_t)cubic->w_max * CUBIC_BETA / 1024 +
+				 (uint64_t)elapsed * 529 * mss / (1000 * rtt);
+
+		if (w_est > target) {
+			target = MIN(w_est, TCP_CWND_MAX);
+		}
+	}
+
+	if (target > conn->cwnd) {
+		conn->cwnd += MAX((uint32_t)((uint64_t)(target - conn->cwnd) *
+					     acked / conn->cwnd), 1U);
+	} else {
+		/* Plateau around origin, grow by 1% of a segment per RTT */
+		conn->cwnd += (uint64_t)mss * acked / (100 * conn->cwnd);
+	}
+}
+
+const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.ack = cubic_ack,
+	.loss = cubic_loss,
+};
@@ -114,6 +114,12 @@
 	((_conn)->recv_options.mss_found ?		\
 	 (_conn)->recv_options.mss : (uint16_t)NET_IPV6_MTU)
 
+#if defined(CONFIG_NET_TCP_GSO)
+#define TCP_GSO_MAX_SIZE CONFIG_NET_TCP_GSO_MAX_SIZE
+#else
+#define TCP_GSO_MAX_SIZE 0
+#endif
+
 #define conn_state(_conn, _s)						\
 ({									\
 	NET_DBG("%s->%s",						\
@@ -125,7 +131,7 @@
 #define conn_send_data_dump(_conn)					\
 ({									\
 	NET_DBG("conn: %p total=%zd, unacked_len=%d, "			\
-		"send_win=%hu, mss=%hu",				\
+		"send_win=%u, mss=%hu",				\
 		(_conn), net_pkt_get_len((_conn)->send_data),		\
 		conn->unacked_len, conn->send_win,			\
 		(uint16_t)conn_mss((_conn)));				\
@@ -139,6 +145,19 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+#define TCPOPT_TIMESTAMP	8
+
+#define TCPOLEN_MAXSEG		4
+#define TCPOLEN_WINDOW		3
+#define TCPOLEN_SACK_PERM	2
+#define TCPOLEN_TIMESTAMP	10
+
+#define TCP_OPTIONS_MAX_LEN	40 /* 60 bytes max header - 20 bytes fixed */
+#define TCP_WSCALE_MAX		14 /* RFC 7323, ch 2.3 */
+#define TCP_SACK_MAX_BLOCKS	4
+#define TCP_CWND_MAX		(1U << 30)
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -200,13 +219,58 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+	uint32_t tsval;
+	uint32_t tsecr;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_num;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool ts_found : 1;
+	bool sack_perm_found : 1;
 };
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+struct tcp;
+
+/* Congestion control algorithm. The generic code takes care of slow
+ * start, fast retransmit and fast recovery, the algorithm decides how
+ * the congestion window grows and how much it is reduced on loss.
+ */
+struct tcp_cc_ops {
+	const char *name;
+	/* Reset the algorithm state of a new connection */
+	void (*init)(struct tcp *conn);
+	/* Grow cwnd after acked bytes were acknowledged outside recovery */
+	void (*ack)(struct tcp *conn, uint32_t acked);
+	/* Set ssthresh when a loss is detected */
+	void (*loss)(struct tcp *conn);
+};
+
+struct tcp_cubic {
+	uint32_t w_max;		/* cwnd before the last reduction */
+	uint32_t w_last_max;	/* w_max before the last reduction */
+	uint32_t origin;	/* cwnd the cubic function plateaus at */
+	uint32_t k;		/* ms from epoch_start to reach origin */
+	uint32_t epoch_start;	/* ms, start of the current growth epoch */
+	bool in_epoch;
+};
+
+extern const struct tcp_cc_ops tcp_cc_newreno;
+extern const struct tcp_cc_ops tcp_cc_cubic;
+
+void tcp_cc_reno_ack(struct tcp *conn, uint32_t acked);
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -245,12 +309,45 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_RTT_ESTIMATION)
+	uint32_t srtt;		/* smoothed RTT in ms, scaled by 8 */
+	uint32_t rttvar;	/* RTT variation in ms, scaled by 4 */
+	uint32_t rto;		/* retransmission timeout in ms */
+	uint32_t rtt_seq;	/* sequence number the timed segment ends at */
+	uint32_t rtt_start;	/* ms when the timed segment was sent */
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent;	/* timestamp to echo to the peer */
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	const struct tcp_cc_ops *cc;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover;	/* highest sequence sent when loss detected */
+	union {
+		struct tcp_cubic cubic;
+	} cc_data;
+	uint8_t dup_acks;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sacked[TCP_SACK_MAX_BLOCKS]; /* by start */
+	uint32_t sack_rexmit;	/* next sequence to retransmit in recovery */
+	uint8_t sacked_num;
+#endif
 	uint8_t send_data_retries;
+	uint8_t snd_wscale;	/* shift of the windows the peer advertises */
+	uint8_t rcv_wscale;	/* shift of the windows we advertise */
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool wscale_ok : 1;
+	bool ts_ok : 1;
+	bool sack_ok : 1;
+	bool rtt_valid : 1;
+	bool rtt_timing : 1;
+	bool in_recovery : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -763,6 +763,46 @@ static inline int net_tcp_finalize(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Callback used to pass on the segments of a large TCP packet
+ *
+ * @param seg Segment, owned by the callback
+ * @param user_data User data
+ *
+ * @return Number of bytes sent, negative errno otherwise.
+ */
+typedef int (*net_tcp_gso_cb_t)(struct net_pkt *seg, void *user_data);
+
+/**
+ * @brief Split a large TCP packet in segments of net_pkt_gso_size() bytes
+ * of payload
+ *
+ * The IP and TCP headers are copied to each segment and their lengths,
+ * sequence numbers and checksums are computed. The packet is not
+ * released.
+ *
+ * @param pkt Network packet with a TCP segment larger than its gso_size
+ * @param cb Callback called for each segment, in order
+ * @param user_data User data passed to the callback
+ *
+ * @return Sum of the values returned by the callback on success,
+ *         negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt,
+				      net_tcp_gso_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
@@ -25,6 +25,10 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/socket_can.h>
 
+#if defined(CONFIG_NET_CHKSUM_ARCH) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -489,37 +493,167 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+/* The checksum is computed on the 16-bit words as they are laid out in
+ * memory, and only the folded result is converted to host byte order: the
+ * one's complement sum does not depend on the byte order (RFC 1071).
+ * These give the value of a byte in memory order, depending on whether it
+ * is the first or the second byte of a word.
+ */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CHKSUM_BYTE0(b) ((uint32_t)(b))
+#define CHKSUM_BYTE1(b) ((uint32_t)(b) << 8)
+#else
+#define CHKSUM_BYTE0(b) ((uint32_t)(b) << 8)
+#define CHKSUM_BYTE1(b) ((uint32_t)(b))
+#endif
+
+#if defined(CONFIG_NET_CHKSUM_ARCH) && defined(__SSE2__)
+#define CHKSUM_ARCH_BLOCK 32
+
+/* Sum the blocks of 32 bytes at data. The 32-bit words are widened to
+ * 64-bit lanes, which do not overflow.
+ */
+static uint64_t chksum_arch(const uint8_t *data, size_t blocks)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc0 = zero;
+	__m128i acc1 = zero;
+	uint64_t lanes[2];
+
+	for (; blocks; blocks--, data += CHKSUM_ARCH_BLOCK) {
+		__m128i a = _mm_loadu_si128((const __m128i *)data);
+		__m128i b = _mm_loadu_si128((const __m128i *)(data + 16));
+
+		acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(a, zero));
+		acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(a, zero));
+		acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(b, zero));
+		acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(b, zero));
+	}
 
-	end = data + len - 1;
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc0, acc1));
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	return lanes[0] + lanes[1];
+}
+#elif defined(CONFIG_NET_CHKSUM_ARCH) && \
+	defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+#define CHKSUM_ARCH_BLOCK 16
+
+/* Sum the blocks of 16 bytes at data, which is 4-byte aligned, with the
+ * carry of each addition added back in by the next one.
+ */
+static uint64_t chksum_arch(const uint8_t *data, size_t blocks)
+{
+	uint32_t acc = 0U;
+	uint32_t a, b, c, d;
+
+	__asm__ volatile("1:\n\t"
+			 "ldr %[a], [%[data]], #4\n\t"
+			 "ldr %[b], [%[data]], #4\n\t"
+			 "ldr %[c], [%[data]], #4\n\t"
+			 "ldr %[d], [%[data]], #4\n\t"
+			 "adds %[acc], %[acc], %[a]\n\t"
+			 "adcs %[acc], %[acc], %[b]\n\t"
+			 "adcs %[acc], %[acc], %[c]\n\t"
+			 "adcs %[acc], %[acc], %[d]\n\t"
+			 "adc %[acc], %[acc], #0\n\t"
+			 "subs %[blocks], %[blocks], #1\n\t"
+			 "bne 1b\n\t"
+			 : [acc] "+r" (acc), [data] "+r" (data),
+			   [blocks] "+r" (blocks), [a] "=&r" (a), [b] "=&r" (b),
+			   [c] "=&r" (c), [d] "=&r" (d)
+			 :
+			 : "cc", "memory");
+
+	return acc;
+}
+#endif
+
+/* Return the one's complement sum of the data in memory order. An odd
+ * start address is handled as if the data was preceded by a zero byte,
+ * which swaps the bytes of the sum.
+ */
+static uint16_t chksum_raw(const uint8_t *data, size_t len)
+{
+	bool odd = (uintptr_t)data & 1U;
+	uint64_t acc = 0U;
+
+	if (len == 0U) {
+		return 0U;
+	}
 
+	if (odd) {
+		acc = CHKSUM_BYTE1(*data);
+		data++;
+		len--;
+	}
+
+	if (((uintptr_t)data & 2U) && len >= 2U) {
+		acc += *(const uint16_t *)data;
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+#if defined(CHKSUM_ARCH_BLOCK)
+	if (len >= CHKSUM_ARCH_BLOCK) {
+		acc += chksum_arch(data, len / CHKSUM_ARCH_BLOCK);
+		data += len - len % CHKSUM_ARCH_BLOCK;
+		len %= CHKSUM_ARCH_BLOCK;
+	}
+#endif
+
+	/* 32-bit words in a 64-bit accumulator need no carry handling */
+	while (len >= 16U) {
+		const uint32_t *words = (const uint32_t *)data;
+
+		acc += (uint64_t)words[0] + words[1] + words[2] + words[3];
+		data += 16;
+		len -= 16U;
+	}
+
+	while (len >= 4U) {
+		acc += *(const uint32_t *)data;
+		data += 4;
+		len -= 4U;
+	}
+
+	if (len >= 2U) {
+		acc += *(const uint16_t *)data;
+		data += 2;
+		len -= 2U;
+	}
+
+	if (len) {
+		acc += CHKSUM_BYTE0(*data);
+	}
+
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+
+	return odd ? __bswap_16((uint16_t)acc) : (uint16_t)acc;
+}
+
+static inline uint16_t chksum_add(uint16_t sum, uint16_t val)
+{
+	sum += val;
+	if (sum < val) {
+		sum++;
 	}
 
 	return sum;
 }
 
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	return chksum_add(sum, ntohs(chksum_raw(data, len)));
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
+	uint32_t acc = 0U;
+	bool odd = false;
 	size_t len;
 
 	if (!cur->buf || !cur->pos) {
@@ -528,8 +662,14 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
+	/* A fragment following an odd number of bytes starts with the
+	 * second byte of a word, so its sum is swapped.
+	 */
 	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+		uint16_t tmp = chksum_raw(cur->pos, len);
+
+		acc += odd ? __bswap_16(tmp) : tmp;
+		odd ^= len & 1U;
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -537,21 +677,27 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 		}
 
 		cur->pos = cur->buf->data;
+		len = cur->buf->len;
+	}
 
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
 
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
-		}
-	}
+	return chksum_add(sum, ntohs((uint16_t)acc));
+}
 
-	return sum;
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	uint32_t sum = (uint16_t)~chksum;
+
+	sum += (uint16_t)~chksum_raw(old_data, len);
+	sum += chksum_raw(new_data, len);
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
 }
 
 uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
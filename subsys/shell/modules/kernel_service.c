@@ -214,6 +214,51 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+static void shell_print_bins(const struct shell *shell, const char *name,
+			     const uint32_t *bins, size_t n)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "\t%s:", name);
+	for (size_t i = 0; i < n; i++) {
+		shell_fprintf(shell, SHELL_NORMAL, " %u", bins[i]);
+	}
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static int cmd_kernel_heaps(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	struct sys_heap_runtime_stats stats;
+	bool reset = (argc > 1) && (strcmp(argv[1], "reset") == 0);
+
+	Z_STRUCT_SECTION_FOREACH(k_heap, h) {
+		if (k_heap_runtime_stats_get(h, &stats) != 0) {
+			continue;
+		}
+
+		shell_print(shell,
+			"%p: allocated %zu (peak %zu)\tfree %zu in %u blocks "
+			"(largest %zu)\tfragmentation %u %%",
+			h, stats.allocated_bytes, stats.max_allocated_bytes,
+			stats.free_bytes, stats.free_blocks,
+			stats.largest_free_bytes, stats.fragmentation);
+		shell_print_bins(shell, "free blocks per bucket",
+				 stats.bucket_blocks, stats.nb_buckets);
+#if defined(CONFIG_SYS_HEAP_LATENCY_STATS)
+		shell_print_bins(shell, "alloc cycles (log2 bins)",
+				 stats.alloc_cycles, SYS_HEAP_LATENCY_BINS);
+		shell_print_bins(shell, "free cycles (log2 bins)",
+				 stats.free_cycles, SYS_HEAP_LATENCY_BINS);
+#endif
+		if (reset) {
+			(void)k_heap_runtime_stats_reset_max(h);
+		}
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -242,6 +287,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	SHELL_CMD_ARG(heaps, NULL,
+		      "List k_heap usage statistics.\n"
+		      "Usage: heaps [reset]",
+		      cmd_kernel_heaps, 1, 1),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
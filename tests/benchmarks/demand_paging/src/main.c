@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <sys/mem_manage.h>
+#include <timing/timing.h>
+
+/* Evicts an anonymous memory arena filled with different data patterns
+ * page by page and reports backing store capacity and page-out and page
+ * fault latencies.  See README.rst.
+ */
+
+/* Page frames left to the rest of the system */
+#define SPARE_PAGES 8
+#define MAX_ARENA_PAGES 64
+
+enum pattern {
+	PATTERN_ZERO,
+	PATTERN_TEXT,
+	PATTERN_RANDOM,
+	PATTERN_COUNT,
+};
+
+static const char *const pattern_names[] = {
+	[PATTERN_ZERO] = "zero",
+	[PATTERN_TEXT] = "text",
+	[PATTERN_RANDOM] = "random",
+};
+
+static const char *const words[] = {
+	"page", "frame", "backing", "store", "evict", "fault", "the", "of",
+	"memory", "kernel", "thread", "data", "a", "is", "mapped", "virtual",
+};
+
+static char *arena;
+static size_t arena_pages;
+static uint32_t rand_state = 1;
+
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return rand_state;
+}
+
+static char *page_addr(size_t i)
+{
+	return arena + i * CONFIG_MMU_PAGE_SIZE;
+}
+
+static void fill_text(char *page)
+{
+	size_t pos = 0;
+
+	while (pos < CONFIG_MMU_PAGE_SIZE) {
+		const char *word = words[next_rand() % ARRAY_SIZE(words)];
+
+		while (*word != '\0' && pos < CONFIG_MMU_PAGE_SIZE) {
+			page[pos++] = *word++;
+		}
+		if (pos < CONFIG_MMU_PAGE_SIZE) {
+			page[pos++] = (next_rand() % 8 == 0) ? '\n' : ' ';
+		}
+	}
+}
+
+static void fill(enum pattern pattern)
+{
+	for (size_t i = 0; i < arena_pages; i++) {
+		char *page = page_addr(i);
+
+		switch (pattern) {
+		case PATTERN_ZERO:
+			(void)memset(page, 0, CONFIG_MMU_PAGE_SIZE);
+			break;
+		case PATTERN_TEXT:
+			fill_text(page);
+			break;
+		default:
+			for (size_t j = 0; j < CONFIG_MMU_PAGE_SIZE;
+			     j += sizeof(uint32_t)) {
+				*(uint32_t *)(page + j) = next_rand();
+			}
+			break;
+		}
+	}
+}
+
+/* Evict arena pages until the backing store is full, returns the count */
+static size_t page_out(uint64_t *cycles)
+{
+	timing_t start, end;
+	size_t i;
+
+	*cycles = 0;
+	for (i = 0; i < arena_pages; i++) {
+		int ret;
+
+		start = timing_counter_get();
+		ret = k_mem_page_out(page_addr(i), CONFIG_MMU_PAGE_SIZE);
+		end = timing_counter_get();
+		if (ret != 0) {
+			break;
+		}
+		*cycles += timing_cycles_get(&start, &end);
+	}
+
+	return i;
+}
+
+/* Touch the first @a count arena pages, faulting them back in */
+static void page_in(size_t count, uint64_t *cycles)
+{
+	timing_t start, end;
+
+	*cycles = 0;
+	for (size_t i = 0; i < count; i++) {
+		volatile char *page = page_addr(i);
+
+		start = timing_counter_get();
+		(void)*page;
+		end = timing_counter_get();
+		*cycles += timing_cycles_get(&start, &end);
+	}
+}
+
+static uint32_t avg_ns(uint64_t cycles, size_t count)
+{
+	if (count == 0) {
+		return 0;
+	}
+
+	return (uint32_t)timing_cycles_to_ns_avg(cycles, count);
+}
+
+static void run(enum pattern pattern)
+{
+	uint64_t out_cycles, fault_cycles, clean_cycles, cycles;
+	size_t capacity, clean;
+
+	fill(pattern);
+
+	capacity = page_out(&out_cycles);
+	page_in(capacity, &fault_cycles);
+
+	/* Evict again without modifying the pages since they were paged in */
+	clean = page_out(&clean_cycles);
+	page_in(clean, &cycles);
+	fault_cycles += cycles;
+
+	printk("pattern %-6s: capacity %3zu pages, page-out %6u ns, "
+	       "page fault %6u ns, clean page-out %6u ns\n",
+	       pattern_names[pattern], capacity, avg_ns(out_cycles, capacity),
+	       avg_ns(fault_cycles, capacity + clean),
+	       avg_ns(clean_cycles, clean));
+}
+
+void main(void)
+{
+	size_t free_pages = k_mem_free_get() / CONFIG_MMU_PAGE_SIZE;
+
+	timing_init();
+	timing_start();
+
+	arena_pages = MIN(free_pages - SPARE_PAGES, MAX_ARENA_PAGES);
+	arena = k_mem_map(arena_pages * CONFIG_MMU_PAGE_SIZE, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("failed to map %zu pages\n", arena_pages);
+		return;
+	}
+
+	printk("demand paging benchmark: arena %zu pages\n", arena_pages);
+
+	for (enum pattern pattern = 0; pattern < PATTERN_COUNT; pattern++) {
+		run(pattern);
+	}
+
+	timing_stop();
+}
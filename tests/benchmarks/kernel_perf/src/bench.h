@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KERNEL_PERF_BENCH_H_
+#define KERNEL_PERF_BENCH_H_
+
+#include <zephyr.h>
+#include <timing/timing.h>
+
+#define BENCH_ITERATIONS CONFIG_BENCH_ITERATIONS
+
+/* The runner thread is preemptible, helper threads which wait for
+ * the operation under test have a higher priority so that they run
+ * as soon as they are woken.
+ */
+#define BENCH_PRIO_RUNNER K_PRIO_PREEMPT(10)
+#define BENCH_PRIO_WAITER K_PRIO_PREEMPT(5)
+
+#define BENCH_MAX_THREADS MAX(4, CONFIG_MP_NUM_CPUS)
+#define BENCH_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+/* Each benchmark performs BENCH_ITERATIONS operations and returns the
+ * total number of timing cycles they took
+ */
+typedef uint64_t (*bench_fn_t)(void);
+
+uint64_t bench_sem_give_take(void);
+uint64_t bench_sem_wake(void);
+uint64_t bench_sem_timeout_wake(void);
+uint64_t bench_poll_ready(void);
+uint64_t bench_poll_wake(void);
+uint64_t bench_pipe_put_get(void);
+uint64_t bench_pipe_wake(void);
+uint64_t bench_msgq_put_get(void);
+uint64_t bench_msgq_multi_wake(void);
+uint64_t bench_futex_wake(void);
+uint64_t bench_heap_alloc_free(void);
+uint64_t bench_mem_slab_alloc_free(void);
+uint64_t bench_mutex_lock_work(void);
+uint64_t bench_rwlock_mostly_read(void);
+uint64_t bench_mutex_mostly_read(void);
+uint64_t bench_smp_spinlock(void);
+uint64_t bench_smp_mutex(void);
+
+/* Helper threads, indexed 0 to BENCH_MAX_THREADS - 1 */
+void bench_thread_start(int idx, k_thread_entry_t entry, void *arg,
+			int prio);
+void bench_thread_join(int idx);
+
+/* Contention benchmarks call op(id, i) for i from 0 to
+ * BENCH_ITERATIONS - 1 on threads 0 to CONFIG_MP_NUM_CPUS - 1 at
+ * once, see contend.c.  The result is averaged over the threads.
+ */
+typedef void (*bench_op_t)(int id, int i);
+
+uint64_t bench_contend(bench_op_t op);
+
+/* Pseudo-random numbers for thread id of bench_contend() */
+uint32_t bench_rand(int id);
+
+/* Loop iterations standing in for the work done inside a critical
+ * section and between two of them
+ */
+#define BENCH_CS_WORK 50
+#define BENCH_LOCAL_WORK 100
+
+static inline void bench_work(volatile uint32_t *counter, int n)
+{
+	for (int i = 0; i < n; i++) {
+		(*counter)++;
+	}
+}
+
+#endif /* KERNEL_PERF_BENCH_H_ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Contention harness: runs the operation under test in a loop on one
+ * thread per CPU, all of them started at once, so that on SMP every
+ * CPU hammers the same kernel object.  On a single CPU it measures
+ * the uncontended fast path.
+ */
+
+#include "bench.h"
+
+static bench_op_t op;
+static atomic_t ready;
+static uint64_t totals[CONFIG_MP_NUM_CPUS];
+static uint32_t seeds[CONFIG_MP_NUM_CPUS];
+
+uint32_t bench_rand(int id)
+{
+	seeds[id] = seeds[id] * 1103515245U + 12345U;
+
+	return seeds[id] >> 8;
+}
+
+static void contend_thread(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	timing_t t0, t1;
+
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < CONFIG_MP_NUM_CPUS) {
+	}
+
+	t0 = timing_counter_get();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		op(id, i);
+	}
+	t1 = timing_counter_get();
+
+	totals[id] = timing_cycles_get(&t0, &t1);
+}
+
+uint64_t bench_contend(bench_op_t fn)
+{
+	uint64_t total = 0;
+
+	op = fn;
+	atomic_set(&ready, 0);
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		seeds[i] = i + 1;
+		bench_thread_start(i, contend_thread, INT_TO_POINTER(i),
+				   BENCH_PRIO_WAITER);
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		bench_thread_join(i);
+		total += totals[i];
+	}
+
+	return total / CONFIG_MP_NUM_CPUS;
+}
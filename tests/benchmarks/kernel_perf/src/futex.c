@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Futex benchmark: the time from k_futex_wake() to the return of a
+ * higher priority thread blocked in k_futex_wait().  Futexes are only
+ * available with CONFIG_USERSPACE.
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_USERSPACE
+
+static struct k_futex futex;
+
+static volatile timing_t start, end;
+static uint64_t total;
+
+static void futex_waiter(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_futex_wait(&futex, 0, K_FOREVER);
+		end = timing_counter_get();
+		total += timing_cycles_get(&start, &end);
+	}
+}
+
+uint64_t bench_futex_wake(void)
+{
+	total = 0;
+	atomic_set(&futex.val, 0);
+	bench_thread_start(0, futex_waiter, NULL, BENCH_PRIO_WAITER);
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		start = timing_counter_get();
+		k_futex_wake(&futex, false);
+	}
+
+	bench_thread_join(0);
+	return total;
+}
+
+#endif /* CONFIG_USERSPACE */
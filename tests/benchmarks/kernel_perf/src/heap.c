@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * k_heap benchmark: one thread per CPU randomly allocates 8 to 128
+ * bytes or frees one of its blocks on a shared heap, keeping a few of
+ * them live at any time.  Sized so that allocations never fail.
+ */
+
+#include "bench.h"
+
+#define HEAP_BYTES 16384
+#define SLOTS 16
+
+K_HEAP_DEFINE(heap, HEAP_BYTES);
+
+static void *slots[CONFIG_MP_NUM_CPUS][SLOTS];
+
+static void alloc_free_op(int id, int i)
+{
+	uint32_t r = bench_rand(id);
+	void **slot = &slots[id][r % SLOTS];
+
+	if (*slot != NULL) {
+		k_heap_free(&heap, *slot);
+		*slot = NULL;
+	} else {
+		*slot = k_heap_alloc(&heap, 8 + (r >> 8) % 121, K_NO_WAIT);
+	}
+}
+
+uint64_t bench_heap_alloc_free(void)
+{
+	uint64_t cycles = bench_contend(alloc_free_op);
+
+	for (int id = 0; id < CONFIG_MP_NUM_CPUS; id++) {
+		for (int s = 0; s < SLOTS; s++) {
+			k_heap_free(&heap, slots[id][s]);
+			slots[id][s] = NULL;
+		}
+	}
+
+	return cycles;
+}
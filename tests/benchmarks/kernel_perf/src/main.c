@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Runs all kernel primitive benchmarks, prints the results as JSON and
+ * checks them against the configured baselines.  See README.rst.
+ */
+
+#include <tc_util.h>
+#include "bench.h"
+
+struct bench {
+	const char *name;
+	bench_fn_t fn;
+	uint32_t baseline_ns;
+};
+
+#define BENCH(name, cfg) { #name, bench_##name, CONFIG_BENCH_BASELINE_##cfg }
+
+static const struct bench benches[] = {
+	BENCH(sem_give_take, SEM_GIVE_TAKE),
+	BENCH(sem_wake, SEM_WAKE),
+	BENCH(sem_timeout_wake, SEM_TIMEOUT_WAKE),
+	BENCH(poll_ready, POLL_READY),
+	BENCH(poll_wake, POLL_WAKE),
+	BENCH(pipe_put_get, PIPE_PUT_GET),
+	BENCH(pipe_wake, PIPE_WAKE),
+	BENCH(msgq_put_get, MSGQ_PUT_GET),
+	BENCH(msgq_multi_wake, MSGQ_MULTI_WAKE),
+#ifdef CONFIG_USERSPACE
+	BENCH(futex_wake, FUTEX_WAKE),
+#endif
+	BENCH(heap_alloc_free, HEAP_ALLOC_FREE),
+	BENCH(mem_slab_alloc_free, MEM_SLAB_ALLOC_FREE),
+	BENCH(mutex_lock_work, MUTEX_LOCK_WORK),
+	BENCH(rwlock_mostly_read, RWLOCK_MOSTLY_READ),
+	BENCH(mutex_mostly_read, MUTEX_MOSTLY_READ),
+#if defined(CONFIG_SMP) && (CONFIG_MP_NUM_CPUS > 1)
+	BENCH(smp_spinlock, SMP_SPINLOCK),
+	BENCH(smp_mutex, SMP_MUTEX),
+#endif
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, BENCH_MAX_THREADS,
+				   BENCH_STACK_SIZE);
+static struct k_thread threads[BENCH_MAX_THREADS];
+
+void bench_thread_start(int idx, k_thread_entry_t entry, void *arg,
+			int prio)
+{
+	k_thread_create(&threads[idx], stacks[idx], BENCH_STACK_SIZE,
+			entry, arg, NULL, NULL, prio, 0, K_NO_WAIT);
+}
+
+void bench_thread_join(int idx)
+{
+	k_thread_join(&threads[idx], K_FOREVER);
+}
+
+/* Returns true if the benchmark regressed */
+static bool run(const struct bench *b, bool last)
+{
+	uint64_t cycles = b->fn();
+	uint32_t avg = (uint32_t)(cycles / BENCH_ITERATIONS);
+	uint32_t ns = (uint32_t)timing_cycles_to_ns_avg(cycles,
+							BENCH_ITERATIONS);
+	uint32_t limit = b->baseline_ns +
+		b->baseline_ns * CONFIG_BENCH_REGRESSION_PCT / 100U;
+	const char *status;
+
+	if (b->baseline_ns == 0U) {
+		status = "unchecked";
+	} else if (ns > limit) {
+		status = "regression";
+	} else {
+		status = "pass";
+	}
+
+	printk("    {\"name\": \"%s\", \"cycles\": %u, \"ns\": %u, "
+	       "\"baseline_ns\": %u, \"status\": \"%s\"}%s\n",
+	       b->name, avg, ns, b->baseline_ns, status, last ? "" : ",");
+
+	return ns > limit && b->baseline_ns != 0U;
+}
+
+void main(void)
+{
+	int regressions = 0;
+
+	k_thread_priority_set(k_current_get(), BENCH_PRIO_RUNNER);
+
+	timing_init();
+	timing_start();
+
+	TC_START("Kernel primitive benchmarks");
+
+	printk("{\n  \"suite\": \"kernel_perf\",\n"
+	       "  \"board\": \"%s\",\n  \"cpus\": %d,\n"
+	       "  \"timing_freq_mhz\": %u,\n  \"iterations\": %u,\n"
+	       "  \"regression_pct\": %u,\n  \"results\": [\n",
+	       CONFIG_BOARD, CONFIG_MP_NUM_CPUS, timing_freq_get_mhz(),
+	       BENCH_ITERATIONS, CONFIG_BENCH_REGRESSION_PCT);
+
+	for (int i = 0; i < ARRAY_SIZE(benches); i++) {
+		if (run(&benches[i], i == ARRAY_SIZE(benches) - 1)) {
+			regressions++;
+		}
+	}
+
+	printk("  ],\n  \"regressions\": %d\n}\n", regressions);
+
+	timing_stop();
+
+	TC_END_REPORT(regressions == 0 ? TC_PASS : TC_FAIL);
+}
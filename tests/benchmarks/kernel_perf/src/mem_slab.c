@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Memory slab benchmark: one thread per CPU randomly allocates or
+ * frees one of its blocks on a shared slab, keeping a few of them
+ * live at any time.  Sized so that allocations never fail.
+ */
+
+#include "bench.h"
+
+#define BLOCK_SIZE 128
+#define SLOTS 16
+
+K_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, CONFIG_MP_NUM_CPUS * SLOTS, 4);
+
+static void *slots[CONFIG_MP_NUM_CPUS][SLOTS];
+
+static void alloc_free_op(int id, int i)
+{
+	void **slot = &slots[id][bench_rand(id) % SLOTS];
+
+	if (*slot != NULL) {
+		k_mem_slab_free(&slab, slot);
+		*slot = NULL;
+	} else {
+		(void)k_mem_slab_alloc(&slab, slot, K_NO_WAIT);
+	}
+}
+
+uint64_t bench_mem_slab_alloc_free(void)
+{
+	uint64_t cycles = bench_contend(alloc_free_op);
+
+	for (int id = 0; id < CONFIG_MP_NUM_CPUS; id++) {
+		for (int s = 0; s < SLOTS; s++) {
+			if (slots[id][s] != NULL) {
+				k_mem_slab_free(&slab, &slots[id][s]);
+				slots[id][s] = NULL;
+			}
+		}
+	}
+
+	return cycles;
+}
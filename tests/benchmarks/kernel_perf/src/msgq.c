@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Message queue benchmarks: an uncontended put/get pair, and the time
+ * from a put to the return of one of several higher priority threads
+ * blocked in get, so that the wait queue holds multiple waiters.
+ */
+
+#include "bench.h"
+
+#define N_WAITERS 4
+
+K_MSGQ_DEFINE(msgq, sizeof(uint32_t), 4, 4);
+
+static volatile timing_t start, end;
+static uint64_t total;
+
+uint64_t bench_msgq_put_get(void)
+{
+	uint32_t msg = 0;
+
+	start = timing_counter_get();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_msgq_put(&msgq, &msg, K_NO_WAIT);
+		k_msgq_get(&msgq, &msg, K_NO_WAIT);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end);
+}
+
+/* Waiters exit when they receive UINT32_MAX */
+static void msgq_waiter(void *p1, void *p2, void *p3)
+{
+	uint32_t msg;
+
+	while (true) {
+		k_msgq_get(&msgq, &msg, K_FOREVER);
+		if (msg == UINT32_MAX) {
+			break;
+		}
+		end = timing_counter_get();
+		total += timing_cycles_get(&start, &end);
+	}
+}
+
+uint64_t bench_msgq_multi_wake(void)
+{
+	uint32_t msg = 0;
+
+	total = 0;
+	for (int i = 0; i < N_WAITERS; i++) {
+		bench_thread_start(i, msgq_waiter, NULL, BENCH_PRIO_WAITER);
+	}
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		start = timing_counter_get();
+		k_msgq_put(&msgq, &msg, K_FOREVER);
+	}
+
+	msg = UINT32_MAX;
+	for (int i = 0; i < N_WAITERS; i++) {
+		k_msgq_put(&msgq, &msg, K_FOREVER);
+		bench_thread_join(i);
+	}
+
+	return total;
+}
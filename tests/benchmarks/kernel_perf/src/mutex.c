@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Mutex benchmark: one thread per CPU locks a shared mutex around a
+ * short critical section, then does some work of its own, the case
+ * adaptive spinning is meant for.
+ */
+
+#include "bench.h"
+
+static K_MUTEX_DEFINE(mutex);
+
+static volatile uint32_t shared_counter;
+static volatile uint32_t local_counters[CONFIG_MP_NUM_CPUS];
+
+static void lock_work_op(int id, int i)
+{
+	k_mutex_lock(&mutex, K_FOREVER);
+	bench_work(&shared_counter, BENCH_CS_WORK);
+	k_mutex_unlock(&mutex);
+
+	bench_work(&local_counters[id], BENCH_LOCAL_WORK);
+}
+
+uint64_t bench_mutex_lock_work(void)
+{
+	return bench_contend(lock_work_op);
+}
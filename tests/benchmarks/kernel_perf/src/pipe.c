@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Pipe benchmarks: a buffered put/get pair of a small message, and
+ * the time from a put to the return of a higher priority thread
+ * blocked in get (a direct copy into the reader's buffer).
+ */
+
+#include "bench.h"
+
+#define MSG_SIZE 64
+
+K_PIPE_DEFINE(pipe, 4 * MSG_SIZE, 4);
+
+static uint8_t tx[MSG_SIZE], rx[MSG_SIZE];
+static volatile timing_t start, end;
+static uint64_t total;
+
+uint64_t bench_pipe_put_get(void)
+{
+	size_t n;
+
+	start = timing_counter_get();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_pipe_put(&pipe, tx, MSG_SIZE, &n, MSG_SIZE, K_NO_WAIT);
+		k_pipe_get(&pipe, rx, MSG_SIZE, &n, MSG_SIZE, K_NO_WAIT);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end);
+}
+
+static void pipe_reader(void *p1, void *p2, void *p3)
+{
+	size_t n;
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_pipe_get(&pipe, rx, MSG_SIZE, &n, MSG_SIZE, K_FOREVER);
+		end = timing_counter_get();
+		total += timing_cycles_get(&start, &end);
+	}
+}
+
+uint64_t bench_pipe_wake(void)
+{
+	size_t n;
+
+	total = 0;
+	bench_thread_start(0, pipe_reader, NULL, BENCH_PRIO_WAITER);
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		start = timing_counter_get();
+		k_pipe_put(&pipe, tx, MSG_SIZE, &n, MSG_SIZE, K_FOREVER);
+	}
+
+	bench_thread_join(0);
+	return total;
+}
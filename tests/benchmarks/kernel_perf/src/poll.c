@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * k_poll() benchmarks: polling an already raised signal, and the time
+ * from k_poll_signal_raise() to the return of a higher priority
+ * thread blocked in k_poll().
+ */
+
+#include "bench.h"
+
+static struct k_poll_signal signal = K_POLL_SIGNAL_INITIALIZER(signal);
+static struct k_poll_event event =
+	K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SIGNAL,
+					K_POLL_MODE_NOTIFY_ONLY, &signal, 0);
+
+static volatile timing_t start, end;
+static uint64_t total;
+
+static void poll_rearm(void)
+{
+	k_poll_signal_reset(&signal);
+	event.state = K_POLL_STATE_NOT_READY;
+}
+
+uint64_t bench_poll_ready(void)
+{
+	k_poll_signal_raise(&signal, 0);
+
+	start = timing_counter_get();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_poll(&event, 1, K_NO_WAIT);
+		event.state = K_POLL_STATE_NOT_READY;
+	}
+	end = timing_counter_get();
+
+	poll_rearm();
+	return timing_cycles_get(&start, &end);
+}
+
+static void poll_waiter(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_poll(&event, 1, K_FOREVER);
+		end = timing_counter_get();
+		total += timing_cycles_get(&start, &end);
+		poll_rearm();
+	}
+}
+
+uint64_t bench_poll_wake(void)
+{
+	total = 0;
+	bench_thread_start(0, poll_waiter, NULL, BENCH_PRIO_WAITER);
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		start = timing_counter_get();
+		k_poll_signal_raise(&signal, 0);
+	}
+
+	bench_thread_join(0);
+	return total;
+}
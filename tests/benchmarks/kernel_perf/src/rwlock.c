@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Reader-writer lock benchmarks: one thread per CPU reads shared data
+ * under a k_rwlock, writing it instead once in WRITE_INTERVAL
+ * iterations, then does some work of its own.  The same loop with a
+ * k_mutex serializing the readers is the baseline to compare against.
+ */
+
+#include "bench.h"
+
+#define WRITE_INTERVAL 100
+
+static K_RWLOCK_DEFINE(rwlock);
+static K_MUTEX_DEFINE(mutex);
+
+static volatile uint32_t shared_data[BENCH_CS_WORK];
+static volatile uint32_t local_counters[CONFIG_MP_NUM_CPUS];
+
+static inline bool is_write(int i)
+{
+	return (i % WRITE_INTERVAL) == (WRITE_INTERVAL - 1);
+}
+
+static void read_work(void)
+{
+	volatile uint32_t sum = 0U;
+
+	for (int i = 0; i < BENCH_CS_WORK; i++) {
+		sum += shared_data[i];
+	}
+}
+
+static void write_work(void)
+{
+	for (int i = 0; i < BENCH_CS_WORK; i++) {
+		shared_data[i]++;
+	}
+}
+
+static void rwlock_op(int id, int i)
+{
+	if (is_write(i)) {
+		k_rwlock_write_lock(&rwlock, K_FOREVER);
+		write_work();
+		k_rwlock_write_unlock(&rwlock);
+	} else {
+		k_rwlock_read_lock(&rwlock, K_FOREVER);
+		read_work();
+		k_rwlock_read_unlock(&rwlock);
+	}
+
+	bench_work(&local_counters[id], BENCH_LOCAL_WORK);
+}
+
+static void mutex_op(int id, int i)
+{
+	k_mutex_lock(&mutex, K_FOREVER);
+	if (is_write(i)) {
+		write_work();
+	} else {
+		read_work();
+	}
+	k_mutex_unlock(&mutex);
+
+	bench_work(&local_counters[id], BENCH_LOCAL_WORK);
+}
+
+uint64_t bench_rwlock_mostly_read(void)
+{
+	return bench_contend(rwlock_op);
+}
+
+uint64_t bench_mutex_mostly_read(void)
+{
+	return bench_contend(mutex_op);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Semaphore benchmarks: an uncontended give/take pair, and the time
+ * from a give to the return of a higher priority thread blocked in
+ * take, without and with a timeout (which adds a timeout queue
+ * insertion and removal per operation).
+ */
+
+#include "bench.h"
+
+static K_SEM_DEFINE(sem, 0, 1);
+
+static volatile timing_t start, end;
+static uint64_t total;
+
+uint64_t bench_sem_give_take(void)
+{
+	start = timing_counter_get();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_sem_give(&sem);
+		k_sem_take(&sem, K_NO_WAIT);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end);
+}
+
+static void sem_waiter(void *p1, void *p2, void *p3)
+{
+	k_timeout_t timeout = *(k_timeout_t *)p1;
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		k_sem_take(&sem, timeout);
+		end = timing_counter_get();
+		total += timing_cycles_get(&start, &end);
+	}
+}
+
+static uint64_t sem_wake(k_timeout_t timeout)
+{
+	total = 0;
+	bench_thread_start(0, sem_waiter, &timeout, BENCH_PRIO_WAITER);
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		start = timing_counter_get();
+		k_sem_give(&sem);
+	}
+
+	bench_thread_join(0);
+	return total;
+}
+
+uint64_t bench_sem_wake(void)
+{
+	return sem_wake(K_FOREVER);
+}
+
+uint64_t bench_sem_timeout_wake(void)
+{
+	return sem_wake(K_SECONDS(10));
+}
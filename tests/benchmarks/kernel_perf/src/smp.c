@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * SMP contention benchmarks: one thread per CPU repeatedly takes and
+ * releases the same spinlock or mutex.  The result is the average
+ * time per lock/unlock pair seen by each thread.
+ */
+
+#include "bench.h"
+
+#if defined(CONFIG_SMP) && (CONFIG_MP_NUM_CPUS > 1)
+
+static struct k_spinlock lock;
+static K_MUTEX_DEFINE(mutex);
+
+static volatile uint32_t counter;
+
+static void spinlock_op(int id, int i)
+{
+	k_spinlock_key_t k = k_spin_lock(&lock);
+
+	counter++;
+	k_spin_unlock(&lock, k);
+}
+
+static void mutex_op(int id, int i)
+{
+	k_mutex_lock(&mutex, K_FOREVER);
+	counter++;
+	k_mutex_unlock(&mutex);
+}
+
+uint64_t bench_smp_spinlock(void)
+{
+	return bench_contend(spinlock_op);
+}
+
+uint64_t bench_smp_mutex(void)
+{
+	return bench_contend(mutex_op);
+}
+
+#endif
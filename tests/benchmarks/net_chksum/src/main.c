@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+/* This is an Internet checksum microbenchmark, comparing the cost of
+ * net_calc_chksum() with the checksum computed 16 bits at a time, for
+ * packets of several lengths in one or several fragments.  See README.rst.
+ */
+
+#define N_RUNS 1000
+#define MAX_LEN 1500
+
+struct scenario {
+	uint16_t len;
+	uint16_t frag_len;
+};
+
+static const struct scenario scenarios[] = {
+	{ .len = 64, .frag_len = MAX_LEN },
+	{ .len = 576, .frag_len = MAX_LEN },
+	{ .len = 1500, .frag_len = MAX_LEN },
+	{ .len = 1500, .frag_len = 128 },
+	{ .len = 1500, .frag_len = 127 },
+};
+
+static uint8_t data[MAX_LEN];
+
+extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
+
+static inline uint32_t stamp(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	uint32_t t;
+
+	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
+	return t;
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+/* Checksum of the fragments computed 16 bits at a time, as the stack
+ * used to compute it
+ */
+static uint16_t words_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	const uint8_t *end = data + len - 1;
+	uint16_t tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+static uint16_t legacy_chksum(struct net_buf *frag)
+{
+	const uint8_t *pos = frag->data;
+	size_t len = frag->len;
+	uint16_t sum = 0U;
+
+	while (frag) {
+		sum = words_chksum(sum, pos, len);
+
+		frag = frag->frags;
+		if (!frag) {
+			break;
+		}
+
+		pos = frag->data;
+
+		/* Odd fragment, its last byte pairs with the next one */
+		if (len % 2) {
+			sum += *pos;
+			if (sum < *pos) {
+				sum++;
+			}
+
+			pos++;
+			len = frag->len - 1;
+		} else {
+			len = frag->len;
+		}
+	}
+
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+static struct net_pkt *build_pkt(const struct scenario *s)
+{
+	struct net_pkt *pkt;
+	size_t off;
+
+	pkt = net_pkt_alloc(K_FOREVER);
+
+	/* Without IP header, the ICMPv4 checksum covers all the data of
+	 * the packet.
+	 */
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, 0);
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+
+	for (off = 0; off < s->len; off += s->frag_len) {
+		struct net_buf *frag = net_pkt_get_reserve_tx_data(K_FOREVER);
+
+		net_buf_add_mem(frag, &data[off], MIN(s->frag_len,
+						      s->len - off));
+		net_pkt_frag_add(pkt, frag);
+	}
+
+	return pkt;
+}
+
+static void run_bench(const struct scenario *s)
+{
+	struct net_pkt *pkt = build_pkt(s);
+	uint32_t legacy = UINT32_MAX, current = UINT32_MAX;
+	uint16_t expected, chksum;
+
+	expected = legacy_chksum(pkt->frags);
+
+	for (int run = 0; run < N_RUNS; run++) {
+		uint32_t t0, t1, t2;
+
+		t0 = stamp();
+		(void)legacy_chksum(pkt->frags);
+		t1 = stamp();
+		chksum = net_calc_chksum(pkt, IPPROTO_ICMP);
+		t2 = stamp();
+
+		legacy = MIN(legacy, t1 - t0);
+		current = MIN(current, t2 - t1);
+
+		if (chksum != expected) {
+			printk("Error: checksum 0x%04x, expected 0x%04x\n",
+			       chksum, expected);
+			break;
+		}
+	}
+
+	printk("len %4u frags %2u: legacy %6u current %6u\n", s->len,
+	       (s->len + s->frag_len - 1) / s->frag_len, legacy, current);
+
+	net_pkt_unref(pkt);
+}
+
+void main(void)
+{
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i * 251U + 17U;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(scenarios); i++) {
+		run_bench(&scenarios[i]);
+	}
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/udp.h>
+
+#include "connection.h"
+
+/* This is a connection demultiplexing microbenchmark, measuring the
+ * cost of net_conn_input() for a unicast UDP packet while a given
+ * number of connection handlers are registered.  See README.rst.
+ */
+
+#define MAX_CONNS 1000
+#define N_RUNS 1000
+
+#define LOCAL_PORT 4242
+#define LISTEN_PORT 7
+#define REMOTE_PORT_BASE 10000
+
+static struct net_conn_handle *handles[MAX_CONNS];
+static struct net_conn_handle *listener;
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+
+static struct net_ipv4_hdr ipv4_hdr;
+static struct net_udp_hdr udp_hdr;
+
+static int delivered;
+
+static inline uint32_t stamp(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	uint32_t t;
+
+	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
+	return t;
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* Keep the packet for the next run */
+	delivered++;
+
+	return NET_OK;
+}
+
+/* Remote end of the i-th connection */
+static void remote_end(int i, struct sockaddr_in *addr)
+{
+	addr->sin_family = AF_INET;
+	addr->sin_port = htons(REMOTE_PORT_BASE + i);
+	addr->sin_addr.s4_addr[0] = 198;
+	addr->sin_addr.s4_addr[1] = 51;
+	addr->sin_addr.s4_addr[2] = 100 + i / 256;
+	addr->sin_addr.s4_addr[3] = i % 256;
+}
+
+static void add_conn(int i)
+{
+	struct sockaddr_in remote = { 0 };
+	struct sockaddr_in local = { 0 };
+	int ret;
+
+	remote_end(i, &remote);
+	local.sin_family = AF_INET;
+	net_ipaddr_copy(&local.sin_addr, &local_addr);
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET,
+				(struct sockaddr *)&remote,
+				(struct sockaddr *)&local,
+				REMOTE_PORT_BASE + i, LOCAL_PORT,
+				conn_cb, NULL, &handles[i]);
+	if (ret < 0) {
+		printk("Error: cannot register connection %d (%d)\n", i, ret);
+	}
+}
+
+/* Average cycles to deliver a packet from the remote end of the
+ * connection @a i to @a port
+ */
+static uint32_t run_bench(struct net_pkt *pkt, int i, uint16_t port)
+{
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4_hdr };
+	union net_proto_header proto_hdr = { .udp = &udp_hdr };
+	struct sockaddr_in remote;
+	uint32_t total = 0U;
+
+	remote_end(i, &remote);
+	net_ipaddr_copy(&ipv4_hdr.src, &remote.sin_addr);
+	net_ipaddr_copy(&ipv4_hdr.dst, &local_addr);
+	udp_hdr.src_port = remote.sin_port;
+	udp_hdr.dst_port = htons(port);
+
+	delivered = 0;
+
+	for (int run = 0; run < N_RUNS; run++) {
+		uint32_t t0, t1;
+
+		t0 = stamp();
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+		t1 = stamp();
+
+		total += t1 - t0;
+	}
+
+	if (delivered != N_RUNS) {
+		printk("Error: %d of %d packets delivered\n", delivered,
+		       N_RUNS);
+	}
+
+	return total / N_RUNS;
+}
+
+void main(void)
+{
+	struct sockaddr_in local = { 0 };
+	struct net_if *iface = net_if_get_default();
+	struct net_pkt *pkt;
+	int nconns = 0;
+
+	local.sin_family = AF_INET;
+	if (net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+			      (struct sockaddr *)&local, 0, LISTEN_PORT,
+			      conn_cb, NULL, &listener) < 0) {
+		printk("Error: cannot register listener\n");
+		return;
+	}
+
+	pkt = net_pkt_alloc(K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_iface(pkt, iface);
+
+	for (int target = 1; target <= MAX_CONNS; target *= 10) {
+		uint32_t connected, listening;
+
+		while (nconns < target) {
+			add_conn(nconns++);
+		}
+
+		connected = run_bench(pkt, 0, LOCAL_PORT);
+		listening = run_bench(pkt, nconns, LISTEN_PORT);
+
+		printk("conns %4d: connected %6u listener %6u\n", nconns,
+		       connected, listening);
+	}
+
+	for (int i = 0; i < nconns; i++) {
+		net_conn_unregister(handles[i]);
+	}
+	net_conn_unregister(listener);
+	net_pkt_unref(pkt);
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_core.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#include "connection.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* This is a receive path benchmark, measuring the cost of pushing UDP
+ * packets up the stack one at a time with net_recv_data() and in
+ * batches with net_recv_data_list().  See README.rst.
+ */
+
+#define LOCAL_PORT 4242
+#define REMOTE_PORT 4243
+#define PAYLOAD_LEN 64
+
+#define N_PKTS 4096
+#define MAX_BATCH 64
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr remote_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_conn_handle *handle;
+static K_SEM_DEFINE(batch_done, 0, 1);
+static int expected;
+static int delivered;
+
+static inline uint32_t stamp(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	uint32_t t;
+
+	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
+	return t;
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static enum net_verdict udp_cb(struct net_conn *conn, struct net_pkt *pkt,
+			       union net_ip_header *ip_hdr,
+			       union net_proto_header *proto_hdr,
+			       void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	net_pkt_unref(pkt);
+
+	if (++delivered == expected) {
+		k_sem_give(&batch_done);
+	}
+
+	return NET_OK;
+}
+
+#if defined(CONFIG_NET_L2_DUMMY)
+
+static uint8_t mac_addr[6] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_rx_batch_bench, "net_rx_batch_bench",
+		bench_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static struct net_pkt *prepare_pkt(struct net_if *iface)
+{
+	static uint8_t payload[PAYLOAD_LEN];
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(payload), AF_INET,
+					   IPPROTO_UDP, K_FOREVER);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &remote_addr, &local_addr) ||
+	    net_udp_create(pkt, htons(REMOTE_PORT), htons(LOCAL_PORT)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+/* Average cycles to deliver a packet when N_PKTS packets are received
+ * in batches of @a batch, the packets of each batch being passed to the
+ * stack as a list if @a list is set or one by one otherwise.
+ */
+static uint32_t run_bench(struct net_if *iface, int batch, bool list)
+{
+	struct net_pkt *pkts[MAX_BATCH];
+	uint64_t total = 0U;
+
+	for (int n = 0; n < N_PKTS; n += batch) {
+		sys_slist_t rx_list;
+		uint32_t t0, t1;
+
+		for (int i = 0; i < batch; i++) {
+			pkts[i] = prepare_pkt(iface);
+		}
+
+		expected = batch;
+		delivered = 0;
+
+		t0 = stamp();
+
+		if (list) {
+			sys_slist_init(&rx_list);
+
+			for (int i = 0; i < batch; i++) {
+				sys_slist_append(&rx_list, &pkts[i]->rx_node);
+			}
+
+			if (net_recv_data_list(iface, &rx_list) < 0) {
+				printk("Error: cannot receive batch\n");
+			}
+		} else {
+			for (int i = 0; i < batch; i++) {
+				if (net_recv_data(iface, pkts[i]) < 0) {
+					printk("Error: cannot receive "
+					       "packet\n");
+				}
+			}
+		}
+
+		if (k_sem_take(&batch_done, K_SECONDS(1)) < 0) {
+			printk("Error: %d of %d packets delivered\n",
+			       delivered, batch);
+		}
+
+		t1 = stamp();
+
+		total += t1 - t0;
+	}
+
+	return total / N_PKTS;
+}
+
+void main(void)
+{
+	struct net_if *iface;
+	struct sockaddr_in local = { 0 };
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	net_if_ipv4_addr_add(iface, &local_addr, NET_ADDR_MANUAL, 0);
+
+	local.sin_family = AF_INET;
+	if (net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+			      (struct sockaddr *)&local, 0, LOCAL_PORT,
+			      udp_cb, NULL, &handle) < 0) {
+		printk("Error: cannot register connection\n");
+		return;
+	}
+
+	for (int batch = 1; batch <= MAX_BATCH; batch *= 4) {
+		uint32_t single, list;
+
+		single = run_bench(iface, batch, false);
+		list = run_bench(iface, batch, true);
+
+		printk("batch %2d: single %6u list %6u cycles per packet\n",
+		       batch, single, list);
+	}
+
+	net_conn_unregister(handle);
+}
+
+#else /* CONFIG_NET_L2_DUMMY */
+
+#define RUN_SECONDS 10
+
+/* Count the UDP packets sent to LOCAL_PORT of a real interface, such as
+ * eth_native_posix, and print the rate received every second.
+ */
+void main(void)
+{
+	struct sockaddr_in local = { 0 };
+	int last = 0;
+
+	local.sin_family = AF_INET;
+	if (net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+			      (struct sockaddr *)&local, 0, LOCAL_PORT,
+			      udp_cb, NULL, &handle) < 0) {
+		printk("Error: cannot register connection\n");
+		return;
+	}
+
+	expected = -1;
+
+	for (int i = 0; i < RUN_SECONDS; i++) {
+		int count;
+
+		k_sleep(K_SECONDS(1));
+
+		count = delivered;
+		printk("%d packets per second\n", count - last);
+		last = count;
+	}
+
+	net_conn_unregister(handle);
+}
+
+#endif /* CONFIG_NET_L2_DUMMY */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/ring_buffer.h>
+
+/* Ring buffer throughput benchmark, see README.rst */
+
+#define RECORD_SIZE 16
+#define RECORDS 16
+#define ITERS 5000
+#define NTHREADS (CONFIG_MP_NUM_CPUS + 1)
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+RING_BUF_DECLARE(locked_ring, RECORD_SIZE * RECORDS);
+static struct k_spinlock locked_ring_lock;
+
+RING_BUF_MP_DECLARE(mp_ring, RECORD_SIZE, 4);
+
+K_THREAD_STACK_ARRAY_DEFINE(stacks, NTHREADS, STACK_SIZE);
+static struct k_thread threads[NTHREADS];
+
+struct bench_ops {
+	const char *name;
+	bool (*put)(const uint8_t *rec);
+	bool (*get)(uint8_t *rec);
+};
+
+static bool locked_put(const uint8_t *rec)
+{
+	k_spinlock_key_t key = k_spin_lock(&locked_ring_lock);
+	bool ok = ring_buf_space_get(&locked_ring) >= RECORD_SIZE;
+
+	if (ok) {
+		ring_buf_put(&locked_ring, rec, RECORD_SIZE);
+	}
+	k_spin_unlock(&locked_ring_lock, key);
+
+	return ok;
+}
+
+static bool locked_get(uint8_t *rec)
+{
+	k_spinlock_key_t key = k_spin_lock(&locked_ring_lock);
+	uint32_t n = ring_buf_get(&locked_ring, rec, RECORD_SIZE);
+
+	k_spin_unlock(&locked_ring_lock, key);
+
+	return n == RECORD_SIZE;
+}
+
+static bool mp_put(const uint8_t *rec)
+{
+	return ring_buf_mp_put(&mp_ring, rec, RECORD_SIZE) == 0;
+}
+
+static bool mp_get(uint8_t *rec)
+{
+	return ring_buf_mp_get(&mp_ring, rec, RECORD_SIZE) == RECORD_SIZE;
+}
+
+static const struct bench_ops benches[] = {
+	{ "locked ring_buf     ", locked_put, locked_get },
+	{ "lock-free ring_buf_mp", mp_put, mp_get },
+};
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	const struct bench_ops *ops = p1;
+	uint8_t rec[RECORD_SIZE] = { 0 };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERS; i++) {
+		rec[0] = (uint8_t)i;
+		while (!ops->put(rec)) {
+			k_yield();
+		}
+	}
+}
+
+static void run_bench(const struct bench_ops *ops, int nthreads)
+{
+	uint8_t rec[RECORD_SIZE];
+	uint32_t start, elapsed, n = 0U;
+	int prio = k_thread_priority_get(k_current_get());
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				(void *)ops, NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	while (n < nthreads * ITERS) {
+		if (ops->get(rec)) {
+			n++;
+		} else {
+			k_yield();
+		}
+	}
+
+	elapsed = k_cycle_get_32() - start;
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	printk("%s: producers %2d: %u records in %u cycles (%u cycles/record)\n",
+	       ops->name, nthreads, n, elapsed, elapsed / n);
+}
+
+void main(void)
+{
+	for (int n = 1; n <= NTHREADS; n++) {
+		for (int b = 0; b < ARRAY_SIZE(benches); b++) {
+			run_bench(&benches[b], n);
+		}
+	}
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+
+/* Times system calls made by a user thread on static and dynamic kernel
+ * objects.  See README.rst.
+ */
+
+#define ITERATIONS 10000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+/* Dynamic objects allocated besides the benchmarked ones, so that looking
+ * them up is not a trivially shallow tree search
+ */
+#define FILLER_OBJECTS 32
+
+enum op {
+	OP_NONE,
+	OP_SEM_GIVE,
+	OP_MSGQ_PUT_GET,
+};
+
+K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread user_thread;
+
+K_SEM_DEFINE(static_sem, 0, UINT_MAX);
+K_MSGQ_DEFINE(static_msgq, sizeof(uint32_t), 1, 4);
+
+static char __aligned(4) dyn_msgq_buf[sizeof(uint32_t)];
+
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	enum op op = (enum op)(uintptr_t)p1;
+	uint32_t msg = 0U;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		switch (op) {
+		case OP_SEM_GIVE:
+			k_sem_give(p2);
+			break;
+		case OP_MSGQ_PUT_GET:
+			(void)k_msgq_put(p2, &msg, K_NO_WAIT);
+			(void)k_msgq_get(p2, &msg, K_NO_WAIT);
+			break;
+		default:
+			return;
+		}
+	}
+}
+
+static uint64_t run(enum op op, void *obj)
+{
+	timing_t start, end;
+
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, user_entry,
+			(void *)(uintptr_t)op, obj, NULL,
+			K_PRIO_PREEMPT(0), K_USER, K_FOREVER);
+	if (obj != NULL) {
+		k_object_access_grant(obj, &user_thread);
+	}
+
+	start = timing_counter_get();
+	k_thread_start(&user_thread);
+	k_thread_join(&user_thread, K_FOREVER);
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end);
+}
+
+static void report(const char *name, enum op op, void *obj,
+		   uint64_t overhead)
+{
+	uint64_t cycles = run(op, obj);
+	unsigned int calls = ITERATIONS * (op == OP_MSGQ_PUT_GET ? 2 : 1);
+
+	cycles = cycles > overhead ? cycles - overhead : 0;
+	printk("%-16s: %6u ns/call\n", name,
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, calls));
+}
+
+void main(void)
+{
+	struct k_sem *dyn_sem;
+	struct k_msgq *dyn_msgq;
+	uint64_t overhead;
+
+	for (int i = 0; i < FILLER_OBJECTS; i++) {
+		if (k_object_alloc(K_OBJ_SEM) == NULL) {
+			printk("failed to allocate filler objects\n");
+			return;
+		}
+	}
+
+	dyn_sem = k_object_alloc(K_OBJ_SEM);
+	dyn_msgq = k_object_alloc(K_OBJ_MSGQ);
+	if (dyn_sem == NULL || dyn_msgq == NULL) {
+		printk("failed to allocate objects\n");
+		return;
+	}
+	k_sem_init(dyn_sem, 0, UINT_MAX);
+	k_msgq_init(dyn_msgq, dyn_msgq_buf, sizeof(uint32_t), 1);
+
+	timing_init();
+	timing_start();
+
+	printk("syscall object validation benchmark, object cache %s\n",
+	       IS_ENABLED(CONFIG_USERSPACE_OBJ_CACHE) ? "on" : "off");
+
+	overhead = run(OP_NONE, NULL);
+
+	report("static sem", OP_SEM_GIVE, &static_sem, overhead);
+	report("dynamic sem", OP_SEM_GIVE, dyn_sem, overhead);
+	report("static msgq", OP_MSGQ_PUT_GET, &static_msgq, overhead);
+	report("dynamic msgq", OP_MSGQ_PUT_GET, dyn_msgq, overhead);
+
+	timing_stop();
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_context.h>
+#include <net/net_ip.h>
+#include <net/net_config.h>
+
+/* This is a TCP bulk send benchmark: the data is sent to a sink on the
+ * peer, which measures the throughput.  See README.rst.
+ */
+
+#define PEER_PORT 4242
+
+#define TRANSFER_BYTES (16 * 1024 * 1024)
+#define TRANSFER_TIMEOUT_MS (600 * MSEC_PER_SEC)
+#define CHUNK 16384
+
+static const uint8_t payload[CHUNK];
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PEER_PORT),
+	};
+	struct net_context *ctx;
+	size_t sent = 0;
+	int64_t start;
+	int ret;
+
+	if (net_addr_pton(AF_INET, CONFIG_NET_CONFIG_PEER_IPV4_ADDR,
+			  &addr.sin_addr) < 0) {
+		printk("Error: invalid peer address\n");
+		return;
+	}
+
+	printk("gso %s, tso %s, sending %u bytes to %s:%u\n",
+	       IS_ENABLED(CONFIG_NET_TCP_GSO) ? "on" : "off",
+	       net_if_need_tcp_segmentation(net_if_get_default()) ?
+	       "off" : "on", TRANSFER_BYTES,
+	       CONFIG_NET_CONFIG_PEER_IPV4_ADDR, PEER_PORT);
+
+	if (net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx) < 0) {
+		printk("Error: cannot get the context\n");
+		return;
+	}
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&addr, sizeof(addr),
+				  NULL, K_SECONDS(10), NULL);
+	if (ret < 0) {
+		printk("Error: cannot connect (%d)\n", ret);
+		goto out;
+	}
+
+	start = k_uptime_get();
+
+	while (sent < TRANSFER_BYTES) {
+		ret = net_context_send(ctx, payload,
+				       MIN(CHUNK, TRANSFER_BYTES - sent),
+				       NULL, K_NO_WAIT, NULL);
+		if (ret == -EAGAIN || ret == -ENOBUFS) {
+			if (k_uptime_get() - start > TRANSFER_TIMEOUT_MS) {
+				printk("Error: timeout after %u bytes\n",
+				       (uint32_t)sent);
+				goto out;
+			}
+
+			/* Window full, let the ACKs come in */
+			k_sleep(K_TICKS(1));
+			continue;
+		} else if (ret < 0) {
+			printk("Error: send failed (%d)\n", ret);
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+	printk("sent %u bytes\n", (uint32_t)sent);
+
+out:
+	net_context_put(ctx);
+
+	/* Let the FIN go out */
+	k_msleep(MSEC_PER_SEC);
+}
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include <net/net_ip.h>
+#include <net/ethernet.h>
+
+/* This is a TCP bulk transfer benchmark: a client and a server on the
+ * loopback address exchange their segments through a delay line that
+ * models a link with a given bandwidth, latency and loss rate.  See
+ * README.rst.
+ */
+
+#define LINK_KBPS 20000
+#define LINK_QUEUE_BYTES (256 * 1024)
+#define RING_SIZE 1024
+
+#define TRANSFER_BYTES (1024 * 1024)
+#define TRANSFER_TIMEOUT_MS (120 * MSEC_PER_SEC)
+#define CHUNK 4096
+
+/* Bytes the application keeps in flight on top of the receive window,
+ * as a socket send buffer would.
+ */
+#define SEND_BUF_BYTES (CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE + 16 * 1024)
+
+#define SERVER_PORT_BASE 5000
+
+extern int (*tcp_send_cb)(struct net_pkt *pkt);
+
+struct scenario {
+	uint32_t delay_ms;
+	uint32_t loss_permille;
+};
+
+static const struct scenario scenarios[] = {
+	{ .delay_ms = 1, .loss_permille = 0 },
+	{ .delay_ms = 10, .loss_permille = 0 },
+	{ .delay_ms = 40, .loss_permille = 0 },
+	{ .delay_ms = 10, .loss_permille = 1 },
+	{ .delay_ms = 10, .loss_permille = 10 },
+};
+
+/* One direction of the link: a drop-tail queue in front of a wire of
+ * LINK_KBPS with a fixed propagation delay.
+ */
+struct link {
+	uint64_t free_ns;
+	uint32_t head;
+	uint32_t tail;
+	struct {
+		struct net_pkt *pkt;
+		int64_t due;
+	} ring[RING_SIZE];
+};
+
+static struct link links[2];
+static struct k_spinlock link_lock;
+static K_SEM_DEFINE(link_sem, 0, 1);
+
+static const struct scenario *current;
+static uint16_t server_port;
+static uint32_t rand_state;
+static uint32_t segs_sent, segs_lost, segs_dropped;
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+static size_t received;
+
+static struct in_addr loopback_addr = { { { 127, 0, 0, 1 } } };
+
+static const uint8_t payload[CHUNK];
+
+#define LINK_THREAD_STACK_SIZE 2048
+static K_THREAD_STACK_DEFINE(link_thread_stack, LINK_THREAD_STACK_SIZE);
+static struct k_thread link_thread;
+
+/* Fixed seed so that the runs are repeatable */
+static uint32_t rand_next(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Return the TCP payload length of @a pkt and whether it goes from the
+ * client to the server
+ */
+static size_t tcp_payload(struct net_pkt *pkt, bool *upstream)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t len = 0;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, NET_IPV4H_LEN) == 0) {
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt,
+								 &tcp_access);
+		if (tcp_hdr) {
+			*upstream = tcp_hdr->dst_port == htons(server_port);
+			len = net_pkt_get_len(pkt) - NET_IPV4H_LEN -
+			      (tcp_hdr->offset >> 4) * 4;
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return len;
+}
+
+static int link_send(struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	bool upstream = false;
+	size_t payload = tcp_payload(pkt, &upstream);
+	struct link *link = &links[upstream ? 0 : 1];
+	k_spinlock_key_t key = k_spin_lock(&link_lock);
+	uint64_t now = k_ticks_to_ns_floor64(k_uptime_ticks());
+	uint64_t backlog;
+
+	if (upstream && payload > 0) {
+		segs_sent++;
+
+		if (current->loss_permille &&
+		    rand_next() % 1000 < current->loss_permille) {
+			segs_lost++;
+			goto drop;
+		}
+	}
+
+	link->free_ns = MAX(link->free_ns, now);
+	backlog = (link->free_ns - now) * LINK_KBPS / 8000000;
+
+	if (backlog + len > LINK_QUEUE_BYTES ||
+	    link->tail - link->head == RING_SIZE) {
+		segs_dropped++;
+		goto drop;
+	}
+
+	link->free_ns += (uint64_t)len * 8000000 / LINK_KBPS;
+	link->ring[link->tail % RING_SIZE].pkt = pkt;
+	link->ring[link->tail % RING_SIZE].due =
+		k_ns_to_ticks_ceil64(link->free_ns +
+				     (uint64_t)current->delay_ms * NSEC_PER_USEC *
+				     USEC_PER_MSEC);
+	link->tail++;
+
+	k_spin_unlock(&link_lock, key);
+	k_sem_give(&link_sem);
+
+	return 0;
+
+drop:
+	k_spin_unlock(&link_lock, key);
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+/* Deliver the packets at the far end of the links once they are due */
+static void link_deliver(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct net_pkt *pkt = NULL;
+		int64_t due = INT64_MAX;
+		k_spinlock_key_t key;
+
+		key = k_spin_lock(&link_lock);
+
+		for (int i = 0; i < ARRAY_SIZE(links); i++) {
+			struct link *link = &links[i];
+			int64_t t;
+
+			if (link->head == link->tail) {
+				continue;
+			}
+
+			t = link->ring[link->head % RING_SIZE].due;
+			if (t <= k_uptime_ticks()) {
+				pkt = link->ring[link->head % RING_SIZE].pkt;
+				link->head++;
+				break;
+			}
+
+			due = MIN(due, t);
+		}
+
+		k_spin_unlock(&link_lock, key);
+
+		if (pkt) {
+			if (net_send_data(pkt) < 0) {
+				net_pkt_unref(pkt);
+			}
+			continue;
+		}
+
+		(void)k_sem_take(&link_sem, due == INT64_MAX ? K_FOREVER :
+				 K_TIMEOUT_ABS_TICKS(due));
+	}
+}
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status, void *user_data)
+{
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	if (!pkt) {
+		net_context_put(context);
+		return;
+	}
+
+	received += net_pkt_remaining_data(pkt);
+	if (received >= TRANSFER_BYTES) {
+		k_sem_give(&done_sem);
+	}
+
+	net_pkt_unref(pkt);
+}
+
+static void accept_cb(struct net_context *context, struct sockaddr *addr,
+		      socklen_t addrlen, int status, void *user_data)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addrlen);
+	ARG_UNUSED(user_data);
+
+	if (status < 0) {
+		return;
+	}
+
+	(void)net_context_recv(context, recv_cb, K_NO_WAIT, NULL);
+}
+
+/* Transfer TRANSFER_BYTES from the client to the server and return the
+ * time it took in ms, or a negative value on failure.
+ */
+static int64_t run_bench(uint16_t port)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+	};
+	struct net_context *server, *client;
+	size_t sent = 0;
+	int64_t start, elapsed = -1;
+	int ret;
+
+	net_ipaddr_copy(&addr.sin_addr, &loopback_addr);
+	server_port = port;
+	received = 0;
+	k_sem_reset(&done_sem);
+
+	if (net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &server) < 0 ||
+	    net_context_bind(server, (struct sockaddr *)&addr,
+			     sizeof(addr)) < 0 ||
+	    net_context_listen(server, 1) < 0 ||
+	    net_context_accept(server, accept_cb, K_NO_WAIT, NULL) < 0) {
+		printk("Error: cannot set up the server\n");
+		return -1;
+	}
+
+	if (net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &client) < 0) {
+		printk("Error: cannot get the client context\n");
+		net_context_put(server);
+		return -1;
+	}
+
+	ret = net_context_connect(client, (struct sockaddr *)&addr,
+				  sizeof(addr), NULL, K_SECONDS(10), NULL);
+	if (ret < 0) {
+		printk("Error: cannot connect (%d)\n", ret);
+		goto out;
+	}
+
+	start = k_uptime_get();
+
+	while (sent < TRANSFER_BYTES) {
+		if (sent - received < SEND_BUF_BYTES) {
+			ret = net_context_send(client, payload,
+					       MIN(CHUNK, TRANSFER_BYTES - sent),
+					       NULL, K_NO_WAIT, NULL);
+		} else {
+			ret = -EAGAIN;
+		}
+
+		if (ret == -EAGAIN || ret == -ENOBUFS) {
+			if (k_uptime_get() - start > TRANSFER_TIMEOUT_MS) {
+				goto out;
+			}
+
+			/* Window full, let the ACKs come in */
+			k_sleep(K_TICKS(1));
+			continue;
+		} else if (ret < 0) {
+			printk("Error: send failed (%d)\n", ret);
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+	if (k_sem_take(&done_sem, K_MSEC(TRANSFER_TIMEOUT_MS)) == 0) {
+		elapsed = k_uptime_get() - start;
+	}
+
+out:
+	net_context_put(client);
+	net_context_put(server);
+
+	return elapsed;
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+
+	if (!net_if_ipv4_addr_add(iface, &loopback_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Error: cannot add the loopback address\n");
+		return;
+	}
+
+	/* Full sized segments, as on ethernet */
+	net_if_set_mtu(iface, NET_ETH_MTU);
+
+	k_thread_create(&link_thread, link_thread_stack,
+			K_THREAD_STACK_SIZEOF(link_thread_stack),
+			link_deliver, NULL, NULL, NULL,
+			K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+	tcp_send_cb = link_send;
+
+	printk("link %u kbit/s, %u byte queue, %u bytes per transfer\n",
+	       LINK_KBPS, LINK_QUEUE_BYTES, TRANSFER_BYTES);
+
+	for (int i = 0; i < ARRAY_SIZE(scenarios); i++) {
+		int64_t elapsed;
+
+		current = &scenarios[i];
+		rand_state = 0x12345678U;
+		segs_sent = segs_lost = segs_dropped = 0U;
+
+		elapsed = run_bench(SERVER_PORT_BASE + i);
+
+		printk("delay %3u ms loss %2u.%u%%: ", current->delay_ms,
+		       current->loss_permille / 10,
+		       current->loss_permille % 10);
+
+		if (elapsed <= 0) {
+			printk("timeout after %u of %u bytes\n",
+			       (uint32_t)received, TRANSFER_BYTES);
+		} else {
+			printk("goodput %6u kbit/s, %u segments, %u lost, "
+			       "%u dropped\n",
+			       (uint32_t)((uint64_t)TRANSFER_BYTES * 8 /
+					  elapsed),
+			       segs_sent, segs_lost, segs_dropped);
+		}
+
+		/* Let the connections close before the next run */
+		k_msleep(MSEC_PER_SEC);
+	}
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+
+/* This is a timeout queue microbenchmark, measuring the cost of
+ * adding, querying and aborting a timeout while a given number of
+ * other timeouts are pending.  See README.rst.
+ */
+
+#define MAX_PENDING 10000
+#define N_RUNS 100
+
+/* Expiries between 1 and ~100 seconds away at the default tick rates,
+ * so that nothing fires while we measure
+ */
+#define MIN_TICKS (CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+#define SPAN_TICKS (100 * CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+
+static struct _timeout pending[MAX_PENDING];
+static struct _timeout probe;
+
+static uint32_t rand_state = 1;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static k_timeout_t rand_timeout(void)
+{
+	return K_TICKS(MIN_TICKS + next_rand() % SPAN_TICKS);
+}
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	printk("Error: timeout %p expired during the benchmark\n", t);
+}
+
+static inline uint32_t stamp(void)
+{
+#ifdef CONFIG_X86
+	uint32_t t;
+
+	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
+	return t;
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static void run_bench(int npending)
+{
+	uint32_t add = 0U, rem = 0U, abort = 0U;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		k_timeout_t timeout = rand_timeout();
+		uint32_t t0, t1, t2, t3;
+
+		t0 = stamp();
+		z_add_timeout(&probe, dummy_fn, timeout);
+		t1 = stamp();
+		(void)z_timeout_remaining(&probe);
+		t2 = stamp();
+		z_abort_timeout(&probe);
+		t3 = stamp();
+
+		add += t1 - t0;
+		rem += t2 - t1;
+		abort += t3 - t2;
+	}
+
+	printk("pending %5d: add %6u abort %6u remaining %6u\n", npending,
+	       add / N_RUNS, abort / N_RUNS, rem / N_RUNS);
+}
+
+void main(void)
+{
+	int npending = 0;
+
+	for (int target = 10; target <= MAX_PENDING; target *= 10) {
+		while (npending < target) {
+			z_init_timeout(&pending[npending]);
+			z_add_timeout(&pending[npending], dummy_fn,
+				      rand_timeout());
+			npending++;
+		}
+		run_bench(npending);
+	}
+
+	for (int i = 0; i < npending; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+}
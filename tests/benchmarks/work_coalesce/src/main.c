@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Runs a set of periodic delayed work items with different expiry
+ * slacks and reports wakeups from idle per second.  See README.rst.
+ */
+
+#define N_WORKS 64
+#define RUN_MS 5000
+#define MIN_PERIOD_MS 100
+#define SPAN_PERIOD_MS 400
+
+struct periodic_work {
+	struct k_delayed_work work;
+	uint32_t period_ms;
+};
+
+static struct periodic_work works[N_WORKS];
+static atomic_t runs;
+
+static const uint32_t slacks_ms[] = { 0, 1, 5, 20, 50 };
+
+static uint32_t rand_state = 1;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void periodic_handler(struct k_work *work)
+{
+	struct periodic_work *pw = CONTAINER_OF(work, struct periodic_work,
+						work.work);
+
+	atomic_inc(&runs);
+	k_delayed_work_submit(&pw->work, K_MSEC(pw->period_ms));
+}
+
+static void run(uint32_t slack_ms)
+{
+	uint32_t wakeups;
+
+	for (int i = 0; i < N_WORKS; i++) {
+		k_delayed_work_init(&works[i].work, periodic_handler);
+		k_delayed_work_slack_set(&works[i].work, K_MSEC(slack_ms));
+		works[i].period_ms = MIN_PERIOD_MS +
+			next_rand() % SPAN_PERIOD_MS;
+		k_delayed_work_submit(&works[i].work,
+				      K_MSEC(works[i].period_ms));
+	}
+
+	atomic_set(&runs, 0);
+	wakeups = k_cpu_idle_wakeups_get();
+	k_msleep(RUN_MS);
+	wakeups = k_cpu_idle_wakeups_get() - wakeups;
+
+	printk("slack %4u ms: %6u wakeups/s, %6u work items/s\n", slack_ms,
+	       wakeups * 1000U / RUN_MS,
+	       (uint32_t)atomic_get(&runs) * 1000U / RUN_MS);
+
+	for (int i = 0; i < N_WORKS; i++) {
+		k_delayed_work_cancel(&works[i].work);
+	}
+}
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(slacks_ms); i++) {
+		rand_state = 1;
+		run(slacks_ms[i]);
+	}
+}
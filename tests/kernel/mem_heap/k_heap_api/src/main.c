@@ -9,6 +9,7 @@ extern void test_k_heap_alloc(void);
 extern void test_k_heap_alloc_fail(void);
 extern void test_k_heap_free(void);
 extern void test_kheap_alloc_in_isr_nowait(void);
+extern void test_k_heap_cache(void);
 
 /**
  * @brief k heap api tests
@@ -26,6 +27,7 @@ void test_main(void)
 			 ztest_unit_test(test_k_heap_alloc),
 			 ztest_unit_test(test_k_heap_alloc_fail),
 			 ztest_unit_test(test_k_heap_free),
-			 ztest_unit_test(test_kheap_alloc_in_isr_nowait));
+			 ztest_unit_test(test_kheap_alloc_in_isr_nowait),
+			 ztest_unit_test(test_k_heap_cache));
 	ztest_run_test_suite(k_heap_api);
 }
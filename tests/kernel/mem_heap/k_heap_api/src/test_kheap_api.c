@@ -111,3 +111,61 @@ void test_kheap_alloc_in_isr_nowait(void)
 {
 	irq_offload((irq_offload_routine_t)tIsr_kheap_alloc_nowait, NULL);
 }
+
+/**
+ * @brief Validate the k_heap front-end cache
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @details Fill the heap with small blocks and free them all, so
+ * most end up in the cache.  Check that freed blocks are reused from
+ * the cache, that a large allocation still succeeds (the cache is
+ * flushed automatically) and that k_heap_cache_flush() empties it.
+ *
+ * @see k_heap_cache_flush(), k_heap_cache_stats_get()
+ */
+void test_k_heap_cache(void)
+{
+#ifdef CONFIG_HEAP_CACHE
+	static void *blocks[HEAP_SIZE / 16];
+	struct k_heap_cache_stats stats;
+	int n;
+
+	k_heap_cache_flush(&k_heap_test);
+
+	for (n = 0; n < ARRAY_SIZE(blocks); n++) {
+		blocks[n] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > CONFIG_HEAP_CACHE_DEPTH, "too few allocations");
+
+	for (int i = 0; i < n; i++) {
+		k_heap_free(&k_heap_test, blocks[i]);
+	}
+
+	k_heap_cache_stats_get(&k_heap_test, &stats);
+	zassert_true(stats.cached_blocks > 0U, "nothing cached");
+	zassert_true(stats.cached_blocks <= CONFIG_HEAP_CACHE_DEPTH,
+		     "magazine overflow");
+
+	/* The most recently freed block comes back first */
+	void *p = k_heap_alloc(&k_heap_test, 12, K_NO_WAIT);
+
+	zassert_equal(p, blocks[n - 1], "block not served from the cache");
+	k_heap_free(&k_heap_test, p);
+
+	/* Cached blocks must not prevent a large allocation */
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "cache not flushed on allocation failure");
+	k_heap_free(&k_heap_test, p);
+
+	k_heap_cache_flush(&k_heap_test);
+	k_heap_cache_stats_get(&k_heap_test, &stats);
+	zassert_equal(stats.cached_blocks, 0U, "cache not flushed");
+	zassert_true(stats.hits > 0U && stats.flushes > 0U, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -8,12 +8,20 @@
 #include <sys/mem_manage.h>
 #include <mmu.h>
 
-#ifdef CONFIG_BACKING_STORE_RAM_PAGES
-#define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#if defined(CONFIG_BACKING_STORE_RAM_PAGES)
+#define BACKING_STORE_PAGES	CONFIG_BACKING_STORE_RAM_PAGES
+#elif defined(CONFIG_BACKING_STORE_COMPRESSED_PAGES)
+#define BACKING_STORE_PAGES	CONFIG_BACKING_STORE_COMPRESSED_PAGES
+#elif defined(CONFIG_BACKING_STORE_FLASH)
+#include <storage/flash_map.h>
+#define BACKING_STORE_PAGES	(FLASH_AREA_SIZE(demand_paging) / \
+				 CONFIG_MMU_PAGE_SIZE)
 #else
 #error "Unsupported configuration"
 #endif
 
+#define EXTRA_PAGES	(BACKING_STORE_PAGES - 1)
+
 size_t arena_size;
 char *arena;
 
@@ -37,6 +45,17 @@ void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *pEsf)
  */
 #define HALF_PAGES	(EXTRA_PAGES / 2)
 #define HALF_BYTES	(HALF_PAGES * CONFIG_MMU_PAGE_SIZE)
+
+#if CONFIG_DEMAND_PAGING_READAHEAD_PAGES > 0
+/* The first page fault of a sequential walk over paged out memory doesn't
+ * read ahead, each following one reads ahead the next few pages
+ */
+#define SEQUENTIAL_FAULTS(pages) \
+	(1 + ceiling_fraction((pages) - 1, \
+			      CONFIG_DEMAND_PAGING_READAHEAD_PAGES + 1))
+#else
+#define SEQUENTIAL_FAULTS(pages)	(pages)
+#endif
 static const char *nums = "0123456789";
 
 void test_map_anon_pages(void)
@@ -90,12 +109,18 @@ void test_k_mem_page_out(void)
 {
 	unsigned long faults;
 	int key, ret;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	unsigned long thread_faults;
+#endif
 
 	/* Lock IRQs to prevent other pagefaults from happening while we
 	 * are measuring stuff
 	 */
 	key = irq_lock();
 	faults = z_num_pagefaults_get();
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	thread_faults = z_num_pagefaults_thread_get(k_current_get());
+#endif
 	ret = k_mem_page_out(arena, HALF_BYTES);
 	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
 
@@ -104,11 +129,20 @@ void test_k_mem_page_out(void)
 		arena[i] = nums[i % 10];
 	}
 	faults = z_num_pagefaults_get() - faults;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	thread_faults = z_num_pagefaults_thread_get(k_current_get()) -
+			thread_faults;
+#endif
 	irq_unlock(key);
 
-	zassert_equal(faults, HALF_PAGES,
+	zassert_equal(faults, SEQUENTIAL_FAULTS(HALF_PAGES),
 		      "unexpected num pagefaults expected %lu got %d",
-		      HALF_PAGES, faults);
+		      SEQUENTIAL_FAULTS(HALF_PAGES), faults);
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	zassert_equal(thread_faults, faults,
+		      "thread took %lu of %lu pagefaults", thread_faults,
+		      faults);
+#endif
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
@@ -191,7 +225,7 @@ void test_backing_store_capacity(void)
 	char *mem, *ret;
 	int key;
 	unsigned long faults;
-	size_t size = (((CONFIG_BACKING_STORE_RAM_PAGES - 1) - HALF_PAGES) *
+	size_t size = ((EXTRA_PAGES - HALF_PAGES) *
 		       CONFIG_MMU_PAGE_SIZE);
 
 	/* Consume the rest of memory */
@@ -112,10 +112,63 @@ void test_generic_object(void)
 	}
 }
 
+/**
+ * @brief Test that cached object validations are invalidated
+ *
+ * @details
+ * - Objects validated once are validated again from the current thread's
+ *   object cache, which must still check their type and init state.
+ * - Revoking a permission or freeing an object must invalidate the cache.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_access_revoke(), k_object_free()
+ */
+void test_object_cache(void)
+{
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	struct k_sem *sem;
+
+	sem = k_object_alloc(K_OBJ_SEM);
+	zassert_not_null(sem, "couldn't allocate semaphore");
+	k_object_access_grant(sem, &z_main_thread);
+	k_sem_init(sem, 0, 1);
+
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), 0, NULL);
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), 0, NULL);
+
+	/**TESTPOINT: type and init state are still checked on a hit*/
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_MUTEX,
+					       _OBJ_INIT_TRUE), -EBADF, NULL);
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_SEM,
+					       _OBJ_INIT_FALSE), -EADDRINUSE,
+		      NULL);
+
+	/**TESTPOINT: revoking the permission invalidates the cache*/
+	k_object_access_revoke(sem, k_current_get());
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), -EPERM, NULL);
+
+	k_object_access_grant(sem, k_current_get());
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), 0, NULL);
+
+	/**TESTPOINT: freeing the object invalidates the cache*/
+	k_object_free(sem);
+	zassert_equal(z_object_validate_cached(sem, K_OBJ_SEM,
+					       _OBJ_INIT_TRUE), -EBADF, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 	ztest_test_suite(object_validation,
-			 ztest_unit_test(test_generic_object));
+			 ztest_unit_test(test_generic_object),
+			 ztest_unit_test(test_object_cache));
 	ztest_run_test_suite(object_validation);
 }
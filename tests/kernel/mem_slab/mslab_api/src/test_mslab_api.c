@@ -227,3 +227,61 @@ void test_mslab_used_get(void)
 	tmslab_used_get(&mslab);
 	tmslab_used_get(&kmslab);
 }
+
+/**
+ * @brief Validate the per-CPU free block cache of memory slabs
+ *
+ * @details Allocate all blocks of a slab several times the size of a
+ * cache and free them again, checking that blocks held in the cache
+ * are not counted as used, that the most recently freed block is
+ * handed out first, that cached blocks never make an allocation fail
+ * and that k_mem_slab_cache_flush() leaves all blocks free.
+ *
+ * @see k_mem_slab_cache_flush()
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_cache(void)
+{
+#ifdef CONFIG_MEM_SLAB_CACHE
+#define CACHE_BLK_NUM (4 * CONFIG_MEM_SLAB_CACHE_DEPTH)
+	static char __aligned(BLK_ALIGN) cslab_buf[BLK_SIZE * CACHE_BLK_NUM];
+	static struct k_mem_slab cslab;
+	static void *block[CACHE_BLK_NUM];
+	void *block_fail, *p;
+
+	k_mem_slab_init(&cslab, cslab_buf, BLK_SIZE, CACHE_BLK_NUM);
+
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < CACHE_BLK_NUM; i++) {
+			zassert_equal(k_mem_slab_alloc(&cslab, &block[i],
+						       K_NO_WAIT), 0,
+				      "cached blocks made allocation fail");
+			zassert_equal(k_mem_slab_num_used_get(&cslab), i + 1,
+				      NULL);
+			zassert_equal(k_mem_slab_num_free_get(&cslab),
+				      CACHE_BLK_NUM - 1 - i, NULL);
+		}
+		zassert_equal(k_mem_slab_alloc(&cslab, &block_fail, K_NO_WAIT),
+			      -ENOMEM, NULL);
+
+		for (int i = 0; i < CACHE_BLK_NUM; i++) {
+			k_mem_slab_free(&cslab, &block[i]);
+			zassert_equal(k_mem_slab_num_used_get(&cslab),
+				      CACHE_BLK_NUM - 1 - i, NULL);
+		}
+	}
+
+	/* The most recently freed block comes back first */
+	zassert_equal(k_mem_slab_alloc(&cslab, &p, K_NO_WAIT), 0, NULL);
+	zassert_equal(p, block[CACHE_BLK_NUM - 1],
+		      "block not served from the cache");
+	k_mem_slab_free(&cslab, &p);
+
+	k_mem_slab_cache_flush(&cslab);
+	zassert_equal(k_mem_slab_num_used_get(&cslab), 0, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&cslab), CACHE_BLK_NUM, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
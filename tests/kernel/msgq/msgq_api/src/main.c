@@ -23,6 +23,10 @@ extern void test_msgq_alloc(void);
 extern void test_msgq_pend_thread(void);
 extern void test_msgq_empty(void);
 extern void test_msgq_full(void);
+extern void test_msgq_claim(void);
+extern void test_msgq_claim_pend_thread(void);
+extern void test_msgq_claim_pend_mixed(void);
+extern void test_msgq_poll(void);
 #ifdef CONFIG_USERSPACE
 extern void test_msgq_user_thread(void);
 extern void test_msgq_user_thread_overflow(void);
@@ -30,6 +34,7 @@ extern void test_msgq_user_put_fail(void);
 extern void test_msgq_user_get_fail(void);
 extern void test_msgq_user_attrs_get(void);
 extern void test_msgq_user_purge_when_put(void);
+extern void test_msgq_user_claim(void);
 #else
 #define dummy_test(_name) \
 	static void _name(void) \
@@ -43,6 +48,7 @@ dummy_test(test_msgq_user_put_fail);
 dummy_test(test_msgq_user_get_fail);
 dummy_test(test_msgq_user_attrs_get);
 dummy_test(test_msgq_user_purge_when_put);
+dummy_test(test_msgq_user_claim);
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_64BIT
@@ -55,6 +61,7 @@ K_HEAP_DEFINE(test_pool, MAX_SZ * 2);
 
 extern struct k_msgq kmsgq;
 extern struct k_msgq msgq;
+extern struct k_msgq claimq;
 extern struct k_sem end_sema;
 extern struct k_thread tdata;
 K_THREAD_STACK_EXTERN(tstack);
@@ -62,8 +69,8 @@ K_THREAD_STACK_EXTERN(tstack);
 /*test case main entry*/
 void test_main(void)
 {
-	k_thread_access_grant(k_current_get(), &kmsgq, &msgq, &end_sema,
-			      &tdata, &tstack);
+	k_thread_access_grant(k_current_get(), &kmsgq, &msgq, &claimq,
+			      &end_sema, &tdata, &tstack);
 
 	k_thread_heap_assign(k_current_get(), &test_pool);
 
@@ -84,6 +91,11 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_msgq_pend_thread),
 			 ztest_1cpu_unit_test(test_msgq_empty),
 			 ztest_1cpu_unit_test(test_msgq_full),
-			 ztest_unit_test(test_msgq_alloc));
+			 ztest_unit_test(test_msgq_alloc),
+			 ztest_unit_test(test_msgq_claim),
+			 ztest_user_unit_test(test_msgq_user_claim),
+			 ztest_1cpu_unit_test(test_msgq_claim_pend_thread),
+			 ztest_1cpu_unit_test(test_msgq_claim_pend_mixed),
+			 ztest_unit_test(test_msgq_poll));
 	ztest_run_test_suite(msgq_api);
 }
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+K_THREAD_STACK_EXTERN(tstack);
+K_THREAD_STACK_EXTERN(tstack1);
+extern struct k_thread tdata;
+extern struct k_thread tdata1;
+static ZTEST_BMEM char __aligned(4) claim_buffer[MSG_SIZE * MSGQ_LEN];
+static ZTEST_DMEM uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+static ZTEST_BMEM void *claimed_ptr;
+static ZTEST_BMEM uint32_t claimed_val;
+static ZTEST_BMEM uint32_t getter_val;
+static ZTEST_BMEM volatile int getter_ret;
+struct k_msgq claimq;
+
+static void claim_commit_release(struct k_msgq *q)
+{
+	void *slot, *msg, *other;
+	uint32_t rx_data;
+
+	k_msgq_purge(q);
+
+	/**TESTPOINT: a put claim hands out a slot of the ring buffer*/
+	zassert_equal(k_msgq_put_claim(q, &slot, K_NO_WAIT), 0, NULL);
+	zassert_true((char *)slot >= claim_buffer &&
+		     (char *)slot < claim_buffer + sizeof(claim_buffer), NULL);
+
+	/**TESTPOINT: other senders cannot go ahead while the claim is held*/
+	zassert_equal(k_msgq_put_claim(q, &other, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_put(q, &data[1], K_MSEC(1)), -EAGAIN, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 0, NULL);
+
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(q), 0, NULL);
+	zassert_equal(k_msgq_put_commit(q), -EINVAL, NULL);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(q), MSGQ_LEN, NULL);
+
+	/**TESTPOINT: a full queue has no slot to claim*/
+	zassert_equal(k_msgq_put_claim(q, &other, K_NO_WAIT), -ENOMSG, NULL);
+
+	/**TESTPOINT: a get claim points at the message in place*/
+	zassert_equal(k_msgq_get_claim(q, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal_ptr(msg, slot, NULL);
+	zassert_equal(*(uint32_t *)msg, MSG0, NULL);
+
+	/**TESTPOINT: other receivers cannot go ahead while the claim is held*/
+	zassert_equal(k_msgq_get_claim(q, &other, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_get_claim(q, &other, K_MSEC(1)), -EAGAIN, NULL);
+	zassert_equal(k_msgq_peek(q, &rx_data), 0, NULL);
+	zassert_equal(rx_data, MSG0, NULL);
+
+	zassert_equal(k_msgq_get_release(q), 0, NULL);
+	zassert_equal(k_msgq_get_release(q), -EINVAL, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 1, NULL);
+
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, MSG1, NULL);
+	zassert_equal(k_msgq_get_claim(q, &msg, K_NO_WAIT), -ENOMSG, NULL);
+}
+
+static void tThread_get_claim(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	zassert_equal(k_msgq_get_claim(q, &claimed_ptr, K_FOREVER), 0, NULL);
+	claimed_val = *(uint32_t *)claimed_ptr;
+	zassert_equal(k_msgq_get_release(q), 0, NULL);
+}
+
+static void tThread_get(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	getter_ret = k_msgq_get(q, &getter_val, K_FOREVER);
+}
+
+static void tThread_put(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	getter_ret = k_msgq_put(q, &data[1], K_FOREVER);
+}
+
+static void tThread_put_claim(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	zassert_equal(k_msgq_put_claim(q, &claimed_ptr, K_FOREVER), 0, NULL);
+	*(uint32_t *)claimed_ptr = MSG1;
+	zassert_equal(k_msgq_put_commit(q), 0, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test zero-copy message queue claims
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_release()
+ */
+void test_msgq_claim(void)
+{
+	k_msgq_init(&claimq, claim_buffer, MSG_SIZE, MSGQ_LEN);
+
+	claim_commit_release(&claimq);
+}
+
+/**
+ * @brief Test zero-copy message queue claims from user mode
+ *
+ * The ring buffer lives in the test memory partition, so user threads may
+ * claim its slots. Relies on test_msgq_claim() to initialize the queue.
+ *
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_release()
+ */
+void test_msgq_user_claim(void)
+{
+	claim_commit_release(&claimq);
+}
+
+/**
+ * @brief Test zero-copy claims handed over to waiting threads
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_release()
+ */
+void test_msgq_claim_pend_thread(void)
+{
+	void *slot;
+	uint32_t rx_data;
+
+	k_msgq_init(&claimq, claim_buffer, MSG_SIZE, MSGQ_LEN);
+
+	/**TESTPOINT: a committed slot goes to a thread waiting to claim*/
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      tThread_get_claim, &claimq, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_put_claim(&claimq, &slot, K_NO_WAIT), 0, NULL);
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(&claimq), 0, NULL);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal_ptr(claimed_ptr, slot, NULL);
+	zassert_equal(claimed_val, MSG0, NULL);
+	zassert_equal(k_msgq_num_used_get(&claimq), 0, NULL);
+
+	/**TESTPOINT: a freed slot goes to a thread waiting to claim*/
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(&claimq, &data[i], K_NO_WAIT), 0,
+			      NULL);
+	}
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      tThread_put_claim, &claimq, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_get(&claimq, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, MSG0, NULL);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(k_msgq_get(&claimq, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, MSG1, NULL);
+	zassert_equal(k_msgq_get(&claimq, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, MSG1, NULL);
+}
+
+/**
+ * @brief Test that plain receivers keep waiting across a get claim
+ * @see k_msgq_get(), k_msgq_get_claim(), k_msgq_get_release()
+ */
+void test_msgq_claim_pend_mixed(void)
+{
+	void *slot;
+
+	k_msgq_init(&claimq, claim_buffer, MSG_SIZE, MSGQ_LEN);
+	getter_ret = 1;
+
+	/* a claiming receiver queued ahead of a plain one */
+	k_tid_t claimer = k_thread_create(&tdata, tstack, STACK_SIZE,
+					  tThread_get_claim, &claimq, NULL,
+					  NULL, K_PRIO_PREEMPT(0), 0,
+					  K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 2);
+	k_tid_t getter = k_thread_create(&tdata1, tstack1, STACK_SIZE,
+					 tThread_get, &claimq, NULL, NULL,
+					 K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 2);
+
+	/**TESTPOINT: granting the claim leaves the plain receiver waiting*/
+	k_thread_suspend(claimer);
+	zassert_equal(k_msgq_put(&claimq, &data[0], K_NO_WAIT), 0, NULL);
+	k_msleep(TIMEOUT_MS >> 2);
+	zassert_equal(getter_ret, 1, "plain receiver woken by the claim");
+
+	/**TESTPOINT: it is served once the claim is released*/
+	zassert_equal(k_msgq_put(&claimq, &data[1], K_NO_WAIT), 0, NULL);
+	k_msleep(TIMEOUT_MS >> 2);
+	zassert_equal(getter_ret, 1, "plain receiver overtook the claim");
+	k_thread_resume(claimer);
+	k_thread_join(claimer, K_FOREVER);
+	k_thread_join(getter, K_FOREVER);
+
+	zassert_equal(claimed_val, MSG0, NULL);
+	zassert_equal(getter_ret, 0, NULL);
+	zassert_equal(getter_val, MSG1, NULL);
+	zassert_equal(k_msgq_num_used_get(&claimq), 0, NULL);
+
+	/**TESTPOINT: plain senders wait for a put claim to be committed*/
+	zassert_equal(k_msgq_put_claim(&claimq, &slot, K_NO_WAIT), 0, NULL);
+	getter_ret = 1;
+	getter = k_thread_create(&tdata1, tstack1, STACK_SIZE,
+				 tThread_put, &claimq, NULL, NULL,
+				 K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 2);
+	zassert_equal(k_msgq_num_used_get(&claimq), 0, NULL);
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(&claimq), 0, NULL);
+	k_thread_join(getter, K_FOREVER);
+	zassert_equal(getter_ret, 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&claimq), 2, NULL);
+	k_msgq_purge(&claimq);
+}
+
+/**
+ * @brief Test polling a message queue for committed messages
+ * @see k_poll(), k_msgq_put_commit()
+ */
+void test_msgq_poll(void)
+{
+	struct k_poll_event event;
+	void *slot;
+	uint32_t rx_data;
+
+	k_msgq_init(&claimq, claim_buffer, MSG_SIZE, MSGQ_LEN);
+	k_poll_event_init(&event, K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &claimq);
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	/**TESTPOINT: a claimed slot is not data yet*/
+	zassert_equal(k_msgq_put_claim(&claimq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(&claimq), 0, NULL);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_MSGQ_DATA_AVAILABLE, NULL);
+
+	zassert_equal(k_msgq_get(&claimq, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, MSG0, NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for zero-copy pipe claims
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define PIPE_LEN 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static ZTEST_DMEM unsigned char __aligned(4) claim_buffer[PIPE_LEN];
+static struct k_pipe claim_pipe;
+static struct k_pipe bufferless;
+
+static unsigned char rx_data[PIPE_LEN];
+static void *claimed_ptr;
+static size_t claimed_size;
+
+/**
+ * @brief Test writing and reading a pipe in place
+ *
+ * Claims always cover a contiguous run of the pipe's buffer, so a claim
+ * made close to the end of the buffer is cut short there.
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_release()
+ */
+void test_pipe_claim(void)
+{
+	void *data, *other;
+	size_t size, other_size, bytes;
+
+	k_pipe_init(&claim_pipe, claim_buffer, sizeof(claim_buffer));
+
+	zassert_equal(k_pipe_put_claim(&bufferless, &data, &size, K_NO_WAIT),
+		      -EINVAL, NULL);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal_ptr(data, claim_buffer, NULL);
+	zassert_equal(size, PIPE_LEN, NULL);
+
+	/**TESTPOINT: other writers are refused while the claim is held*/
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &other, &other_size,
+				       K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_put(&claim_pipe, "x", 1, &bytes, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	memcpy(data, "abcdef", 6);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, PIPE_LEN + 1), -EINVAL,
+		      NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 6), 0, NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 6, NULL);
+
+	/**TESTPOINT: a get claim points at the data in place*/
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal_ptr(data, claim_buffer, NULL);
+	zassert_equal(size, 6, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &other, &other_size,
+				       K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, 1, &bytes, 1,
+				 K_NO_WAIT), -EBUSY, NULL);
+
+	/**TESTPOINT: unreleased claimed data stays in the pipe*/
+	zassert_equal(k_pipe_get_release(&claim_pipe, 4), 0, NULL);
+	zassert_equal(k_pipe_get_release(&claim_pipe, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, 2, &bytes, 2,
+				 K_NO_WAIT), 0, NULL);
+	zassert_equal(memcmp(rx_data, "ef", 2), 0, NULL);
+
+	/**TESTPOINT: claims stop at the end of the buffer*/
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal_ptr(data, claim_buffer + 6, NULL);
+	zassert_equal(size, PIPE_LEN - 6, NULL);
+	memcpy(data, "gh", 2);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 2), 0, NULL);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal_ptr(data, claim_buffer, NULL);
+	zassert_equal(size, PIPE_LEN - 2, NULL);
+	memcpy(data, "ij", 2);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 2), 0, NULL);
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, 4, &bytes, 4,
+				 K_NO_WAIT), 0, NULL);
+	zassert_equal(memcmp(rx_data, "ghij", 4), 0, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      -EIO, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, &size,
+				       K_MSEC(10)), -EAGAIN, NULL);
+}
+
+static void tThread_get(void *p1, void *p2, void *p3)
+{
+	size_t bytes;
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, 4, &bytes, 4,
+				 K_FOREVER), 0, NULL);
+}
+
+static void tThread_get_claim(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &claimed_ptr,
+				       &claimed_size, K_FOREVER), 0, NULL);
+	zassert_equal(k_pipe_get_release(&claim_pipe, claimed_size), 0, NULL);
+}
+
+static void tThread_put_claim(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &claimed_ptr,
+				       &claimed_size, K_FOREVER), 0, NULL);
+	memcpy(claimed_ptr, "z", 1);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 1), 0, NULL);
+}
+
+/**
+ * @brief Test claims cooperating with waiting threads
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_release()
+ */
+void test_pipe_claim_pend_thread(void)
+{
+	void *data;
+	size_t size, bytes;
+	k_tid_t tid;
+
+	k_pipe_init(&claim_pipe, claim_buffer, sizeof(claim_buffer));
+
+	/**TESTPOINT: committed data is handed to a waiting reader*/
+	tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			      tThread_get, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(50);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      0, NULL);
+	memcpy(data, "abcd", 4);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 4), 0, NULL);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(memcmp(rx_data, "abcd", 4), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	/**TESTPOINT: a waiting claim is retried when data arrives*/
+	tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			      tThread_get_claim, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(50);
+
+	zassert_equal(k_pipe_put(&claim_pipe, "efg", 3, &bytes, 3,
+				 K_NO_WAIT), 0, NULL);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal_ptr(claimed_ptr, claim_buffer + 4, NULL);
+	zassert_equal(claimed_size, 3, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	/**TESTPOINT: released space is handed to a waiting claim*/
+	zassert_equal(k_pipe_put(&claim_pipe, "hijklmno", PIPE_LEN, &bytes,
+				 PIPE_LEN, K_NO_WAIT), 0, NULL);
+	tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			      tThread_put_claim, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(50);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, &size, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal(k_pipe_get_release(&claim_pipe, 1), 0, NULL);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(claimed_size, 1, NULL);
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, PIPE_LEN, &bytes,
+				 PIPE_LEN, K_NO_WAIT), 0, NULL);
+	zassert_equal(memcmp(rx_data, "ijklmnoz", PIPE_LEN), 0, NULL);
+}
+
+/**
+ * @}
+ */
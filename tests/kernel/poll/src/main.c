@@ -13,6 +13,9 @@ extern void test_poll_cancel_main_high_prio(void);
 extern void test_poll_multi(void);
 extern void test_poll_threadstate(void);
 extern void test_poll_grant_access(void);
+extern void test_poll_set_ready(void);
+extern void test_poll_set_wait(void);
+extern void test_poll_set_concurrent(void);
 
 #ifdef CONFIG_64BIT
 #define MAX_SZ	256
@@ -36,6 +39,9 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_poll_cancel_main_low_prio),
 			 ztest_1cpu_unit_test(test_poll_cancel_main_high_prio),
 			 ztest_unit_test(test_poll_multi),
-			 ztest_1cpu_unit_test(test_poll_threadstate));
+			 ztest_1cpu_unit_test(test_poll_threadstate),
+			 ztest_1cpu_unit_test(test_poll_set_ready),
+			 ztest_1cpu_unit_test(test_poll_set_wait),
+			 ztest_unit_test(test_poll_set_concurrent));
 	ztest_run_test_suite(poll_api);
 }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#define N_SEMS 32
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct k_poll_set set;
+static struct k_sem sems[N_SEMS];
+static struct k_poll_event sem_events[N_SEMS];
+static struct k_fifo fifo;
+static struct k_poll_signal signal;
+static struct k_poll_event fifo_event, signal_event;
+
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_poll_event *thread_ready[4];
+static volatile int thread_ret;
+
+static void set_setup(void)
+{
+	k_poll_set_init(&set);
+	for (int i = 0; i < N_SEMS; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&sem_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+		sem_events[i].tag = i;
+		zassert_equal(k_poll_set_add(&set, &sem_events[i]), 0, NULL);
+	}
+
+	k_fifo_init(&fifo);
+	k_poll_event_init(&fifo_event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &fifo);
+	zassert_equal(k_poll_set_add(&set, &fifo_event), 0, NULL);
+
+	k_poll_signal_init(&signal);
+	k_poll_event_init(&signal_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &signal);
+	zassert_equal(k_poll_set_add(&set, &signal_event), 0, NULL);
+}
+
+static void set_teardown(void)
+{
+	for (int i = 0; i < N_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &sem_events[i]), 0, NULL);
+	}
+	zassert_equal(k_poll_set_remove(&set, &fifo_event), 0, NULL);
+	zassert_equal(k_poll_set_remove(&set, &signal_event), 0, NULL);
+}
+
+/**
+ * @brief Test that a poll set reports only the signaled events, level
+ * triggered, and rearms them once consumed
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait()
+ */
+void test_poll_set_ready(void)
+{
+	struct k_poll_event *ready[4];
+	static struct k_poll_event busy;
+
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(10)), -EAGAIN, NULL);
+
+	/* An event already in the set can't be added again */
+	zassert_equal(k_poll_set_add(&set, &sem_events[0]), -EBUSY, NULL);
+	k_poll_event_init(&busy, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &sems[0]);
+	zassert_equal(k_poll_set_remove(&set, &busy), -EINVAL, NULL);
+
+	k_sem_give(&sems[7]);
+	k_sem_give(&sems[21]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2, NULL);
+	zassert_equal(ready[0], &sem_events[7], NULL);
+	zassert_equal(ready[1], &sem_events[21], NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/* Still ready until consumed */
+	k_sem_take(&sems[7], K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0], &sem_events[21], NULL);
+	k_sem_take(&sems[21], K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* Consumed events are rearmed */
+	k_sem_give(&sems[7]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0], &sem_events[7], NULL);
+	k_sem_take(&sems[7], K_NO_WAIT);
+
+	/* Round robin when more are ready than fit */
+	for (int i = 0; i < 3; i++) {
+		k_sem_give(&sems[i]);
+	}
+	for (int i = 0; i < 6; i++) {
+		zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1,
+			      NULL);
+		zassert_equal(ready[0], &sem_events[i % 3], NULL);
+	}
+	for (int i = 0; i < 3; i++) {
+		k_sem_take(&sems[i], K_NO_WAIT);
+	}
+
+	/* Removed events are no longer reported */
+	zassert_equal(k_poll_set_remove(&set, &sem_events[3]), 0, NULL);
+	k_sem_give(&sems[3]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	k_sem_take(&sems[3], K_NO_WAIT);
+	zassert_equal(k_poll_set_add(&set, &sem_events[3]), 0, NULL);
+
+	/* Events ready when added are reported right away */
+	k_poll_signal_raise(&signal, 1);
+	zassert_equal(k_poll_set_remove(&set, &signal_event), 0, NULL);
+	zassert_equal(k_poll_set_add(&set, &signal_event), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0], &signal_event, NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED, NULL);
+	k_poll_signal_reset(&signal);
+
+	/* Cancelled events are reported once, until added again */
+	k_fifo_cancel_wait(&fifo);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0], &fifo_event, NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_CANCELLED, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	zassert_equal(k_poll_set_remove(&set, &fifo_event), 0, NULL);
+	zassert_equal(k_poll_set_add(&set, &fifo_event), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	set_teardown();
+
+	/* Removed events no longer make their objects signal them */
+	static struct k_rwlock rwlock;
+	static struct k_poll_event rwlock_event;
+
+	k_rwlock_init(&rwlock);
+	k_poll_event_init(&rwlock_event, K_POLL_TYPE_RWLOCK_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &rwlock);
+	zassert_equal(k_poll_set_add(&set, &rwlock_event), 0, NULL);
+	zassert_equal(k_poll_set_remove(&set, &rwlock_event), 0, NULL);
+	zassert_false(atomic_get(&rwlock.state) & Z_RWLOCK_POLLED,
+		      "rwlock still polled");
+#ifdef CONFIG_QUEUE_LOCKLESS_APPEND
+	zassert_false(atomic_get(&fifo._queue.flags) & Z_QUEUE_POLLED,
+		      "queue still polled");
+#endif
+}
+
+static void set_waiter(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_poll_set_wait(&set, thread_ready,
+				     ARRAY_SIZE(thread_ready), K_FOREVER);
+}
+
+/**
+ * @brief Test that a thread waiting on a poll set is woken by an event
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+void test_poll_set_wait(void)
+{
+	static struct fifo_msg {
+		void *private;
+		uint32_t msg;
+	} msg = { NULL, 0x600dcafe };
+
+	set_setup();
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(5));
+	thread_ret = 0;
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, set_waiter,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	zassert_equal(thread_ret, 0, "waiter returned too early");
+
+	k_fifo_put(&fifo, &msg);
+	zassert_equal(thread_ret, 1, "waiter not woken");
+	zassert_equal(thread_ready[0], &fifo_event, NULL);
+	zassert_equal(thread_ready[0]->state,
+		      K_POLL_STATE_FIFO_DATA_AVAILABLE, NULL);
+	zassert_equal(k_fifo_get(&fifo, K_NO_WAIT), &msg, NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	/* The set and k_poll() can watch different objects side by side */
+	struct k_poll_event poll_event;
+
+	k_poll_event_init(&poll_event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &sems[0]);
+	k_sem_give(&sems[1]);
+	zassert_equal(k_poll(&poll_event, 1, K_MSEC(10)), -EAGAIN, NULL);
+	zassert_equal(k_poll_set_wait(&set, thread_ready, 1, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal(thread_ready[0], &sem_events[1], NULL);
+	k_sem_take(&sems[1], K_NO_WAIT);
+
+	set_teardown();
+}
+
+#define CONCURRENT_ROUNDS 1000
+
+static void sem_giver(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < CONCURRENT_ROUNDS; i++) {
+		struct k_sem *sem = &sems[i % N_SEMS];
+
+		/* Give while the set is being collected and rearmed */
+		k_sem_give(sem);
+		while (k_sem_count_get(sem) != 0U) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test that no event is lost while objects are signaled
+ * concurrently with k_poll_set_wait(), from another CPU on SMP
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+void test_poll_set_concurrent(void)
+{
+	struct k_poll_event *ready[4];
+	int taken = 0;
+
+	set_setup();
+
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, sem_giver,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()),
+			0, K_NO_WAIT);
+
+	while (taken < CONCURRENT_ROUNDS) {
+		int n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+					K_SECONDS(1));
+
+		zassert_true(n > 0, "event lost after %d", taken);
+		for (int i = 0; i < n; i++) {
+			zassert_equal(ready[i]->type,
+				      K_POLL_TYPE_SEM_AVAILABLE, NULL);
+			if (k_sem_take(&sems[ready[i]->tag], K_NO_WAIT) == 0) {
+				taken++;
+			}
+		}
+	}
+
+	k_thread_join(&set_thread, K_FOREVER);
+
+	set_teardown();
+}
@@ -250,6 +250,67 @@ void test_queue_get_2threads(void)
 	tqueue_get_2threads(&queue);
 }
 
+static qdata_t data_b[LIST_LEN + 1];
+static void *rx_b[LIST_LEN];
+
+static void tThread_get_idx(void *p1, void *p2, void *p3)
+{
+	rx_b[POINTER_TO_INT(p2)] = k_queue_get((struct k_queue *)p1,
+					       K_FOREVER);
+}
+
+static void tIsr_entry_append_list(const void *p)
+{
+	for (int i = 0; i < LIST_LEN; i++) {
+		data_b[i].snode.next = &data_b[i + 1].snode;
+	}
+	data_b[LIST_LEN].snode.next = NULL;
+
+	k_queue_append_list((struct k_queue *)p, &data_b[0],
+			    &data_b[LIST_LEN]);
+}
+
+/**
+ * @brief Verify k_queue_append_list() from an ISR with waiting threads
+ *
+ * @details The waiting threads get the first items of the list, in order,
+ * and the rest of the list stays in the queue in order, after items
+ * appended before it.
+ *
+ * @ingroup kernel_queue_tests
+ * @see k_queue_append_list(), k_queue_get()
+ */
+void test_queue_append_list_waiters(void)
+{
+	k_queue_init(&queue);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_get_idx,
+			&queue, INT_TO_POINTER(0), NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	k_thread_create(&tdata1, tstack1, STACK_SIZE, tThread_get_idx,
+			&queue, INT_TO_POINTER(1), NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	irq_offload(tIsr_entry_append_list, &queue);
+	k_thread_join(&tdata, K_FOREVER);
+	k_thread_join(&tdata1, K_FOREVER);
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		zassert_equal(rx_b[i], &data_b[i], NULL);
+	}
+	zassert_equal(k_queue_peek_tail(&queue), &data_b[LIST_LEN], NULL);
+
+	/* Later appends and prepends go around the rest of the list */
+	k_queue_append(&queue, &data[0]);
+	k_queue_prepend(&queue, &data_p[0]);
+	zassert_equal(k_queue_get(&queue, K_NO_WAIT), &data_p[0], NULL);
+	zassert_equal(k_queue_get(&queue, K_NO_WAIT), &data_b[LIST_LEN], NULL);
+	zassert_equal(k_queue_get(&queue, K_NO_WAIT), &data[0], NULL);
+	zassert_true(k_queue_is_empty(&queue), NULL);
+}
+
 static void tqueue_alloc(struct k_queue *pqueue)
 {
 	k_thread_heap_assign(k_current_get(), NULL);
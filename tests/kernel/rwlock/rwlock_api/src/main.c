@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_THREADS 2
+
+K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+struct k_thread threads[NUM_THREADS];
+
+K_RWLOCK_DEFINE(rwlock);
+K_SEM_DEFINE(done_sem, 0, 1);
+
+ZTEST_BMEM int order[NUM_THREADS + 1];
+ZTEST_BMEM int norder;
+ZTEST_BMEM int isr_ret[2];
+
+static void record(int id)
+{
+	order[norder++] = id;
+}
+
+static k_tid_t spawn(int i, k_thread_entry_t entry, int prio)
+{
+	return k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+			       NULL, NULL, NULL, prio, K_INHERIT_PERMS,
+			       K_NO_WAIT);
+}
+
+static int higher_prio(int delta)
+{
+	return k_thread_priority_get(k_current_get()) - delta;
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_FOREVER), 0, NULL);
+	record(1);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+}
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_FOREVER), 0, NULL);
+	record(2);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+}
+
+static void writer_hold(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_FOREVER), 0, NULL);
+	k_sem_take(&done_sem, K_FOREVER);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+}
+
+static void releaser(void *p1, void *p2, void *p3)
+{
+	k_sem_give(&done_sem);
+}
+
+/**
+ * @brief Test locking and unlocking without contention
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_uncontended(void)
+{
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_FOREVER), -EDEADLK,
+		      NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_FOREVER), 0, NULL);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+}
+
+/**
+ * @brief Test unlocking a lock which is not held
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_unlock_errors(void)
+{
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EPERM, NULL);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EPERM, NULL);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+}
+
+/**
+ * @brief Test that readers share the lock and writers wait for them
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_readers_share(void)
+{
+	norder = 0;
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_FOREVER), 0, NULL);
+
+	/* Another reader gets in right away */
+	spawn(0, reader, higher_prio(1));
+	zassert_equal(norder, 1, "reader did not get the lock");
+
+	/* A writer waits until the last reader is gone */
+	spawn(1, writer, higher_prio(1));
+	zassert_equal(norder, 1, "writer got a read-locked lock");
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+	zassert_equal(norder, 2, "writer not woken up");
+	zassert_equal(order[1], 2, NULL);
+
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+}
+
+/**
+ * @brief Test that readers wait while a writer waits
+ *
+ * @details A reader arriving while a writer waits for the lock must wait
+ * as well, and get the lock after the writer releases it.
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_writer_preference(void)
+{
+	norder = 0;
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_FOREVER), 0, NULL);
+
+	spawn(0, writer, higher_prio(1));
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY,
+		      "reader got ahead of a waiting writer");
+
+	/* Even a higher priority reader queues up behind the writer */
+	spawn(1, reader, higher_prio(2));
+	zassert_equal(norder, 0, NULL);
+
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+	zassert_equal(norder, 2, NULL);
+	zassert_equal(order[0], 2, "writer did not get the lock first");
+	zassert_equal(order[1], 1, NULL);
+
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+}
+
+/**
+ * @brief Test locking with a timeout
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_timeout(void)
+{
+	spawn(0, writer_hold, higher_prio(1));
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_MSEC(50)), -EAGAIN, NULL);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_MSEC(50)), -EAGAIN,
+		      NULL);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY, NULL);
+
+	k_sem_give(&done_sem);
+	k_thread_join(&threads[0], K_FOREVER);
+
+	/* Timed out waiters left no trace */
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+}
+
+/**
+ * @brief Test priority inheritance of the writer
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_priority_inheritance(void)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+
+	spawn(0, reader, prio - 1);
+	zassert_equal(k_thread_priority_get(k_current_get()), prio - 1,
+		      "writer did not inherit the reader's priority");
+
+	spawn(1, writer, prio - 2);
+	zassert_equal(k_thread_priority_get(k_current_get()), prio - 2,
+		      "writer did not inherit the writer's priority");
+
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), prio,
+		      "priority not restored");
+
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+
+	/* A waiter giving up drops the priority back */
+	spawn(0, writer_hold, prio + 1);
+	k_msleep(1);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_MSEC(50)), -EAGAIN,
+		      NULL);
+	zassert_equal(k_thread_priority_get(&threads[0]), prio + 1,
+		      "priority not restored after timeout");
+	k_sem_give(&done_sem);
+	k_thread_join(&threads[0], K_FOREVER);
+}
+
+/**
+ * @brief Test waiting for a reader-writer lock with k_poll()
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_poll(void)
+{
+	struct k_poll_event event;
+
+	k_poll_event_init(&event, K_POLL_TYPE_RWLOCK_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &rwlock);
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_RWLOCK_AVAILABLE, NULL);
+
+	/* Held for reading: not available, until the last reader leaves */
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll(&event, 1, K_MSEC(10)), -EAGAIN, NULL);
+
+	spawn(0, writer_hold, higher_prio(1));
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0, NULL);
+	zassert_equal(k_poll(&event, 1, K_MSEC(10)), -EAGAIN, NULL);
+
+	/* Released by the writer while polling */
+	spawn(1, releaser, higher_prio(-1));
+	zassert_equal(k_poll(&event, 1, K_FOREVER), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_RWLOCK_AVAILABLE, NULL);
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+}
+
+static void isr_read_lock(const void *param)
+{
+	ARG_UNUSED(param);
+
+	isr_ret[0] = k_rwlock_read_lock(&rwlock, K_NO_WAIT);
+	if (isr_ret[0] == 0) {
+		isr_ret[1] = k_rwlock_read_unlock(&rwlock);
+	}
+}
+
+/**
+ * @brief Test read locking from an ISR
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_isr(void)
+{
+	irq_offload(isr_read_lock, NULL);
+	zassert_equal(isr_ret[0], 0, NULL);
+	zassert_equal(isr_ret[1], 0, NULL);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	irq_offload(isr_read_lock, NULL);
+	zassert_equal(isr_ret[0], -EBUSY, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+}
+
+/**
+ * @brief Test initializing a reader-writer lock at runtime
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+void test_rwlock_init(void)
+{
+	zassert_equal(k_rwlock_init(&rwlock), 0, NULL);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0, NULL);
+}
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &rwlock, &done_sem,
+			      &threads[0], &threads[1], &stacks[0],
+			      &stacks[1]);
+
+	ztest_test_suite(rwlock_api,
+			 ztest_user_unit_test(test_rwlock_init),
+			 ztest_user_unit_test(test_rwlock_uncontended),
+			 ztest_user_unit_test(test_rwlock_unlock_errors),
+			 ztest_unit_test(test_rwlock_readers_share),
+			 ztest_unit_test(test_rwlock_writer_preference),
+			 ztest_unit_test(test_rwlock_timeout),
+			 ztest_unit_test(test_rwlock_priority_inheritance),
+			 ztest_unit_test(test_rwlock_poll),
+			 ztest_unit_test(test_rwlock_isr));
+	ztest_run_test_suite(rwlock_api);
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+
+#define NUM_THREADS 2
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define PRIO K_LOWEST_APPLICATION_THREAD_PRIO
+
+/* Length of the busy loops, and budget and period of the busy thread */
+#define BUSY_MS 300
+#define BUDGET_US 20000
+#define PERIOD_US 100000
+
+struct k_thread worker_threads[NUM_THREADS];
+
+K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_THREADS, STACK_SIZE);
+
+/* The number of worker threads that ran, and an array of their
+ * indices in execution order
+ */
+int n_exec;
+int exec_order[NUM_THREADS];
+
+/* Iterations of the busy loop done by each worker */
+volatile int busy_loops[NUM_THREADS];
+
+void worker(void *p1, void *p2, void *p3)
+{
+	int tidx = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	exec_order[n_exec++] = tidx;
+
+	while (1) {
+		k_sleep(K_MSEC(1000000));
+	}
+}
+
+void busy_worker(void *p1, void *p2, void *p3)
+{
+	int tidx = POINTER_TO_INT(p1);
+	int64_t end = k_uptime_get() + BUSY_MS;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (k_uptime_get() < end) {
+		k_busy_wait(100);
+		busy_loops[tidx]++;
+	}
+
+	while (1) {
+		k_sleep(K_MSEC(1000000));
+	}
+}
+
+static k_tid_t spawn(int i, k_thread_entry_t entry, int prio)
+{
+	return k_thread_create(&worker_threads[i], worker_stacks[i],
+			       STACK_SIZE, entry, INT_TO_POINTER(i), NULL, NULL,
+			       prio, 0, K_FOREVER);
+}
+
+static void cleanup(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_thread_abort(&worker_threads[i]);
+		busy_loops[i] = 0;
+	}
+	n_exec = 0;
+}
+
+/**
+ * @brief Test that budgets are checked and admitted against the limit
+ */
+void test_cbs_admission(void)
+{
+	struct k_thread_cbs_stats stats;
+	k_tid_t a = spawn(0, worker, PRIO);
+	k_tid_t b = spawn(1, worker, PRIO);
+
+	zassert_equal(k_thread_cbs_stats_get(a, &stats), -EINVAL,
+		      "thread without budget has statistics");
+	zassert_equal(k_thread_cbs_set(a, 2000, 1000), -EINVAL,
+		      "budget larger than period accepted");
+	zassert_equal(k_thread_cbs_set(a, 1000, 0), -EINVAL,
+		      "zero period accepted");
+
+	zassert_equal(k_thread_cbs_set(a, 5000, 10000), 0, "");
+	zassert_equal(k_thread_cbs_stats_get(a, &stats), 0, "");
+	zassert_equal(stats.overruns, 0, "");
+
+	/* 50% + 50% is over the limit, 50% + 40% is not */
+	zassert_equal(k_thread_cbs_set(b, 5000, 10000), -EBUSY,
+		      "CPU overcommitted");
+	zassert_equal(k_thread_cbs_set(b, 4000, 10000), 0, "");
+
+	/* Changing a budget only counts the new share */
+	zassert_equal(k_thread_cbs_set(a, 6000, 10000), -EBUSY, "");
+	zassert_equal(k_thread_cbs_set(a, 2000, 10000), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 7000, 10000), 0, "");
+
+	/* Removing a budget releases its share */
+	zassert_equal(k_thread_cbs_set(a, 0, 0), 0, "");
+	zassert_equal(k_thread_cbs_stats_get(a, &stats), -EINVAL, "");
+	zassert_equal(k_thread_cbs_set(a, 2000, 10000), 0, "");
+
+	/* So does aborting the thread */
+	k_thread_abort(b);
+	zassert_equal(k_thread_cbs_set(a, 8000, 10000), 0, "");
+
+	cleanup();
+}
+
+/**
+ * @brief Test that threads with budgets run in deadline order
+ */
+void test_cbs_edf(void)
+{
+	k_tid_t a = spawn(0, worker, PRIO);
+	k_tid_t b = spawn(1, worker, PRIO);
+
+	zassert_equal(k_thread_cbs_set(a, 1000, 20000), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 1000, 10000), 0, "");
+
+	k_thread_start(a);
+	k_thread_start(b);
+	zassert_equal(n_exec, 0, "threads ran too soon");
+
+	k_sleep(K_MSEC(50));
+
+	zassert_equal(n_exec, NUM_THREADS, "not enough threads ran");
+	zassert_equal(exec_order[0], 1, "threads ran in wrong order");
+	zassert_equal(exec_order[1], 0, "threads ran in wrong order");
+
+	cleanup();
+}
+
+/**
+ * @brief Test that a thread is throttled once it used up its budget
+ *
+ * A busy thread with a budget runs against a busy thread of lower
+ * priority, which only gets the CPU while the first one is throttled.
+ */
+void test_cbs_throttle(void)
+{
+	struct k_thread_cbs_stats stats;
+	k_tid_t a = spawn(0, busy_worker, PRIO - 1);
+	k_tid_t b = spawn(1, busy_worker, PRIO);
+
+	zassert_equal(k_thread_cbs_set(a, BUDGET_US, PERIOD_US), 0, "");
+
+	k_thread_start(a);
+	k_thread_start(b);
+
+	k_sleep(K_MSEC(BUSY_MS + 50));
+
+	zassert_equal(k_thread_cbs_stats_get(a, &stats), 0, "");
+	zassert_true(stats.overruns >= (BUSY_MS * 1000 / PERIOD_US) - 1,
+		     "%u overruns", stats.overruns);
+	zassert_true(stats.throttles > 0, "thread never throttled");
+
+	/* The busy thread got about its share of the CPU, and the
+	 * other one the rest
+	 */
+	zassert_true(busy_loops[0] < busy_loops[1],
+		     "budget not enforced: %d vs %d loops",
+		     busy_loops[0], busy_loops[1]);
+	zassert_true(busy_loops[1] > 0, "lower priority thread starved");
+
+	cleanup();
+}
+
+void test_main(void)
+{
+	ztest_test_suite(suite_cbs,
+			 ztest_unit_test(test_cbs_admission),
+			 ztest_unit_test(test_cbs_edf),
+			 ztest_unit_test(test_cbs_throttle));
+	ztest_run_test_suite(suite_cbs);
+}
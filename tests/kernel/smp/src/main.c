@@ -624,6 +624,82 @@ void test_smp_ipi(void)
 	}
 }
 
+#ifdef CONFIG_MUTEX_SPIN
+/* Held well within CONFIG_MUTEX_SPIN_USEC, see testcase.yaml */
+#define MUTEX_HOLD_US (CONFIG_MUTEX_SPIN_USEC / 10)
+
+static K_MUTEX_DEFINE(spin_mutex);
+static volatile bool mutex_held;
+static volatile int owner_prio;
+
+static void mutex_owner_fn(void *p1, void *p2, void *p3)
+{
+	bool block = (bool)POINTER_TO_INT(p1);
+
+	k_mutex_lock(&spin_mutex, K_FOREVER);
+	mutex_held = true;
+
+	if (block) {
+		k_msleep(100);
+	} else {
+		k_busy_wait(MUTEX_HOLD_US);
+	}
+
+	owner_prio = k_thread_priority_get(k_current_get());
+	k_mutex_unlock(&spin_mutex);
+}
+
+static void mutex_contend(bool block)
+{
+	k_tid_t tid;
+
+	mutex_held = false;
+	owner_prio = INT_MIN;
+
+	tid = k_thread_create(&t2, t2_stack, T2_STACK_SIZE, mutex_owner_fn,
+			      INT_TO_POINTER(block), NULL, NULL,
+			      K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	while (!mutex_held) {
+	}
+
+	zassert_equal(k_mutex_lock(&spin_mutex, K_FOREVER), 0, NULL);
+	zassert_true(owner_prio != INT_MIN, "mutex taken while held");
+	k_mutex_unlock(&spin_mutex);
+
+	k_thread_join(tid, K_FOREVER);
+}
+#endif
+
+/**
+ * @brief Test adaptive spinning on contended mutexes
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Lock a mutex held by a thread running on another CPU for a
+ * short while, and check that the owner's priority was not raised,
+ * i.e. that the caller spun instead of pending. Then lock it while the
+ * owner sleeps holding it, and check that the caller pended and the
+ * owner inherited its priority.
+ *
+ * @see k_mutex_lock()
+ */
+void test_mutex_spin(void)
+{
+#ifdef CONFIG_MUTEX_SPIN
+	int prio = k_thread_priority_get(k_current_get());
+
+	mutex_contend(false);
+	zassert_equal(owner_prio, K_PRIO_PREEMPT(1),
+		      "owner boosted, caller did not spin");
+
+	mutex_contend(true);
+	zassert_equal(owner_prio, prio, "owner did not inherit priority");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -641,7 +717,8 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
-			 ztest_unit_test(test_get_cpu)
+			 ztest_unit_test(test_get_cpu),
+			 ztest_unit_test(test_mutex_spin)
 			 );
 	ztest_run_test_suite(smp);
 }
@@ -1412,6 +1412,51 @@ void test_cancel_processed_work_item(void)
 	k_sleep(TIMEOUT);
 }
 
+/**
+ * @brief Test delayed work expiry slack
+ * @details Check that delayed work items with a slack expire no
+ * earlier than their delay, no later than their delay plus the slack,
+ * on a tick aligned to the slack, and are still processed.
+ * @ingroup kernel_workqueue_tests
+ * @see k_delayed_work_slack_set()
+ */
+void test_delayed_work_slack(void)
+{
+#ifdef CONFIG_WORKQUEUE_COALESCE
+	const k_ticks_t slack = 64;
+	k_ticks_t start, end, exp;
+
+	k_sem_reset(&sync_sema);
+
+	start = k_uptime_ticks();
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		k_delayed_work_init(&delayed_work[i], common_work_handler);
+		k_delayed_work_slack_set(&delayed_work[i], K_TICKS(slack));
+		k_delayed_work_submit_to_queue(&workq, &delayed_work[i],
+					       K_TICKS(10 * (i + 1)));
+	}
+	end = k_uptime_ticks();
+
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		exp = k_delayed_work_expires_ticks(&delayed_work[i]);
+
+		/**TESTPOINT: expiry within [delay, delay + slack]*/
+		zassert_true(exp >= start + 10 * (i + 1), "expires too early");
+		zassert_true(exp <= end + 10 * (i + 1) + 1 + slack,
+			     "expires too late");
+		/**TESTPOINT: expiry aligned to the slack*/
+		zassert_equal(exp % slack, 0, "expiry not coalesced");
+	}
+
+	for (int i = 0; i < NUM_OF_WORK; i++) {
+		zassert_equal(k_sem_take(&sync_sema, K_TICKS(4 * slack)), 0,
+			      NULL);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	main_thread = k_current_get();
@@ -1461,6 +1506,7 @@ void test_main(void)
 			 ztest_unit_test(test_process_work_items_fifo),
 			 ztest_unit_test(test_sched_delayed_work_item),
 			 ztest_unit_test(test_workqueue_max_number),
-			 ztest_unit_test(test_cancel_processed_work_item));
+			 ztest_unit_test(test_cancel_processed_work_item),
+			 ztest_1cpu_unit_test(test_delayed_work_slack));
 	ztest_run_test_suite(workqueue_api);
 }
@@ -323,13 +323,89 @@ static void test_realloc(void)
 		     "Realloc should have moved %p", p2);
 }
 
+/* Check the runtime statistics against a known sequence of
+ * allocations: usage and peak accounting, free block counts and the
+ * fragmentation index of a heap with holes, and the latency
+ * histograms.
+ */
+static void test_runtime_stats(void)
+{
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	struct sys_heap heap;
+	struct sys_heap_runtime_stats stats;
+	void *p[10];
+	size_t peak;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_equal(sys_heap_runtime_stats_get(&heap, &stats), 0, "");
+	zassert_equal(stats.allocated_bytes, 0, "empty heap in use");
+	zassert_equal(stats.free_blocks, 1, "empty heap fragmented");
+	zassert_equal(stats.fragmentation, 0, "");
+	zassert_true(stats.largest_free_bytes < stats.free_bytes, "");
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = sys_heap_alloc(&heap, 64);
+		zassert_not_null(p[i], "");
+	}
+	zassert_true(sys_heap_validate(&heap), "stats out of sync");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_true(stats.allocated_bytes >= ARRAY_SIZE(p) * 64, "");
+	zassert_equal(stats.max_allocated_bytes, stats.allocated_bytes, "");
+	peak = stats.max_allocated_bytes;
+
+	/* Free every other block: each becomes a separate hole */
+	for (int i = 0; i < ARRAY_SIZE(p); i += 2) {
+		sys_heap_free(&heap, p[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "stats out of sync");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.free_blocks, ARRAY_SIZE(p) / 2 + 1, "");
+	zassert_true(stats.fragmentation > 0, "holes not seen");
+	zassert_equal(stats.max_allocated_bytes, peak, "");
+
+	for (int i = 1; i < ARRAY_SIZE(p); i += 2) {
+		sys_heap_free(&heap, p[i]);
+	}
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.allocated_bytes, 0, "leaked accounting");
+	zassert_equal(stats.free_blocks, 1, "free blocks not merged");
+	zassert_equal(stats.max_allocated_bytes, peak, "");
+
+	zassert_equal(sys_heap_runtime_stats_reset_max(&heap), 0, "");
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.max_allocated_bytes, 0, "peak not reset");
+
+#ifdef CONFIG_SYS_HEAP_LATENCY_STATS
+	uint32_t nalloc = 0, nfree = 0;
+
+	sys_heap_free(&heap, sys_heap_alloc(&heap, 16));
+	sys_heap_free(&heap, sys_heap_aligned_alloc(&heap, 64, 16));
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	for (int i = 0; i < SYS_HEAP_LATENCY_BINS; i++) {
+		nalloc += stats.alloc_cycles[i];
+		nfree += stats.free_cycles[i];
+	}
+	zassert_equal(nalloc, 2, "allocations not counted");
+	zassert_equal(nfree, 2, "frees not counted");
+#endif
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
 			 ztest_unit_test(test_realloc),
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_runtime_stats)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
@@ -270,13 +270,183 @@ static void test_p4wq_simple(void)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+#ifdef CONFIG_P4WQ_EXECUTOR
+#define POOL_MAX 4
+
+K_P4WQ_POOL_DEFINE(pool, 1, POOL_MAX, 2048, 0);
+
+static struct k_p4wq_work dag_items[4];
+static struct k_p4wq_dep dag_deps[4];
+static int dag_order[4];
+static int dag_count;
+static volatile int pool_release;
+
+/* Items are reused by the tests below: start them afresh, with
+ * garbage in the fields k_p4wq_work_init() takes care of
+ */
+static void dag_items_init(void)
+{
+	memset(dag_items, 0xa5, sizeof(dag_items));
+	for (int i = 0; i < ARRAY_SIZE(dag_items); i++) {
+		k_p4wq_work_init(&dag_items[i]);
+	}
+}
+
+static void dag_handler(struct k_p4wq_work *item)
+{
+	k_spinlock_key_t k = k_spin_lock(&lock);
+
+	dag_order[dag_count++] = item - dag_items;
+	k_spin_unlock(&lock, k);
+}
+
+/* Validate completion futures on single items */
+static void test_wait(void)
+{
+	struct k_p4wq_work *a = &dag_items[0], *b = &dag_items[1];
+
+	k_thread_priority_set(k_current_get(), 2);
+	dag_items_init();
+	dag_count = 0;
+
+	zassert_equal(k_p4wq_wait(a, K_FOREVER), -EINVAL,
+		      "waited for unsubmitted item");
+
+	a->priority = 3;
+	a->handler = dag_handler;
+	k_p4wq_submit(&wq, a);
+	zassert_equal(k_p4wq_wait(a, K_NO_WAIT), -EBUSY,
+		      "low priority item completed too early");
+	zassert_equal(k_p4wq_wait(a, K_FOREVER), 0, "wait failed");
+	zassert_equal(dag_count, 1, "item didn't run");
+	zassert_equal(k_p4wq_wait(a, K_NO_WAIT), 0,
+		      "completion not sticky");
+
+	/* An item held back by an unsubmitted prerequisite times out */
+	b->priority = 3;
+	b->handler = dag_handler;
+	zassert_equal(k_p4wq_work_depend(b, a, &dag_deps[0]), 0, "");
+	k_p4wq_submit(&wq, b);
+	zassert_equal(k_p4wq_work_depend(b, a, &dag_deps[1]), -EBUSY,
+		      "dependency added to submitted item");
+	zassert_equal(k_p4wq_wait(b, K_MSEC(10)), -EAGAIN,
+		      "held back item ran");
+	zassert_true(k_p4wq_cancel(&wq, b), "held back item not cancelable");
+	zassert_equal(dag_count, 1, "cancelled item ran");
+	zassert_equal(k_p4wq_wait(b, K_FOREVER), -EINVAL,
+		      "waited for cancelled item");
+}
+
+/* Diamond-shaped graph: 0 -> (1, 2) -> 3, submitted in reverse */
+static void test_dag(void)
+{
+	static const int edges[4][2] = { { 1, 0 }, { 2, 0 }, { 3, 1 }, { 3, 2 } };
+
+	k_thread_priority_set(k_current_get(), 2);
+	dag_items_init();
+	dag_count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(dag_items); i++) {
+		dag_items[i].priority = 1;
+		dag_items[i].handler = dag_handler;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(edges); i++) {
+		zassert_equal(k_p4wq_work_depend(&dag_items[edges[i][0]],
+						 &dag_items[edges[i][1]],
+						 &dag_deps[i]), 0, "");
+	}
+
+	for (int i = ARRAY_SIZE(dag_items) - 1; i > 0; i--) {
+		k_p4wq_submit(&wq, &dag_items[i]);
+	}
+	zassert_equal(dag_count, 0, "item ran before its prerequisites");
+
+	/* Higher priority than us: the whole graph runs synchronously */
+	k_p4wq_submit(&wq, &dag_items[0]);
+	zassert_equal(k_p4wq_wait(&dag_items[3], K_MSEC(100)), 0,
+		      "graph didn't complete");
+	zassert_equal(dag_count, 4, "wrong run count %d", dag_count);
+	zassert_equal(dag_order[0], 0, "root didn't run first");
+	zassert_equal(dag_order[3], 3, "sink didn't run last");
+}
+
+static void pool_handler(struct k_p4wq_work *item)
+{
+	while (!pool_release) {
+		k_busy_wait(10);
+	}
+}
+
+/* Validate that the pool grows to run preempting items and shrinks
+ * back to its minimum when idle
+ */
+static void test_pool_grow_shrink(void)
+{
+	k_thread_priority_set(k_current_get(), -1);
+	dag_items_init();
+	pool_release = 0;
+
+	zassert_equal(k_p4wq_pool_size(&pool), 1, "wrong initial pool size");
+
+	/* Each item outranks the running ones, so needs its own thread */
+	for (int i = 0; i < POOL_MAX; i++) {
+		dag_items[i].priority = POOL_MAX - i;
+		dag_items[i].handler = pool_handler;
+		k_p4wq_submit(&pool, &dag_items[i]);
+		zassert_equal(k_p4wq_pool_size(&pool), i + 1,
+			      "pool didn't grow");
+	}
+
+	k_msleep(1);
+	pool_release = 1;
+	for (int i = 0; i < POOL_MAX; i++) {
+		zassert_equal(k_p4wq_wait(&dag_items[i], K_MSEC(100)), 0,
+			      "item %d didn't complete", i);
+	}
+	zassert_equal(k_p4wq_pool_size(&pool), POOL_MAX, "pool shrank early");
+
+	k_msleep(CONFIG_P4WQ_IDLE_TIMEOUT_MS * 3);
+	zassert_equal(k_p4wq_pool_size(&pool), 1, "pool didn't shrink");
+
+	/* Retired thread slots are reused */
+	pool_release = 0;
+	for (int i = 0; i < 2; i++) {
+		k_p4wq_submit(&pool, &dag_items[i]);
+	}
+	zassert_equal(k_p4wq_pool_size(&pool), 2, "pool didn't regrow");
+	pool_release = 1;
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(k_p4wq_wait(&dag_items[i], K_MSEC(100)), 0, "");
+	}
+}
+#else
+static void test_wait(void)
+{
+	ztest_test_skip();
+}
+
+static void test_dag(void)
+{
+	ztest_test_skip();
+}
+
+static void test_pool_grow_shrink(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(lib_p4wq_test,
 			 ztest_1cpu_unit_test(test_p4wq_simple),
 			 ztest_unit_test(test_resubmit),
 			 ztest_unit_test(test_fill_queue),
-			 ztest_unit_test(test_stress));
+			 ztest_unit_test(test_stress),
+			 ztest_1cpu_unit_test(test_wait),
+			 ztest_1cpu_unit_test(test_dag),
+			 ztest_1cpu_unit_test(test_pool_grow_shrink));
 
 	ztest_run_test_suite(lib_p4wq_test);
 }
@@ -907,6 +907,316 @@ void test_ringbuffer_performance(void)
 	PRINT("5 byte get claim-finish, avg cycles: %d\n", timestamp/loop);
 }
 
+/**
+ * @brief Test two-segment claims of a byte mode ring buffer
+ *
+ * @details Put data wrapping around the end of the buffer and check
+ * that ring_buf_get_claim_sg() returns all of it as two segments,
+ * then claim wrapping free space with ring_buf_put_claim_sg().
+ *
+ * @see ring_buf_get_claim_sg(), ring_buf_put_claim_sg()
+ */
+void test_ringbuffer_claim_sg(void)
+{
+	struct ring_buf rb;
+	struct ring_buf_seg seg[2];
+	uint8_t storage[8];
+	uint8_t in[6] = { 1, 2, 3, 4, 5, 6 };
+	uint8_t out[6];
+
+	ring_buf_init(&rb, sizeof(storage), storage);
+
+	/* Move the indexes near the end of the buffer */
+	zassert_equal(ring_buf_put(&rb, in, 6), 6, NULL);
+	zassert_equal(ring_buf_get(&rb, out, 6), 6, NULL);
+
+	/* Data wraps: two segments */
+	zassert_equal(ring_buf_put(&rb, in, 6), 6, NULL);
+	zassert_equal(ring_buf_get_claim_sg(&rb, seg, sizeof(storage)), 6,
+		      NULL);
+	zassert_equal(seg[0].data, &storage[6], NULL);
+	zassert_equal(seg[0].size, 2, NULL);
+	zassert_equal(seg[1].data, &storage[0], NULL);
+	zassert_equal(seg[1].size, 4, NULL);
+	zassert_mem_equal(seg[0].data, &in[0], 2, NULL);
+	zassert_mem_equal(seg[1].data, &in[2], 4, NULL);
+	zassert_equal(ring_buf_get_finish(&rb, 6), 0, NULL);
+	zassert_true(ring_buf_is_empty(&rb), NULL);
+
+	/* Free space wraps too */
+	zassert_equal(ring_buf_put_claim_sg(&rb, seg, sizeof(storage)),
+		      sizeof(storage), NULL);
+	zassert_equal(seg[0].data, &storage[4], NULL);
+	zassert_equal(seg[0].size, 4, NULL);
+	zassert_equal(seg[1].data, &storage[0], NULL);
+	zassert_equal(seg[1].size, 4, NULL);
+	zassert_equal(ring_buf_put_finish(&rb, 5), 0, NULL);
+
+	/* Contiguous data: single segment */
+	zassert_equal(ring_buf_get_claim_sg(&rb, seg, 3), 3, NULL);
+	zassert_equal(seg[0].size, 3, NULL);
+	zassert_equal(seg[1].size, 0, NULL);
+	zassert_is_null(seg[1].data, NULL);
+	zassert_equal(ring_buf_get_finish(&rb, 3), 0, NULL);
+
+	/* Less data than requested: no second segment once it runs out */
+	zassert_equal(ring_buf_get_claim_sg(&rb, seg, sizeof(storage)), 2,
+		      NULL);
+	zassert_equal(ring_buf_get_finish(&rb, 2), 0, NULL);
+	zassert_equal(ring_buf_get_claim_sg(&rb, seg, 4), 0, NULL);
+	zassert_equal(seg[1].size, 0, NULL);
+	zassert_is_null(seg[1].data, NULL);
+	zassert_equal(ring_buf_get_finish(&rb, 0), 0, NULL);
+}
+
+/**
+ * @brief Test batched item put and get
+ *
+ * @details Put a batch of items, check that items which do not fit
+ * are dropped, then read them back in one batch.
+ *
+ * @see ring_buf_item_put_batch(), ring_buf_item_get_batch()
+ */
+void test_ringbuffer_item_batch(void)
+{
+	struct ring_buf rb;
+	uint32_t storage[16];
+	uint32_t data[5] = { 10, 11, 12, 13, 14 };
+	uint32_t out[4][8];
+	struct ring_buf_item items[4] = {
+		{ .data = data, .type = 1, .value = 10, .size32 = 2 },
+		{ .data = data, .type = 2, .value = 20, .size32 = 3 },
+		{ .data = data, .type = 3, .value = 30, .size32 = 0 },
+		{ .data = data, .type = 4, .value = 40, .size32 = 5 },
+	};
+	struct ring_buf_item rd[4];
+
+	ring_buf_init(&rb, ARRAY_SIZE(storage), storage);
+
+	/* 3 + 4 + 1 + 6 = 14 words */
+	zassert_equal(ring_buf_item_put_batch(&rb, items, 4), 4, NULL);
+	zassert_equal(ring_buf_space_get(&rb), 2, NULL);
+	zassert_equal(ring_buf_item_put_batch(&rb, items, 2), 0, NULL);
+	zassert_equal(rb.misc.item_mode.dropped_put_count, 2, NULL);
+
+	for (int i = 0; i < ARRAY_SIZE(rd); i++) {
+		rd[i].data = out[i];
+		rd[i].size32 = ARRAY_SIZE(out[i]);
+	}
+
+	/* The first item does not fit */
+	rd[0].size32 = 1;
+	zassert_equal(ring_buf_item_get_batch(&rb, rd, 3), -EMSGSIZE, NULL);
+	zassert_equal(rd[0].size32, 2, NULL);
+
+	zassert_equal(ring_buf_item_get_batch(&rb, rd, 3), 3, NULL);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(rd[i].type, items[i].type, NULL);
+		zassert_equal(rd[i].value, items[i].value, NULL);
+		zassert_equal(rd[i].size32, items[i].size32, NULL);
+		zassert_mem_equal(rd[i].data, data, 4 * rd[i].size32, NULL);
+	}
+
+	/* Only the last item is left */
+	rd[0].size32 = ARRAY_SIZE(out[0]);
+	zassert_equal(ring_buf_item_get_batch(&rb, rd, 4), 1, NULL);
+	zassert_equal(rd[0].type, 4, NULL);
+	zassert_equal(rd[0].size32, 5, NULL);
+	zassert_true(ring_buf_is_empty(&rb), NULL);
+	zassert_equal(ring_buf_item_get_batch(&rb, rd, 4), 0, NULL);
+}
+
+RING_BUF_MP_DECLARE(mp_ring, 12, 3);
+
+/**
+ * @brief Test put/get of the lock-free multi-producer ring buffer
+ *
+ * @details Fill the ring with records of different sizes, check that
+ * it refuses more and returns them in order with their sizes.
+ *
+ * @see ring_buf_mp_put(), ring_buf_mp_get()
+ */
+void test_ringbuffer_mp_put_get(void)
+{
+	uint8_t in[12], out[12];
+	int n = mp_ring.mask + 1;
+
+	for (int i = 0; i < sizeof(in); i++) {
+		in[i] = i;
+	}
+
+	zassert_true(ring_buf_mp_is_empty(&mp_ring), NULL);
+	zassert_equal(ring_buf_mp_put(&mp_ring, in, sizeof(in) + 1),
+		      -EINVAL, NULL);
+
+	for (int lap = 0; lap < 3; lap++) {
+		for (int i = 0; i < n; i++) {
+			zassert_equal(ring_buf_mp_put(&mp_ring, in, 1 + i),
+				      0, NULL);
+		}
+		zassert_equal(ring_buf_mp_put(&mp_ring, in, 1), -EMSGSIZE,
+			      "put to a full ring");
+
+		for (int i = 0; i < n; i++) {
+			zassert_equal(ring_buf_mp_get(&mp_ring, out,
+						      sizeof(out)),
+				      1 + i, "wrong record size");
+			zassert_mem_equal(out, in, 1 + i, NULL);
+		}
+		zassert_equal(ring_buf_mp_get(&mp_ring, out, sizeof(out)), 0,
+			      "get from an empty ring");
+		zassert_true(ring_buf_mp_is_empty(&mp_ring), NULL);
+	}
+}
+
+/**
+ * @brief Test claim/finish ordering of the multi-producer ring buffer
+ *
+ * @details A record finished before an older claim is only visible
+ * once that claim is finished, and a claim finished with no data is
+ * skipped by readers.
+ *
+ * @see ring_buf_mp_put_claim(), ring_buf_mp_put_finish(),
+ * ring_buf_mp_get_claim(), ring_buf_mp_get_finish()
+ */
+void test_ringbuffer_mp_claim_order(void)
+{
+	uint8_t *a, *b, *c, *data;
+
+	zassert_equal(ring_buf_mp_put_claim(&mp_ring, &a), 12, NULL);
+	zassert_equal(ring_buf_mp_put_claim(&mp_ring, &b), 12, NULL);
+	zassert_equal(ring_buf_mp_put_claim(&mp_ring, &c), 12, NULL);
+	zassert_true(a != b && b != c, NULL);
+
+	b[0] = 'b';
+	zassert_equal(ring_buf_mp_put_finish(&mp_ring, b, 1), 0, NULL);
+	zassert_equal(ring_buf_mp_put_finish(&mp_ring, c, 0), 0, NULL);
+	zassert_equal(ring_buf_mp_get_claim(&mp_ring, &data), 0,
+		      "record visible before an older claim was finished");
+
+	a[0] = 'a';
+	zassert_equal(ring_buf_mp_put_finish(&mp_ring, a, 1), 0, NULL);
+
+	zassert_equal(ring_buf_mp_get_claim(&mp_ring, &data), 1, NULL);
+	zassert_equal(data[0], 'a', NULL);
+	ring_buf_mp_get_finish(&mp_ring, data);
+	zassert_equal(ring_buf_mp_get_claim(&mp_ring, &data), 1, NULL);
+	zassert_equal(data[0], 'b', NULL);
+	ring_buf_mp_get_finish(&mp_ring, data);
+
+	/* The discarded claim is skipped */
+	zassert_equal(ring_buf_mp_get_claim(&mp_ring, &data), 0, NULL);
+	zassert_true(ring_buf_mp_is_empty(&mp_ring), NULL);
+}
+
+/**
+ * @brief Test finishing a multi-producer claim with an invalid size
+ *
+ * @details The claim must still be released, as a discarded record,
+ * so that the records put after it can be read.
+ *
+ * @see ring_buf_mp_put_finish()
+ */
+void test_ringbuffer_mp_finish_invalid(void)
+{
+	uint8_t *a, *data;
+	uint8_t in = 'x', out;
+
+	zassert_equal(ring_buf_mp_put_claim(&mp_ring, &a), 12, NULL);
+	zassert_equal(ring_buf_mp_put(&mp_ring, &in, 1), 0, NULL);
+	zassert_equal(ring_buf_mp_put_finish(&mp_ring, a, 13), -EINVAL, NULL);
+
+	zassert_equal(ring_buf_mp_get(&mp_ring, &out, 1), 1,
+		      "ring stalled on an invalid record");
+	zassert_equal(out, 'x', NULL);
+	zassert_equal(ring_buf_mp_get_claim(&mp_ring, &data), 0, NULL);
+	zassert_true(ring_buf_mp_is_empty(&mp_ring), NULL);
+}
+
+#define MP_PRODUCERS 3
+#define MP_RECORDS 1000
+#define MP_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_THREAD_STACK_ARRAY_DEFINE(mp_stacks, MP_PRODUCERS, MP_STACK_SIZE);
+static struct k_thread mp_threads[MP_PRODUCERS];
+static uint32_t mp_isr_seq;
+
+static void mp_put_record(uint32_t id, uint32_t seq)
+{
+	uint32_t rec[2] = { id, seq };
+
+	while (ring_buf_mp_put(&mp_ring, (uint8_t *)rec, sizeof(rec)) != 0) {
+		k_yield();
+	}
+}
+
+static void mp_isr_producer(const void *arg)
+{
+	uint32_t rec[2] = { MP_PRODUCERS, mp_isr_seq };
+
+	ARG_UNUSED(arg);
+
+	if (ring_buf_mp_put(&mp_ring, (uint8_t *)rec, sizeof(rec)) == 0) {
+		mp_isr_seq++;
+	}
+}
+
+static void mp_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+
+	for (uint32_t seq = 0; seq < MP_RECORDS; seq++) {
+		mp_put_record(id, seq);
+		if (id == 0U && mp_isr_seq < MP_RECORDS) {
+			irq_offload(mp_isr_producer, NULL);
+		}
+	}
+}
+
+/**
+ * @brief Test concurrent producers of the multi-producer ring buffer
+ *
+ * @details Several threads and an ISR put numbered records without
+ * any locking while the test thread reads them: each producer's
+ * records must be received exactly once and in order.
+ */
+void test_ringbuffer_mp_concurrent(void)
+{
+	uint32_t next[MP_PRODUCERS + 1] = { 0 };
+	uint32_t rec[2], total = 0;
+	int prio = k_thread_priority_get(k_current_get());
+
+	mp_isr_seq = 0;
+
+	for (int i = 0; i < MP_PRODUCERS; i++) {
+		k_thread_create(&mp_threads[i], mp_stacks[i], MP_STACK_SIZE,
+				mp_producer, UINT_TO_POINTER(i), NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	while (total < MP_PRODUCERS * MP_RECORDS ||
+	       next[MP_PRODUCERS] < mp_isr_seq) {
+		if (ring_buf_mp_get(&mp_ring, (uint8_t *)rec,
+				    sizeof(rec)) == 0) {
+			k_yield();
+			continue;
+		}
+
+		zassert_true(rec[0] <= MP_PRODUCERS, "corrupted record");
+		zassert_equal(rec[1], next[rec[0]], "record lost or reordered");
+		next[rec[0]]++;
+		if (rec[0] < MP_PRODUCERS) {
+			total++;
+		}
+	}
+
+	for (int i = 0; i < MP_PRODUCERS; i++) {
+		k_thread_join(&mp_threads[i], K_FOREVER);
+		zassert_equal(next[i], MP_RECORDS, NULL);
+	}
+	zassert_true(ring_buf_mp_is_empty(&mp_ring), NULL);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -929,7 +1239,13 @@ void test_main(void)
 		       ztest_unit_test(test_ringbuffer_equal_bufs),
 		       ztest_unit_test(test_capacity),
 		       ztest_unit_test(test_reset),
-		       ztest_unit_test(test_ringbuffer_performance)
+		       ztest_unit_test(test_ringbuffer_performance),
+		       ztest_unit_test(test_ringbuffer_claim_sg),
+		       ztest_unit_test(test_ringbuffer_item_batch),
+		       ztest_unit_test(test_ringbuffer_mp_put_get),
+		       ztest_unit_test(test_ringbuffer_mp_claim_order),
+		       ztest_unit_test(test_ringbuffer_mp_finish_invalid),
+		       ztest_unit_test(test_ringbuffer_mp_concurrent)
 		);
 	ztest_run_test_suite(test_ringbuffer_api);
 }
@@ -0,0 +1,347 @@
+/* main.c - Batched packet reception tests */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <net/net_core.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#include "connection.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define LOCAL_PORT 4242
+#define REMOTE_PORT 4243
+
+#define MAX_PKTS 16
+#define MARKER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr remote_addr = { { { 192, 0, 2, 2 } } };
+static uint8_t mac_addr[6] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static struct net_if *iface;
+static struct net_conn_handle *handle;
+static K_SEM_DEFINE(all_delivered, 0, 1);
+
+/* Packets in the order they were delivered, their traffic class and the
+ * thread that delivered them
+ */
+static struct net_pkt *delivered[MAX_PKTS];
+static int delivered_tc[MAX_PKTS];
+static k_tid_t delivered_by[MAX_PKTS];
+static int delivered_count;
+static int expected;
+
+static struct k_thread marker_thread;
+static K_THREAD_STACK_DEFINE(marker_stack, MARKER_STACK_SIZE);
+static bool start_marker;
+static volatile int marker_seen;
+
+static int dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api dummy_api_funcs = {
+	.iface_api.init = iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(recv_list_test, "recv_list_test", dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api_funcs,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static void marker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	marker_seen = delivered_count;
+}
+
+static enum net_verdict udp_cb(struct net_conn *conn, struct net_pkt *pkt,
+			       union net_ip_header *ip_hdr,
+			       union net_proto_header *proto_hdr,
+			       void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* A thread of the same priority as the RX thread only gets to run
+	 * when the RX thread yields.
+	 */
+	if (start_marker) {
+		start_marker = false;
+		k_thread_create(&marker_thread, marker_stack,
+				K_THREAD_STACK_SIZEOF(marker_stack), marker,
+				NULL, NULL, NULL,
+				k_thread_priority_get(k_current_get()), 0,
+				K_NO_WAIT);
+	}
+
+	delivered[delivered_count] = pkt;
+	delivered_tc[delivered_count] =
+		net_rx_priority2tc(net_pkt_priority(pkt));
+	delivered_by[delivered_count] = k_current_get();
+
+	if (++delivered_count == expected) {
+		k_sem_give(&all_delivered);
+	}
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_pkt *udp_pkt(enum net_priority prio)
+{
+	static const uint8_t payload[8];
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(payload), AF_INET,
+					   IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_equal(net_ipv4_create(pkt, &remote_addr, &local_addr), 0,
+		      "Cannot create IPv4 header");
+	zassert_equal(net_udp_create(pkt, htons(REMOTE_PORT),
+				     htons(LOCAL_PORT)), 0,
+		      "Cannot create UDP header");
+	zassert_equal(net_pkt_write(pkt, payload, sizeof(payload)), 0,
+		      "Cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+	net_pkt_cursor_init(pkt);
+
+	net_pkt_set_priority(pkt, prio);
+
+	return pkt;
+}
+
+static void recv_setup(int count)
+{
+	delivered_count = 0;
+	expected = count;
+	k_sem_reset(&all_delivered);
+}
+
+static void test_recv_list_setup(void)
+{
+	struct sockaddr_in local = { 0 };
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No dummy interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &local_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	local.sin_family = AF_INET;
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+				(struct sockaddr *)&local, 0, LOCAL_PORT,
+				udp_cb, NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler (%d)", ret);
+}
+
+/* Packets of each traffic class are handled by its own thread, in the
+ * order they had in the list.
+ */
+static void test_recv_list_traffic_class(void)
+{
+	static const enum net_priority prios[] = {
+		NET_PRIORITY_BK, NET_PRIORITY_NC, NET_PRIORITY_BE,
+		NET_PRIORITY_NC, NET_PRIORITY_BK, NET_PRIORITY_VO,
+		NET_PRIORITY_BE, NET_PRIORITY_VO,
+	};
+	struct net_pkt *pkts[ARRAY_SIZE(prios)];
+	k_tid_t tc_thread[NET_TC_RX_COUNT] = { 0 };
+	sys_slist_t list;
+	int tc, i, j;
+
+	sys_slist_init(&list);
+
+	for (i = 0; i < ARRAY_SIZE(prios); i++) {
+		pkts[i] = udp_pkt(prios[i]);
+		sys_slist_append(&list, &pkts[i]->rx_node);
+	}
+
+	recv_setup(ARRAY_SIZE(prios));
+
+	zassert_equal(net_recv_data_list(iface, &list), 0,
+		      "Batch not received");
+	zassert_true(sys_slist_is_empty(&list), "Packets left in list");
+	zassert_equal(k_sem_take(&all_delivered, K_SECONDS(1)), 0,
+		      "Only %d packets delivered", delivered_count);
+
+	for (tc = 0; tc < NET_TC_RX_COUNT; tc++) {
+		j = 0;
+
+		for (i = 0; i < ARRAY_SIZE(prios); i++) {
+			if (net_rx_priority2tc(prios[i]) != tc) {
+				continue;
+			}
+
+			/* Next delivered packet of the same class */
+			while (delivered_tc[j] != tc) {
+				j++;
+			}
+
+			zassert_equal_ptr(delivered[j], pkts[i],
+					  "Packet %d out of order in TC %d",
+					  i, tc);
+
+			if (!tc_thread[tc]) {
+				tc_thread[tc] = delivered_by[j];
+			}
+			zassert_equal_ptr(delivered_by[j], tc_thread[tc],
+					  "TC %d handled by several threads",
+					  tc);
+			j++;
+		}
+	}
+
+	for (tc = 0; tc < NET_TC_RX_COUNT; tc++) {
+		for (i = tc + 1; i < NET_TC_RX_COUNT; i++) {
+			zassert_true(!tc_thread[tc] ||
+				     tc_thread[tc] != tc_thread[i],
+				     "TC %d and %d share a thread", tc, i);
+		}
+	}
+}
+
+/* Packets that cannot be received are left in the list, in order */
+static void test_recv_list_rejected(void)
+{
+	struct net_pkt *empty[2];
+	struct net_pkt *pkt;
+	sys_slist_t list;
+	int i;
+
+	empty[0] = net_pkt_rx_alloc(K_NO_WAIT);
+	empty[1] = net_pkt_rx_alloc(K_NO_WAIT);
+	zassert_true(empty[0] && empty[1], "Cannot allocate packet");
+
+	sys_slist_init(&list);
+	sys_slist_append(&list, &empty[0]->rx_node);
+	sys_slist_append(&list, &udp_pkt(NET_PRIORITY_BE)->rx_node);
+	sys_slist_append(&list, &empty[1]->rx_node);
+	sys_slist_append(&list, &udp_pkt(NET_PRIORITY_BE)->rx_node);
+
+	recv_setup(2);
+
+	zassert_equal(net_recv_data_list(iface, &list), -ENODATA,
+		      "Empty packets accepted");
+	zassert_equal(k_sem_take(&all_delivered, K_SECONDS(1)), 0,
+		      "Only %d packets delivered", delivered_count);
+
+	i = 0;
+	SYS_SLIST_FOR_EACH_CONTAINER(&list, pkt, rx_node) {
+		zassert_true(i < ARRAY_SIZE(empty), "Too many packets left");
+		zassert_equal_ptr(pkt, empty[i], "Wrong packet left");
+		i++;
+	}
+	zassert_equal(i, ARRAY_SIZE(empty), "Rejected packets missing");
+
+	net_pkt_unref(empty[0]);
+	net_pkt_unref(empty[1]);
+
+	/* Nothing goes through a down interface */
+	sys_slist_init(&list);
+	sys_slist_append(&list, &udp_pkt(NET_PRIORITY_BE)->rx_node);
+	sys_slist_append(&list, &udp_pkt(NET_PRIORITY_VO)->rx_node);
+
+	recv_setup(0);
+
+	zassert_equal(net_if_down(iface), 0, "Cannot take interface down");
+	zassert_equal(net_recv_data_list(iface, &list), -ENETDOWN,
+		      "Packets accepted by a down interface");
+	zassert_equal(net_if_up(iface), 0, "Cannot take interface up");
+
+	i = 0;
+	while ((pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&list, pkt, rx_node))) {
+		sys_slist_get(&list);
+		net_pkt_unref(pkt);
+		i++;
+	}
+	zassert_equal(i, 2, "Rejected packets missing");
+	zassert_equal(delivered_count, 0, "Packets delivered");
+}
+
+/* An RX thread handles CONFIG_NET_TC_RX_BUDGET packets, lets the other
+ * threads of its priority run, then continues with the rest.
+ */
+static void test_recv_list_budget(void)
+{
+	int count = CONFIG_NET_TC_RX_BUDGET * 3 + 1;
+	sys_slist_t list;
+	int i;
+
+	zassert_true(count <= MAX_PKTS, "Budget too large for the test");
+
+	sys_slist_init(&list);
+	for (i = 0; i < count; i++) {
+		sys_slist_append(&list, &udp_pkt(NET_PRIORITY_BE)->rx_node);
+	}
+
+	recv_setup(count);
+	marker_seen = -1;
+	start_marker = true;
+
+	zassert_equal(net_recv_data_list(iface, &list), 0,
+		      "Batch not received");
+	zassert_equal(k_sem_take(&all_delivered, K_SECONDS(1)), 0,
+		      "Only %d packets delivered", delivered_count);
+
+	k_thread_join(&marker_thread, K_FOREVER);
+	zassert_equal(marker_seen, CONFIG_NET_TC_RX_BUDGET,
+		      "RX thread yielded after %d packets", marker_seen);
+}
+
+static void test_recv_list_cleanup(void)
+{
+	zassert_equal(net_conn_unregister(handle), 0,
+		      "Cannot unregister UDP handler");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_recv_list,
+			 ztest_unit_test(test_recv_list_setup),
+			 ztest_unit_test(test_recv_list_traffic_class),
+			 ztest_unit_test(test_recv_list_rejected),
+			 ztest_unit_test(test_recv_list_budget),
+			 ztest_unit_test(test_recv_list_cleanup));
+
+	ztest_run_test_suite(net_recv_list);
+}
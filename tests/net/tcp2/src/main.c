@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "tcp2.h"
 #include "tcp2_priv.h"
 #include "net_stats.h"
+#include "net_private.h"
 
 #include <ztest.h>
 
@@ -119,6 +120,7 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_client_gso_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -207,6 +209,15 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Two segments, which fit in the send window of the test without ACK
+ * also with congestion control.
+ */
+#define GSO_MSS 536
+#define GSO_DATA_LEN (GSO_MSS + 100)
+
+static uint8_t gso_mss_option[4] = {
+	0x02, 0x04, 0x02, 0x18 /* Max segment of GSO_MSS */ };
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -215,13 +226,18 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	const uint8_t *opts = NULL;
 	struct net_pkt *pkt;
 	struct tcphdr *th;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if ((test_case_no == 10U) && (flags & SYN)) {
+		opts = gso_mss_option;
+		opts_len = sizeof(gso_mss_option);
 	}
 
 	/* Allocate buffer */
@@ -256,14 +272,14 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
+	th->th_off = 5U + opts_len / 4U;
+	th->th_flags = flags;
+
+	if (test_case_no == 10U) {
+		th->th_win = htons(UINT16_MAX);
 	} else {
-		th->th_off = 5U;
+		th->th_win = NET_IPV6_MTU;
 	}
-
-	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -275,9 +291,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -414,6 +430,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_client_gso_test(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1342,6 +1361,14 @@ static void handle_server_recv_out_of_order(struct net_pkt *pkt)
 		goto fail;
 	}
 
+	/* With congestion control the out-of-order segments are answered
+	 * right away with duplicate ACKs, skip them.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL) &&
+	    ntohl(th.th_ack) != expected_ack) {
+		return;
+	}
+
 	/* Verify that we received all the queued data */
 	zassert_equal(expected_ack, ntohl(th.th_ack),
 		      "Not all pending data received. "
@@ -1468,6 +1495,12 @@ static void test_server_timeout_out_of_order_data(void)
 		zassert_true(ret == 0, "recv data failed (%d)", ret);
 	}
 
+	/* Forget the duplicate ACKs sent for the out-of-order segments */
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+		k_msleep(1);
+		k_sem_reset(&test_sem);
+	}
+
 	/* Because the pending seq values are not sequential,
 	 * the recv queue in tcp2 should timeout.
 	 */
@@ -1478,6 +1511,139 @@ static void test_server_timeout_out_of_order_data(void)
 	net_tcp_put(ooo_ctx);
 }
 
+static uint32_t gso_next_seq;
+static size_t gso_received;
+
+static void handle_client_gso_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	sa_family_t af = net_pkt_family(pkt);
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		gso_next_seq = ntohl(th->th_seq) + 1U;
+		handle_client_test(af, th);
+		return;
+	case T_SYN_ACK:
+		handle_client_test(af, th);
+		return;
+	case T_DATA:
+		len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+
+		zassert_true(len > 0 && len <= GSO_MSS,
+			     "Segment of %zu bytes", len);
+		zassert_equal(ntohl(th->th_seq), gso_next_seq,
+			      "Segment out of sequence");
+		zassert_equal(net_calc_chksum_ipv4(pkt), 0,
+			      "Invalid IPv4 checksum");
+		zassert_equal(net_calc_chksum_tcp(pkt), 0,
+			      "Invalid TCP checksum");
+
+		gso_next_seq += len;
+		gso_received += len;
+
+		/* Only the last segment of a large one is pushed */
+		if (gso_received < GSO_DATA_LEN) {
+			test_verify_flags(th, IS_ENABLED(CONFIG_NET_TCP_GSO) ?
+					  ACK : PSH | ACK);
+			return;
+		}
+
+		test_verify_flags(th, PSH | ACK);
+		seq = 1U;
+		ack = gso_next_seq;
+		reply = prepare_ack_packet(af, htons(MY_PORT), th->th_sport);
+		t_state = T_FIN;
+		test_sem_give();
+		break;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_FIN_ACK;
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	zassert_true(ret >= 0, "%s failed", __func__);
+}
+
+/* Test case scenario IPv4
+ *   send SYN with MSS option,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   queue data of more than one MSS at once,
+ *   expect segments of at most MSS bytes of data in sequence,
+ *   send ACK,
+ *   expect FIN ACK,
+ *   send FIN ACK,
+ *   expect ACK.
+ *   any failures cause test case to fail.
+ */
+static void test_client_gso_ipv4(void)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 10;
+	seq = ack = 0;
+	gso_received = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Queue all the data at once so that TCP can send it in one large
+	 * segment.
+	 */
+	pkt = net_pkt_alloc_with_buffer(iface, GSO_DATA_LEN, AF_UNSPEC, 0,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "Failed to allocate data");
+
+	ret = net_pkt_write(pkt, lorem_ipsum, GSO_DATA_LEN);
+	zassert_equal(ret, 0, "Failed to write data");
+
+	ret = net_tcp_queue_data(ctx, pkt);
+	zassert_true(ret >= 0, "Failed to queue data (%d)", ret);
+
+	/* Peer will release the semaphone after it received all the data */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(gso_received, GSO_DATA_LEN, "Data missing");
+
+	net_tcp_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1493,7 +1659,8 @@ void test_main(void)
 			 ztest_unit_test(test_client_closing_ipv6),
 			 ztest_unit_test(test_client_invalid_rst),
 			 ztest_unit_test(test_server_recv_out_of_order_data),
-			 ztest_unit_test(test_server_timeout_out_of_order_data)
+			 ztest_unit_test(test_server_timeout_out_of_order_data),
+			 ztest_unit_test(test_client_gso_ipv4)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
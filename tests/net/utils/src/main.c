@@ -848,11 +848,160 @@ void test_addr_parse(void)
 #endif
 }
 
+#define CHKSUM_RUNS 500
+#define CHKSUM_MAX_LEN 1500
+#define CHKSUM_MAX_FRAGS 24
+
+static uint8_t chksum_data[CHKSUM_MAX_LEN];
+static uint32_t chksum_rand_state = 0x2545f491U;
+
+/* Fixed seed so that a failure can be reproduced */
+static uint32_t chksum_rand(void)
+{
+	chksum_rand_state ^= chksum_rand_state << 13;
+	chksum_rand_state ^= chksum_rand_state >> 17;
+	chksum_rand_state ^= chksum_rand_state << 5;
+
+	return chksum_rand_state;
+}
+
+/* Checksum computed one byte at a time, in network byte order */
+static uint16_t ref_chksum(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0U;
+
+	for (size_t i = 0; i < len; i++) {
+		sum += (i % 2) ? data[i] : data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return htons(~sum);
+}
+
+/* Build a packet of random fragments, each starting at a random offset
+ * in its buffer, and return the length of the data put in it.
+ */
+static size_t chksum_pkt_fill(struct net_pkt *pkt, size_t len)
+{
+	size_t total = 0;
+
+	for (int i = 0; i < CHKSUM_MAX_FRAGS && total < len; i++) {
+		struct net_buf *frag;
+		size_t frag_len;
+
+		frag = net_pkt_get_reserve_tx_data(K_NO_WAIT);
+		zassert_not_null(frag, "Cannot get fragment");
+
+		net_buf_reserve(frag, chksum_rand() % 8);
+
+		/* Short fragments make odd boundaries more likely */
+		frag_len = chksum_rand() % 4 ? net_buf_tailroom(frag) : 4;
+		frag_len = 1 + chksum_rand() % frag_len;
+		frag_len = MIN(frag_len, len - total);
+
+		net_buf_add_mem(frag, &chksum_data[total], frag_len);
+		net_pkt_frag_add(pkt, frag);
+		total += frag_len;
+	}
+
+	return total;
+}
+
+void test_chksum_fragments(void)
+{
+	struct net_pkt *pkt;
+
+	for (int i = 0; i < sizeof(chksum_data); i++) {
+		chksum_data[i] = chksum_rand();
+	}
+
+	for (int run = 0; run < CHKSUM_RUNS; run++) {
+		uint16_t chksum, ref;
+		size_t len;
+
+		pkt = net_pkt_alloc(K_NO_WAIT);
+		zassert_not_null(pkt, "Cannot get packet");
+
+		/* Without IP header, the ICMPv4 checksum covers all the
+		 * data of the packet.
+		 */
+		net_pkt_set_family(pkt, AF_INET);
+		net_pkt_set_ip_hdr_len(pkt, 0);
+		net_pkt_set_ipv4_opts_len(pkt, 0);
+
+		len = chksum_pkt_fill(pkt, 1 + chksum_rand() % CHKSUM_MAX_LEN);
+
+		chksum = net_calc_chksum_icmpv4(pkt);
+		ref = ref_chksum(chksum_data, len);
+
+		/* A sum of zero is turned into 0xffff, giving 0 */
+		if (ref == 0xffff) {
+			ref = 0U;
+		}
+
+		zassert_equal(chksum, ref,
+			      "Run %d: checksum 0x%04x of %zu bytes, "
+			      "expected 0x%04x", run, chksum, len, ref);
+
+		net_pkt_unref(pkt);
+	}
+}
+
+void test_chksum_update(void)
+{
+	uint8_t hdr[40];
+	uint8_t old[16];
+	uint16_t chksum;
+	uint16_t val16;
+	uint32_t val32;
+	int off;
+
+	for (int run = 0; run < CHKSUM_RUNS; run++) {
+		for (int i = 0; i < sizeof(hdr); i++) {
+			hdr[i] = chksum_rand();
+		}
+
+		chksum = ref_chksum(hdr, sizeof(hdr));
+
+		/* A 16-bit field, such as the TTL and protocol */
+		memcpy(&val16, &hdr[8], sizeof(val16));
+		hdr[8] = chksum_rand();
+		chksum = net_chksum_update16(chksum, val16,
+					     UNALIGNED_GET((uint16_t *)&hdr[8]));
+		zassert_equal(chksum, ref_chksum(hdr, sizeof(hdr)),
+			      "Run %d: 16-bit update", run);
+
+		/* A 32-bit field, such as an IPv4 address */
+		memcpy(&val32, &hdr[12], sizeof(val32));
+		UNALIGNED_PUT(chksum_rand(), (uint32_t *)&hdr[12]);
+		chksum = net_chksum_update32(chksum, val32,
+					     UNALIGNED_GET((uint32_t *)&hdr[12]));
+		zassert_equal(chksum, ref_chksum(hdr, sizeof(hdr)),
+			      "Run %d: 32-bit update", run);
+
+		/* An IPv6 address, possibly not 4-byte aligned */
+		off = 2 * (chksum_rand() % 8);
+		memcpy(old, &hdr[off], sizeof(old));
+		for (int i = 0; i < sizeof(old); i++) {
+			hdr[off + i] = chksum_rand();
+		}
+
+		chksum = net_chksum_update(chksum, old, &hdr[off], sizeof(old));
+		zassert_equal(chksum, ref_chksum(hdr, sizeof(hdr)),
+			      "Run %d: 16 bytes update", run);
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum_fragments),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }